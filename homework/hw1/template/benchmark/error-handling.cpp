@@ -0,0 +1,132 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "expression-lib/program.h"
+
+using Clock = std::chrono::steady_clock;
+
+/// Generates a valid expression with a given number of operations
+std::string generateValid(size_t operationsCount, std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> number(1, 999);
+	std::uniform_int_distribution<int> symbol(0, 3);
+	const char symbols[] = "asmd";
+
+	std::string result = std::to_string(number(rng));
+
+	for (size_t i = 0; i < operationsCount; ++i) {
+		result += ' ';
+		result += symbols[symbol(rng)];
+		result += ' ';
+		result += std::to_string(number(rng));
+	}
+
+	return result;
+}
+
+/// Breaks a valid expression at a random position, so that it fails at different stages of parsing
+std::string makeInvalid(std::string expression, std::mt19937& rng)
+{
+	std::uniform_int_distribution<size_t> position(0, expression.size() - 1);
+	std::uniform_int_distribution<int> kind(0, 3);
+
+	size_t at = position(rng);
+
+	switch (kind(rng)) {
+		case 0: expression.insert(at, " 5 "); break;       // two consecutive numbers
+		case 1: expression.insert(at, " x "); break;       // undefined operation
+		case 2: expression.insert(at, " ( "); break;       // bracket that is not closed
+		case 3: expression += " a"; break;                  // ends with an operation
+	}
+
+	return expression;
+}
+
+template <typename Function>
+void measure(const char* name, const std::vector<std::string>& inputs, size_t repetitions, Function function)
+{
+	size_t failures = 0;
+	double sum = 0;
+
+	Clock::time_point start = Clock::now();
+
+	for (size_t r = 0; r < repetitions; ++r)
+		for (const std::string& input : inputs)
+			function(input.c_str(), sum, failures);
+
+	Clock::time_point end = Clock::now();
+
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+	std::cout
+		<< "    " << name << ": "
+		<< nanoseconds / (inputs.size() * repetitions) << "ns per expression ("
+		<< failures / repetitions << " of " << inputs.size() << " incorrect)\n";
+}
+
+int main()
+{
+	std::stringstream description(
+		"a + 10 L\n"
+		"s - 10 L\n"
+		"m * 20 L\n"
+		"d / 20 R");
+	OperationSet ops = OperationSet::read(description);
+
+	std::mt19937 rng(42);
+
+	const size_t inputsCount = 10'000;
+	const size_t repetitions = 20;
+
+	std::vector<std::string> valid(inputsCount);
+	std::vector<std::string> mixed(inputsCount);
+
+	for (size_t i = 0; i < inputsCount; ++i) {
+		valid[i] = generateValid(16, rng);
+		mixed[i] = (i % 2 == 0) ? valid[i] : makeInvalid(valid[i], rng);
+	}
+
+	auto withExceptions = [&ops](const char* expression, double& sum, size_t& failures) {
+		try {
+			sum += Program::compile(expression, ops).run();
+		}
+		catch (const incorrect_expression&) {
+			++failures;
+		}
+	};
+
+	auto withStatusCodes = [&ops](const char* expression, double& sum, size_t& failures) {
+		Program program;
+		ParseError error;
+
+		if (Program::tryCompile(expression, ops, program, error))
+			sum += program.run();
+		else
+			++failures;
+	};
+
+	auto withMessages = [&ops](const char* expression, double& sum, size_t& failures) {
+		try {
+			sum += Program::compile(expression, ops).run();
+		}
+		catch (const incorrect_expression& e) {
+			// Formatting the message is the expensive part, which the other strategies avoid
+			failures += e.what()[0] != '\0';
+		}
+	};
+
+	std::cout << "All " << inputsCount << " expressions are correct\n";
+	measure("exceptions           ", valid, repetitions, withExceptions);
+	measure("status codes         ", valid, repetitions, withStatusCodes);
+
+	std::cout << "\n50% of the " << inputsCount << " expressions are incorrect\n";
+	measure("exceptions           ", mixed, repetitions, withExceptions);
+	measure("status codes         ", mixed, repetitions, withStatusCodes);
+	measure("exceptions + what()  ", mixed, repetitions, withMessages);
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "expression-lib/closure-tree.h"
+#include "expression-lib/program.h"
+#include "expression-lib/threaded-program.h"
+
+using Clock = std::chrono::steady_clock;
+
+/// Generates a random valid expression with a given number of operations
+std::string generateExpression(size_t operationsCount, std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> number(1, 9);
+	std::uniform_int_distribution<int> symbol(0, 3);
+	std::uniform_int_distribution<int> bracket(0, 7);
+
+	const char symbols[] = "asmd";
+
+	std::string result;
+	size_t openBrackets = 0;
+
+	for (size_t i = 0; i < operationsCount; ++i) {
+		if (bracket(rng) == 0) {
+			result += "( ";
+			++openBrackets;
+		}
+
+		result += std::to_string(number(rng));
+
+		if (openBrackets > 0 && bracket(rng) == 0) {
+			result += " )";
+			--openBrackets;
+		}
+
+		result += ' ';
+		result += symbols[symbol(rng)];
+		result += ' ';
+	}
+
+	result += std::to_string(number(rng));
+
+	for (; openBrackets > 0; --openBrackets)
+		result += " )";
+
+	return result;
+}
+
+/// Runs an evaluation strategy a number of times and reports the average time per evaluation
+template <typename Strategy>
+double measure(const char* name, const Strategy& strategy, size_t repetitions)
+{
+	double sum = 0;
+
+	Clock::time_point start = Clock::now();
+
+	for (size_t i = 0; i < repetitions; ++i)
+		sum += strategy.run();
+
+	Clock::time_point end = Clock::now();
+
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+	std::cout
+		<< "    " << name << ": "
+		<< nanoseconds / repetitions << "ns per evaluation\n";
+
+	return sum;
+}
+
+int main()
+{
+	std::stringstream description(
+		"a + 10 L\n"
+		"s - 10 L\n"
+		"m * 20 L\n"
+		"d / 20 R");
+	OperationSet ops = OperationSet::read(description);
+
+	std::mt19937 rng(42);
+
+	const size_t sizes[] = { 8, 64, 512, 4096 };
+	const size_t totalOperations = 20'000'000;
+
+	for (size_t size : sizes) {
+		std::string expression = generateExpression(size, rng);
+
+		Program program = Program::compile(expression.c_str(), ops);
+		ThreadedProgram threaded(program);
+		ClosureTree tree(program);
+
+		const size_t repetitions = totalOperations / size;
+
+		std::cout << "Expression with " << size << " operations, evaluated " << repetitions << " times\n";
+
+		double checksums[] = {
+			measure("switch-based RPN", program, repetitions),
+			measure("threaded code   ", threaded, repetitions),
+			measure("closure tree    ", tree, repetitions)
+		};
+
+		// Compare the bit patterns, so that NaN results are considered the same too
+		if (std::memcmp(&checksums[0], &checksums[1], sizeof(double)) != 0 ||
+			std::memcmp(&checksums[0], &checksums[2], sizeof(double)) != 0)
+			std::cout << "    WARNING: the strategies computed different results!\n";
+
+		std::cout << "\n";
+	}
+
+	return 0;
+}
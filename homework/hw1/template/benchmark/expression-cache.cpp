@@ -0,0 +1,117 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "expression-lib/expression-cache.h"
+#include "expression-lib/program.h"
+
+using Clock = std::chrono::steady_clock;
+
+/// Generates a set of distinct expressions with a given number of operations each
+std::vector<std::string> generateExpressions(size_t count, size_t operationsCount, std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> number(1, 999);
+	std::uniform_int_distribution<int> symbol(0, 3);
+	const char symbols[] = "asmd";
+
+	std::vector<std::string> result(count);
+
+	for (std::string& expression : result) {
+		expression = std::to_string(number(rng));
+
+		for (size_t i = 0; i < operationsCount; ++i) {
+			expression += "  ";
+			expression += symbols[symbol(rng)];
+			expression += "  ";
+			expression += std::to_string(number(rng));
+		}
+	}
+
+	return result;
+}
+
+/// Calls evaluate for each expression in the workload, split between several threads
+template <typename Evaluate>
+void run(const char* name, const std::vector<const std::string*>& workload, size_t threadsCount, Evaluate evaluate)
+{
+	std::vector<std::thread> threads;
+	std::vector<double> sums(threadsCount, 0);
+
+	Clock::time_point start = Clock::now();
+
+	for (size_t t = 0; t < threadsCount; ++t) {
+		threads.emplace_back([&, t]() {
+			for (size_t i = t; i < workload.size(); i += threadsCount)
+				sums[t] += evaluate(workload[i]->c_str());
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	Clock::time_point end = Clock::now();
+
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+	std::cout
+		<< "    " << name << ", " << threadsCount << " thread(s): "
+		<< nanoseconds / workload.size() << "ns per expression\n";
+}
+
+int main()
+{
+	std::stringstream description(
+		"a + 10 L\n"
+		"s - 10 L\n"
+		"m * 20 L\n"
+		"d / 20 R");
+	OperationSet ops = OperationSet::read(description);
+
+	std::mt19937 rng(42);
+
+	// A workload in which a small set of distinct expressions repeats many times
+	const size_t distinctCount = 1'000;
+	const size_t workloadSize = 1'000'000;
+
+	std::vector<std::string> expressions = generateExpressions(distinctCount, 16, rng);
+	std::vector<const std::string*> workload(workloadSize);
+
+	// Skewed popularity: a few expressions are requested much more often than the rest
+	std::geometric_distribution<size_t> pick(0.01);
+	for (const std::string*& expression : workload)
+		expression = &expressions[pick(rng) % distinctCount];
+
+	const size_t threadCounts[] = { 1, 4 };
+
+	for (size_t threadsCount : threadCounts) {
+		std::cout << "Evaluating " << workloadSize << " expressions (" << distinctCount << " distinct)\n";
+
+		run("without a cache       ", workload, threadsCount, [&ops](const char* expression) {
+			return Program::compile(expression, ops).run();
+		});
+
+		const size_t capacities[] = { 128, 2048 };
+
+		for (size_t capacity : capacities) {
+			ExpressionCache cache(capacity);
+			std::string name = "cache of " + std::to_string(capacity) + " entries";
+			name.resize(22, ' ');
+
+			run(name.c_str(), workload, threadsCount, [&](const char* expression) {
+				return cache.evaluate(expression, ops);
+			});
+
+			std::cout
+				<< "        hits: " << cache.hits()
+				<< ", misses: " << cache.misses() << "\n";
+		}
+
+		std::cout << "\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "expression-lib/program.h"
+#include "expression-lib/streaming-parser.h"
+
+using Clock = std::chrono::steady_clock;
+
+/// Generates an expression with a given number of operations and bounded nesting depth
+std::string generateExpression(size_t operationsCount, std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> number(1, 999);
+	std::uniform_int_distribution<int> symbol(0, 2);
+	std::uniform_int_distribution<int> bracket(0, 7);
+
+	const char symbols[] = "asm";
+	const size_t MaxDepth = 8;
+
+	std::string result;
+	size_t depth = 0;
+
+	for (size_t i = 0; i < operationsCount; ++i) {
+		if (depth < MaxDepth && bracket(rng) == 0) {
+			result += "( ";
+			++depth;
+		}
+
+		result += std::to_string(number(rng));
+
+		if (depth > 0 && bracket(rng) == 0) {
+			result += " )";
+			--depth;
+		}
+
+		result += ' ';
+		result += symbols[symbol(rng)];
+		result += ' ';
+	}
+
+	result += std::to_string(number(rng));
+
+	for (; depth > 0; --depth)
+		result += " )";
+
+	return result;
+}
+
+double millisecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main()
+{
+	std::stringstream description(
+		"a + 10 L\n"
+		"s - 10 L\n"
+		"m * 20 L");
+	OperationSet ops = OperationSet::read(description);
+
+	std::mt19937 rng(42);
+
+	const size_t operationsCount = 1'000'000;
+	const std::string expression = generateExpression(operationsCount, rng);
+
+	std::cout
+		<< "Expression with " << operationsCount << " operations ("
+		<< expression.size() / (1024 * 1024) << " MiB of text)\n";
+
+	{
+		std::stringstream in(expression);
+		Clock::time_point start = Clock::now();
+
+		// Materialize the whole text first, then compile and run it
+		std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		Program program = Program::compile(text.c_str(), ops);
+		double result = program.run();
+
+		double elapsed = millisecondsSince(start);
+
+		std::cout
+			<< "    read + compile + run: " << elapsed << "ms, result " << result << "\n"
+			<< "        holds the text (" << text.capacity() / 1024 << " KiB) and the program ("
+			<< program.code().capacity() * sizeof(Instruction) / 1024 << " KiB)\n";
+	}
+
+	{
+		std::stringstream in(expression);
+		Clock::time_point start = Clock::now();
+
+		double result = StreamingParser::evaluate(in, ops);
+
+		double elapsed = millisecondsSince(start);
+
+		std::cout
+			<< "    streaming parser:     " << elapsed << "ms, result " << result << "\n"
+			<< "        holds one fragment (" << StreamingParser::FragmentSize / 1024
+			<< " KiB) and stacks bounded by the nesting depth\n";
+	}
+
+	return 0;
+}
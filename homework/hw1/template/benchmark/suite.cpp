@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "benchmark-suite.h"
+#include "expression-lib/closure-tree.h"
+#include "expression-lib/expression-cache.h"
+#include "expression-lib/expression.h"
+#include "expression-lib/program.h"
+#include "expression-lib/streaming-parser.h"
+#include "expression-lib/threaded-program.h"
+
+const char* const OperationsDescription =
+	"a + 10 L\n"
+	"s - 10 L\n"
+	"m * 20 L\n"
+	"d / 20 R";
+
+const size_t ExpressionOperations = 256;
+const size_t Evaluations = 10'000;
+const size_t StreamedOperations = 1'000'000;
+
+/// Generates an expression with a given number of operations.
+/// Every group of eight operations starts with a bracketed group of four.
+std::string generateExpression(size_t operationsCount)
+{
+	const char symbols[] = "asmd";
+
+	std::string result;
+
+	for (size_t i = 0; i < operationsCount; ++i) {
+		if (i % 8 == 0 && i + 4 < operationsCount)
+			result += "( ";
+
+		result += std::to_string(i % 9 + 1);
+
+		if (i % 8 == 4)
+			result += " )";
+
+		result += ' ';
+		result += symbols[i % 4];
+		result += ' ';
+	}
+
+	result += '1';
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSuite suite("expression evaluator");
+
+	std::istringstream description(OperationsDescription);
+	auto ops = std::make_shared<const OperationSet>(OperationSet::read(description));
+
+	auto expression = std::make_shared<const std::string>(generateExpression(ExpressionOperations));
+	auto program = std::make_shared<const Program>(Program::compile(expression->c_str(), *ops));
+	auto threaded = std::make_shared<const ThreadedProgram>(*program);
+	auto tree = std::make_shared<const ClosureTree>(*program);
+
+	// Tokenizes and parses the expression and the operations on every call
+	suite.add("evaluate()", Evaluations / 10, [expression]() {
+		double sum = 0;
+
+		for (size_t i = 0; i < Evaluations / 10; ++i) {
+			std::istringstream operations(OperationsDescription);
+			sum += evaluate(expression->c_str(), operations);
+		}
+
+		return sum;
+	});
+
+	suite.add("Program::compile", Evaluations / 10, [expression, ops]() {
+		size_t instructions = 0;
+
+		for (size_t i = 0; i < Evaluations / 10; ++i)
+			instructions += Program::compile(expression->c_str(), *ops).code().size();
+
+		return instructions;
+	});
+
+	suite.add("Program::run", Evaluations, [program]() {
+		double sum = 0;
+
+		for (size_t i = 0; i < Evaluations; ++i)
+			sum += program->run();
+
+		return sum;
+	});
+
+	suite.add("ThreadedProgram::run", Evaluations, [threaded]() {
+		double sum = 0;
+
+		for (size_t i = 0; i < Evaluations; ++i)
+			sum += threaded->run();
+
+		return sum;
+	});
+
+	suite.add("ClosureTree::run", Evaluations, [tree]() {
+		double sum = 0;
+
+		for (size_t i = 0; i < Evaluations; ++i)
+			sum += tree->run();
+
+		return sum;
+	});
+
+	// Every evaluation after the first one is a hit
+	suite.add("ExpressionCache::evaluate, hits", Evaluations, [expression, ops]() {
+		ExpressionCache cache(16);
+		double sum = 0;
+
+		for (size_t i = 0; i < Evaluations; ++i)
+			sum += cache.evaluate(expression->c_str(), *ops);
+
+		return sum;
+	});
+
+	auto streamed = std::make_shared<const std::string>(generateExpression(StreamedOperations));
+
+	suite.add("StreamingParser, 64 KiB fragments", StreamedOperations, [streamed, ops]() {
+		StreamingParser parser(*ops);
+
+		for (size_t offset = 0; offset < streamed->size(); offset += StreamingParser::FragmentSize)
+			parser.feed(streamed->data() + offset, std::min(StreamingParser::FragmentSize, streamed->size() - offset));
+
+		return parser.finish();
+	});
+
+	return suite.run(argc, argv);
+}
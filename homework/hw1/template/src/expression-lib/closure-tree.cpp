@@ -0,0 +1,115 @@
+#include "closure-tree.h"
+
+#include <cassert>
+
+namespace {
+
+using Node = ClosureTree::Node;
+using Function = ClosureTree::Function;
+
+double constant(const Node* node)
+{
+  return node->value;
+}
+
+template <Action A>
+double combine(double lhs, double rhs)
+{
+  if constexpr (A == Action::Add)
+    return lhs + rhs;
+  else if constexpr (A == Action::Subtract)
+    return lhs - rhs;
+  else if constexpr (A == Action::Multiply)
+    return lhs * rhs;
+  else
+    return lhs / rhs;
+}
+
+// Each of the functions below is specialized for a given action and for
+// whether its children are constants. Constants are read directly, which
+// saves an indirect call for every leaf of the tree.
+
+template <Action A>
+double bothNodes(const Node* node)
+{
+  return combine<A>(node->left->function(node->left), node->right->function(node->right));
+}
+
+template <Action A>
+double leftConstant(const Node* node)
+{
+  return combine<A>(node->left->value, node->right->function(node->right));
+}
+
+template <Action A>
+double rightConstant(const Node* node)
+{
+  return combine<A>(node->left->function(node->left), node->right->value);
+}
+
+template <Action A>
+double bothConstants(const Node* node)
+{
+  return combine<A>(node->left->value, node->right->value);
+}
+
+template <Action A>
+Function select(bool leftIsConstant, bool rightIsConstant)
+{
+  if (leftIsConstant)
+    return rightIsConstant ? bothConstants<A> : leftConstant<A>;
+  else
+    return rightIsConstant ? rightConstant<A> : bothNodes<A>;
+}
+
+Function select(OpCode code, bool leftIsConstant, bool rightIsConstant)
+{
+  switch (code) {
+    case OpCode::Add:      return select<Action::Add>(leftIsConstant, rightIsConstant);
+    case OpCode::Subtract: return select<Action::Subtract>(leftIsConstant, rightIsConstant);
+    case OpCode::Multiply: return select<Action::Multiply>(leftIsConstant, rightIsConstant);
+    case OpCode::Divide:   return select<Action::Divide>(leftIsConstant, rightIsConstant);
+    case OpCode::Push:     break;
+  }
+
+  return constant;
+}
+
+} // namespace
+
+ClosureTree::ClosureTree(const Program& program)
+{
+  if (program.empty())
+    return;
+
+  const std::vector<Instruction>& code = program.code();
+
+  // Every instruction becomes exactly one node. Reserving the storage in
+  // advance guarantees that the addresses of the nodes do not change.
+  m_nodes.reserve(code.size());
+
+  std::vector<const Node*> operands;
+  operands.reserve(program.stackDepth());
+
+  for (const Instruction& instruction : code) {
+    if (instruction.code == OpCode::Push) {
+      m_nodes.push_back({constant, nullptr, nullptr, instruction.value});
+    }
+    else {
+      assert(operands.size() >= 2);
+
+      const Node* right = operands.back();
+      operands.pop_back();
+      const Node* left = operands.back();
+      operands.pop_back();
+
+      Function function = select(instruction.code, left->function == constant, right->function == constant);
+      m_nodes.push_back({function, left, right, 0});
+    }
+
+    operands.push_back(&m_nodes.back());
+  }
+
+  assert(operands.size() == 1);
+  m_root = operands.back();
+}
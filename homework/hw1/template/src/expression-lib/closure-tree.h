@@ -0,0 +1,69 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "program.h"
+
+///
+/// @brief A program translated to a tree of pre-bound evaluation functions.
+///
+/// Every node stores a pointer to a function, which is specialized at compile
+/// time for the action of the node and for the kinds of its children. The
+/// children are bound to the node when the tree is built, so evaluation never
+/// inspects an opcode: each node calls its function, which directly calls the
+/// functions of its children.
+///
+/// Evaluation is recursive, so the depth of the tree is limited by the size
+/// of the call stack. This makes the strategy suitable for hot expressions of
+/// moderate size.
+///
+class ClosureTree {
+public:
+  struct Node;
+  using Function = double (*)(const Node*);
+
+  struct Node {
+    Function function;
+    const Node* left;
+    const Node* right;
+    double value;
+  };
+
+private:
+  std::vector<Node> m_nodes;
+  const Node* m_root = nullptr;
+
+public:
+  /// Constructs an empty tree, which evaluates to 0
+  ClosureTree() = default;
+
+  /// Builds the tree of a compiled program
+  explicit ClosureTree(const Program& program);
+
+  // The nodes point to each other, so copying would need to relink them
+  ClosureTree(const ClosureTree&) = delete;
+  ClosureTree& operator=(const ClosureTree&) = delete;
+
+  // Moving the vector keeps its buffer, so the root still points into the
+  // moved nodes. The source is left as an empty tree.
+  ClosureTree(ClosureTree&& other) noexcept
+    : m_nodes(std::move(other.m_nodes)), m_root(std::exchange(other.m_root, nullptr))
+  {}
+
+  ClosureTree& operator=(ClosureTree&& other) noexcept
+  {
+    if (this != &other) {
+      m_nodes = std::move(other.m_nodes);
+      m_root = std::exchange(other.m_root, nullptr);
+      other.m_nodes.clear();
+    }
+
+    return *this;
+  }
+
+  double run() const
+  {
+    return m_root ? m_root->function(m_root) : 0;
+  }
+};
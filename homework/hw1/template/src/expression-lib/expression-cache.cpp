@@ -0,0 +1,189 @@
+#include "expression-cache.h"
+
+#include "expression.h"
+#include "program.h"
+#include "tokenizer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+std::uint64_t hashOf(const std::string& text, std::uint64_t fingerprint) noexcept
+{
+  // FNV-1a, seeded with the fingerprint of the operations
+  std::uint64_t hash = 14695981039346656037ull ^ fingerprint;
+
+  for (char c : text) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+} // namespace
+
+ExpressionCache::ExpressionCache(size_t capacity)
+  : m_capacity(capacity)
+{
+  if (capacity == 0)
+    return;
+
+  // Keep at least a few entries per shard, so that a small cache is not
+  // split into shards that can hold only one or two expressions.
+  const size_t MinShardCapacity = 4;
+  m_shardsCount = std::max<size_t>(1, std::min(MaxShardsCount, capacity / MinShardCapacity));
+  m_shards.reset(new Shard[m_shardsCount]);
+
+  for (size_t i = 0; i < m_shardsCount; ++i) {
+    Shard& shard = m_shards[i];
+    shard.capacity = capacity / m_shardsCount + (i < capacity % m_shardsCount ? 1 : 0);
+    shard.entries.reserve(shard.capacity);
+    shard.index.reserve(shard.capacity);
+  }
+}
+
+double ExpressionCache::evaluate(const char* expression, const OperationSet& operations)
+{
+  if ( ! expression)
+    throw incorrect_expression(expression_error::null_expression, 0, 0);
+
+  std::string text = normalize(expression);
+  std::uint64_t fingerprint = operations.fingerprint();
+  std::uint64_t hash = hashOf(text, fingerprint);
+
+  if (m_shardsCount == 0) {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return Program::compile(expression, operations).run();
+  }
+
+  Shard& shard = shardOf(hash);
+  double value;
+
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (lookup(shard, text, fingerprint, hash, value)) {
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+      return value;
+    }
+  }
+
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+
+  // The expression is evaluated without holding the lock. If several threads
+  // miss on the same expression at the same time, each of them evaluates it
+  // and the last one to finish refreshes the entry.
+  value = Program::compile(expression, operations).run();
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  insert(shard, std::move(text), fingerprint, hash, value);
+
+  return value;
+}
+
+size_t ExpressionCache::size() const
+{
+  size_t result = 0;
+
+  for (size_t i = 0; i < m_shardsCount; ++i) {
+    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+    result += m_shards[i].entries.size();
+  }
+
+  return result;
+}
+
+void ExpressionCache::clear()
+{
+  for (size_t i = 0; i < m_shardsCount; ++i) {
+    Shard& shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.clear();
+    shard.index.clear();
+    shard.hand = 0;
+  }
+
+  m_hits = 0;
+  m_misses = 0;
+}
+
+std::string ExpressionCache::normalize(const char* expression)
+{
+  std::string result;
+  result.reserve(std::strlen(expression));
+
+  for (const char* p = expression; *p != '\0'; ++p) {
+    if ( ! Tokenizer::isSeparator(*p))
+      result += *p;
+    else if ( ! result.empty() && result.back() != ' ')
+      result += ' ';
+  }
+
+  if ( ! result.empty() && result.back() == ' ')
+    result.pop_back();
+
+  return result;
+}
+
+ExpressionCache::Shard& ExpressionCache::shardOf(std::uint64_t hash) const noexcept
+{
+  // The low bits of the hash are used by the index of the shard, so pick the shard by the high ones
+  return m_shards[(hash >> 32) % m_shardsCount];
+}
+
+bool ExpressionCache::lookup(Shard& shard, const std::string& text, std::uint64_t fingerprint, std::uint64_t hash, double& value)
+{
+  auto it = shard.index.find(hash);
+
+  if (it == shard.index.end())
+    return false;
+
+  Entry& entry = shard.entries[it->second];
+
+  // Two different keys may have the same hash, so compare the keys too
+  if (entry.fingerprint != fingerprint || entry.text != text)
+    return false;
+
+  entry.referenced = true;
+  value = entry.value;
+  return true;
+}
+
+void ExpressionCache::insert(Shard& shard, std::string&& text, std::uint64_t fingerprint, std::uint64_t hash, double value)
+{
+  auto it = shard.index.find(hash);
+
+  size_t position;
+
+  if (it != shard.index.end()) {
+    // Either another thread inserted the same key, or this is a collision.
+    // In both cases the entry is overwritten.
+    position = it->second;
+  }
+  else if (shard.entries.size() < shard.capacity) {
+    position = shard.entries.size();
+    shard.entries.emplace_back();
+    shard.index[hash] = position;
+  }
+  else {
+    // Advance the clock until it finds an entry that was not used since its last pass
+    while (shard.entries[shard.hand].referenced) {
+      shard.entries[shard.hand].referenced = false;
+      shard.hand = (shard.hand + 1) % shard.entries.size();
+    }
+
+    position = shard.hand;
+    shard.hand = (shard.hand + 1) % shard.entries.size();
+
+    shard.index.erase(shard.entries[position].hash);
+    shard.index[hash] = position;
+  }
+
+  Entry& entry = shard.entries[position];
+  entry.text = std::move(text);
+  entry.fingerprint = fingerprint;
+  entry.hash = hash;
+  entry.value = value;
+  entry.referenced = false;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "operation-set.h"
+
+///
+/// @brief A bounded cache of evaluation results.
+///
+/// The key of an entry is the expression with all whitespace normalized to
+/// single spaces, combined with the fingerprint of the operation set used to
+/// evaluate it. So "1 a 2" and "  1   a 2 " share the same entry, while the
+/// same text evaluated with different operations does not.
+///
+/// The cache holds at most capacity() entries. When it is full, entries are
+/// evicted with the CLOCK algorithm (an approximation of LRU, which does not
+/// need to reorder anything on a hit).
+///
+/// All member functions are thread-safe. The entries are split between
+/// several independently locked shards, so that threads evaluating different
+/// expressions rarely contend for the same lock.
+///
+/// Incorrect expressions are never cached. Evaluating them throws
+/// incorrect_expression every time. On a miss the original text, not its
+/// normalized key, is compiled, so the reported offsets refer to the text
+/// the caller passed.
+///
+class ExpressionCache {
+
+  struct Entry {
+    std::string text;
+    std::uint64_t fingerprint = 0;
+    std::uint64_t hash = 0;
+    double value = 0;
+    bool referenced = false;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::vector<Entry> entries;
+    std::unordered_map<std::uint64_t, size_t> index; ///< Maps the hash of a key to an entry
+    size_t capacity = 0;
+    size_t hand = 0; ///< Position of the hand of the clock
+  };
+
+  static constexpr size_t MaxShardsCount = 16;
+
+  std::unique_ptr<Shard[]> m_shards;
+  size_t m_shardsCount = 0;
+  size_t m_capacity = 0;
+  std::atomic<size_t> m_hits{0};
+  std::atomic<size_t> m_misses{0};
+
+public:
+  /// Creates a cache which holds at most capacity entries
+  explicit ExpressionCache(size_t capacity);
+
+  ExpressionCache(const ExpressionCache&) = delete;
+  ExpressionCache& operator=(const ExpressionCache&) = delete;
+
+  /// Evaluates an expression, or returns the cached result of a previous evaluation.
+  /// @exception incorrect_expression If the expression is not valid
+  double evaluate(const char* expression, const OperationSet& operations);
+
+  /// Number of calls to evaluate() that were served from the cache
+  size_t hits() const noexcept
+  {
+    return m_hits.load(std::memory_order_relaxed);
+  }
+
+  /// Number of calls to evaluate() that had to evaluate the expression
+  size_t misses() const noexcept
+  {
+    return m_misses.load(std::memory_order_relaxed);
+  }
+
+  /// Maximum number of entries in the cache
+  size_t capacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+  /// Number of entries currently in the cache
+  size_t size() const;
+
+  /// Removes all entries and resets the counters
+  void clear();
+
+  /// Collapses each sequence of whitespace characters in the expression into a single
+  /// space and removes the leading and trailing whitespace.
+  static std::string normalize(const char* expression);
+
+private:
+  Shard& shardOf(std::uint64_t hash) const noexcept;
+  static bool lookup(Shard& shard, const std::string& text, std::uint64_t fingerprint, std::uint64_t hash, double& value);
+  static void insert(Shard& shard, std::string&& text, std::uint64_t fingerprint, std::uint64_t hash, double value);
+};
@@ -1,5 +1,55 @@
 #include "expression.h"
 
+#include "operation-set.h"
+#include "program.h"
+
+const char* describe(expression_error code) noexcept
+{
+  switch (code) {
+    case expression_error::none:                       return "No error";
+    case expression_error::unspecified:                return "The expression is incorrect";
+    case expression_error::null_expression:            return "The expression is null";
+    case expression_error::invalid_token:              return "Invalid token in the expression";
+    case expression_error::undefined_operation:        return "The expression uses an undefined operation";
+    case expression_error::unexpected_number:          return "Expected an operation or a closing bracket, but found a number";
+    case expression_error::unexpected_operation:       return "Expected a number or an opening bracket, but found an operation";
+    case expression_error::unexpected_opening_bracket: return "Expected an operation or a closing bracket, but found an opening bracket";
+    case expression_error::unexpected_closing_bracket: return "Expected a number or an opening bracket, but found a closing bracket";
+    case expression_error::unclosed_bracket:           return "The expression contains a bracket that is not closed";
+    case expression_error::unmatched_closing_bracket:  return "The expression contains a closing bracket without a matching opening one";
+    case expression_error::incomplete_expression:      return "The expression ends with an operation or an opening bracket";
+  }
+
+  return "Unknown error";
+}
+
+const char* incorrect_expression::what() const noexcept
+{
+  if (m_code == expression_error::unspecified)
+    return invalid_argument::what();
+
+  if ( ! m_message)
+    return describe(m_code);
+
+  try {
+    std::call_once(m_message->formatted, [this]() {
+      std::string text = describe(m_code);
+
+      if (m_token_index != npos)
+        text += " (token " + std::to_string(m_token_index) + ", offset " + std::to_string(m_offset) + ")";
+
+      m_message->text = std::move(text);
+    });
+  }
+  catch (...) {
+    // The message could not be formatted. Fall back to the static description.
+    // The formatting is attempted again on the next call.
+    return describe(m_code);
+  }
+
+  return m_message->text.c_str();
+}
+
 ///
 /// @brief Evaluates an expression.
 ///
@@ -12,6 +62,9 @@
 ///
 double evaluate(const char* expression, std::istream& ops)
 {
-  //TODO Edit the code of this function and add your own solution.
-  throw std::exception();
+  if ( ! expression)
+    throw incorrect_expression(expression_error::null_expression, 0, 0);
+
+  OperationSet operations = OperationSet::read(ops);
+  return Program::compile(expression, operations).run();
 }
\ No newline at end of file
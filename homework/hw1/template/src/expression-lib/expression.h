@@ -2,15 +2,80 @@
 
 #include <istream>
 #include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+// The reasons for which an expression can be incorrect
+enum class expression_error {
+    none,
+    unspecified,
+    null_expression,
+    invalid_token,
+    undefined_operation,
+    unexpected_number,
+    unexpected_operation,
+    unexpected_opening_bracket,
+    unexpected_closing_bracket,
+    unclosed_bracket,
+    unmatched_closing_bracket,
+    incomplete_expression
+};
+
+// Returns a static, human-readable description of an error
+const char* describe(expression_error code) noexcept;
 
 // An exception that is thrown by evaluate when it detects an incorrect expression
+//
+// Besides the message, it can carry an error code and the position of the
+// token at which the error was detected. The message for such exceptions is
+// only formatted when what() is called for the first time, so throwing and
+// catching them does not format any strings. what() may be called by several
+// threads at the same time (e.g. on an exception shared by an exception_ptr).
+// Copies of an exception share its formatted message.
 class incorrect_expression : public std::invalid_argument {
 public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
     incorrect_expression(const std::string& what_arg)
         : invalid_argument(what_arg)
     {
         // Nothing to do here        
     }
+
+    incorrect_expression(expression_error code, size_t token_index, size_t offset)
+        : invalid_argument(""), m_code(code), m_token_index(token_index), m_offset(offset)
+    {
+        try {
+            m_message = std::make_shared<LazyMessage>();
+        }
+        catch (...) {
+            // what() falls back to the static description of the error
+        }
+    }
+
+    // The reason for the error, or expression_error::unspecified if the exception was created with a message
+    expression_error code() const noexcept { return m_code; }
+
+    // Index of the token at which the error was detected (0-based), or npos if unknown
+    size_t token_index() const noexcept { return m_token_index; }
+
+    // Position of the first character of that token in the expression, or npos if unknown
+    size_t offset() const noexcept { return m_offset; }
+
+    const char* what() const noexcept override;
+
+private:
+    expression_error m_code = expression_error::unspecified;
+    size_t m_token_index = npos;
+    size_t m_offset = npos;
+    struct LazyMessage {
+        std::once_flag formatted;
+        std::string text;
+    };
+
+    std::shared_ptr<LazyMessage> m_message; // Formatted on the first call to what()
 };
 
 double evaluate(const char* expression, std::istream& ops);
\ No newline at end of file
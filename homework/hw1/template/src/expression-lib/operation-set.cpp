@@ -0,0 +1,95 @@
+#include "operation-set.h"
+
+#include <stdexcept>
+
+OperationSet OperationSet::read(std::istream& in)
+{
+  OperationSet result;
+
+  char symbol, action, associativity;
+  int priority;
+
+  while (in >> symbol >> action >> priority >> associativity) {
+    Operation operation;
+
+    switch (action) {
+      case '+': case '-': case '*': case '/':
+        operation.action = static_cast<Action>(action);
+        break;
+      default:
+        throw std::invalid_argument("Unknown operator in the description of an operation");
+    }
+
+    switch (associativity) {
+      case 'L': case 'l': operation.rightAssociative = false; break;
+      case 'R': case 'r': operation.rightAssociative = true; break;
+      default:
+        throw std::invalid_argument("Unknown associativity in the description of an operation");
+    }
+
+    operation.priority = priority;
+    result.add(symbol, operation);
+  }
+
+  return result;
+}
+
+bool OperationSet::isSymbol(char symbol) noexcept
+{
+  return ('a' <= symbol && symbol <= 'z') || ('A' <= symbol && symbol <= 'Z');
+}
+
+void OperationSet::add(char symbol, const Operation& operation)
+{
+  if ( ! isSymbol(symbol))
+    throw std::invalid_argument("Operation symbols must be latin letters");
+
+  size_t index = indexOf(symbol);
+  m_operations[index] = operation;
+  m_defined[index] = true;
+  m_fingerprint = computeFingerprint();
+}
+
+bool OperationSet::contains(char symbol) const noexcept
+{
+  return isSymbol(symbol) && m_defined[indexOf(symbol)];
+}
+
+const Operation& OperationSet::get(char symbol) const
+{
+  if ( ! contains(symbol))
+    throw std::out_of_range("Operation is not defined");
+
+  return m_operations[indexOf(symbol)];
+}
+
+std::uint64_t OperationSet::computeFingerprint() const noexcept
+{
+  // FNV-1a over the description of each defined operation
+  std::uint64_t hash = 14695981039346656037ull;
+
+  auto mix = [&hash](std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (i * 8)) & 0xFF;
+      hash *= 1099511628211ull;
+    }
+  };
+
+  for (size_t i = 0; i < SymbolsCount; ++i) {
+    if ( ! m_defined[i])
+      continue;
+
+    const Operation& operation = m_operations[i];
+    mix(i);
+    mix(static_cast<std::uint64_t>(operation.action));
+    mix(static_cast<std::uint64_t>(static_cast<std::int64_t>(operation.priority)));
+    mix(operation.rightAssociative);
+  }
+
+  return hash;
+}
+
+size_t OperationSet::indexOf(char symbol) noexcept
+{
+  return (symbol | 0x20) - 'a'; // setting bit 5 converts A-Z to a-z
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <istream>
+
+/// The arithmetic action, which an operation performs on its operands
+enum class Action : char {
+  Add = '+',
+  Subtract = '-',
+  Multiply = '*',
+  Divide = '/'
+};
+
+/// Applies an action to a pair of operands
+inline double apply(Action action, double lhs, double rhs) noexcept
+{
+  switch (action) {
+    case Action::Add:      return lhs + rhs;
+    case Action::Subtract: return lhs - rhs;
+    case Action::Multiply: return lhs * rhs;
+    case Action::Divide:   return lhs / rhs;
+  }
+
+  return 0; // unreachable
+}
+
+/// Description of a single operation that can be used in an expression
+struct Operation {
+  Action action = Action::Add;
+  int priority = 0;
+  bool rightAssociative = false;
+};
+
+///
+/// @brief A collection of operations, indexed by their symbol.
+///
+/// Symbols are latin letters and the case is ignored, so there can be at most
+/// 26 operations. They are stored in a table with one slot per letter, which
+/// makes all lookups O(1).
+///
+class OperationSet {
+  static constexpr size_t SymbolsCount = 'z' - 'a' + 1;
+
+  std::array<Operation, SymbolsCount> m_operations;
+  std::array<bool, SymbolsCount> m_defined = {};
+  std::uint64_t m_fingerprint = computeFingerprint();
+
+public:
+  /// Constructs an empty set
+  OperationSet() = default;
+
+  /// Reads the descriptions of all operations from a stream.
+  /// @exception std::invalid_argument If a description is incorrect
+  static OperationSet read(std::istream& in);
+
+  /// Checks whether a character is a valid operation symbol (a latin letter)
+  static bool isSymbol(char symbol) noexcept;
+
+  /// Adds an operation or replaces an existing one with the same symbol
+  /// @exception std::invalid_argument If symbol is not a latin letter
+  void add(char symbol, const Operation& operation);
+
+  /// Checks whether an operation with a given symbol is defined
+  bool contains(char symbol) const noexcept;
+
+  /// Retrieves the operation with a given symbol.
+  /// @exception std::out_of_range If the operation is not defined
+  const Operation& get(char symbol) const;
+
+  /// A hash of all operations in the set.
+  /// Sets that define the same operations have equal fingerprints.
+  std::uint64_t fingerprint() const noexcept
+  {
+    return m_fingerprint;
+  }
+
+private:
+  static size_t indexOf(char symbol) noexcept;
+  std::uint64_t computeFingerprint() const noexcept;
+};
@@ -0,0 +1,110 @@
+#include "program.h"
+
+#include "shunting-yard.h"
+#include "tokenizer.h"
+
+#include <algorithm>
+
+/// A sink for ShuntingYard, which appends instructions to a program
+class ProgramBuilder {
+  Program& m_program;
+  size_t m_depth = 0;
+
+public:
+  explicit ProgramBuilder(Program& program)
+    : m_program(program)
+  {
+  }
+
+  void number(double value)
+  {
+    m_program.m_code.push_back({OpCode::Push, value});
+    m_program.m_stackDepth = std::max(m_program.m_stackDepth, ++m_depth);
+  }
+
+  void apply(Action action)
+  {
+    m_program.m_code.push_back({Program::opCodeOf(action), 0});
+    --m_depth;
+  }
+};
+
+Program Program::compile(const char* expression, const OperationSet& operations)
+{
+  Program program;
+  ParseError error;
+
+  if ( ! tryCompile(expression, operations, program, error))
+    throw error.toException();
+
+  return program;
+}
+
+bool Program::tryCompile(const char* expression, const OperationSet& operations, Program& result, ParseError& error)
+{
+  result.m_code.clear();
+  result.m_stackDepth = 0;
+
+  if ( ! expression) {
+    error = {expression_error::null_expression, 0, 0};
+    return false;
+  }
+
+  ProgramBuilder builder(result);
+  ShuntingYard<ProgramBuilder> parser(operations, builder);
+  Tokenizer tokenizer(expression);
+
+  size_t index = 0;
+  Token token;
+
+  for (token = tokenizer.next(); token.type != TokenType::End; token = tokenizer.next(), ++index) {
+    expression_error code = parser.push(token);
+
+    if (code != expression_error::none) {
+      error = {code, index, token.offset};
+      return false;
+    }
+  }
+
+  expression_error code = parser.finish();
+
+  if (code != expression_error::none) {
+    error = {code, index, token.offset};
+    return false;
+  }
+
+  return true;
+}
+
+double Program::run() const
+{
+  if (m_code.empty())
+    return 0;
+
+  ScratchStack stack(m_stackDepth);
+  double* top = stack.data() - 1;
+
+  for (const Instruction& instruction : m_code) {
+    switch (instruction.code) {
+      case OpCode::Push:     *++top = instruction.value; break;
+      case OpCode::Add:      --top; *top = top[0] + top[1]; break;
+      case OpCode::Subtract: --top; *top = top[0] - top[1]; break;
+      case OpCode::Multiply: --top; *top = top[0] * top[1]; break;
+      case OpCode::Divide:   --top; *top = top[0] / top[1]; break;
+    }
+  }
+
+  return *top;
+}
+
+OpCode Program::opCodeOf(Action action) noexcept
+{
+  switch (action) {
+    case Action::Add:      return OpCode::Add;
+    case Action::Subtract: return OpCode::Subtract;
+    case Action::Multiply: return OpCode::Multiply;
+    case Action::Divide:   return OpCode::Divide;
+  }
+
+  return OpCode::Add; // unreachable
+}
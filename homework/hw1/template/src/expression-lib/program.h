@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+
+#include "expression.h"
+#include "operation-set.h"
+
+/// Instructions of the stack machine, which evaluates compiled expressions
+enum class OpCode : unsigned char {
+  Push,
+  Add,
+  Subtract,
+  Multiply,
+  Divide
+};
+
+/// A single instruction. Only Push uses the value.
+struct Instruction {
+  OpCode code;
+  double value;
+};
+
+/// Describes why and where the processing of an expression failed
+struct ParseError {
+  expression_error code = expression_error::none;
+  size_t tokenIndex = 0;  ///< Index of the token at which the error was detected
+  size_t offset = 0;      ///< Position of the first character of that token
+
+  /// Creates the exception that reports this error
+  incorrect_expression toException() const
+  {
+    return incorrect_expression(code, tokenIndex, offset);
+  }
+};
+
+///
+/// @brief Storage for the value stack of an evaluation.
+///
+/// Short programs use a buffer inside the object, so that evaluating them
+/// does not allocate memory.
+///
+class ScratchStack {
+  static constexpr size_t LocalCapacity = 128;
+
+  double m_local[LocalCapacity];
+  std::vector<double> m_heap;
+  double* m_data = m_local;
+
+public:
+  explicit ScratchStack(size_t depth)
+  {
+    if (depth > LocalCapacity) {
+      m_heap.resize(depth);
+      m_data = m_heap.data();
+    }
+  }
+
+  ScratchStack(const ScratchStack&) = delete;
+  ScratchStack& operator=(const ScratchStack&) = delete;
+
+  double* data() noexcept
+  {
+    return m_data;
+  }
+};
+
+///
+/// @brief An expression compiled to postfix (RPN) form.
+///
+/// Compiling validates the expression once, so a program can be evaluated
+/// many times without tokenizing and parsing it again.
+///
+class Program {
+  std::vector<Instruction> m_code;
+  size_t m_stackDepth = 0;
+
+  friend class ProgramBuilder;
+
+public:
+  /// Constructs an empty program, which evaluates to 0
+  Program() = default;
+
+  /// Compiles an expression.
+  /// @exception incorrect_expression If the expression is not valid
+  static Program compile(const char* expression, const OperationSet& operations);
+
+  /// Compiles an expression without throwing for incorrect expressions.
+  /// Returns false and describes the problem in error if the expression is not valid.
+  /// In that case the contents of result are unspecified.
+  /// @exception std::bad_alloc If memory allocation fails
+  static bool tryCompile(const char* expression, const OperationSet& operations, Program& result, ParseError& error);
+
+  /// Evaluates the program with a switch over the opcode of each instruction
+  double run() const;
+
+  /// The instructions of the program in postfix order
+  const std::vector<Instruction>& code() const noexcept
+  {
+    return m_code;
+  }
+
+  /// Maximum number of values that the program keeps on the stack at the same time
+  size_t stackDepth() const noexcept
+  {
+    return m_stackDepth;
+  }
+
+  bool empty() const noexcept
+  {
+    return m_code.empty();
+  }
+
+  /// Converts an action to the instruction that performs it
+  static OpCode opCodeOf(Action action) noexcept;
+};
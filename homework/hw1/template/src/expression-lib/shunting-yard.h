@@ -0,0 +1,152 @@
+#pragma once
+
+#include <vector>
+
+#include "expression.h"
+#include "operation-set.h"
+#include "tokenizer.h"
+
+///
+/// @brief Converts a sequence of tokens from infix to postfix order.
+///
+/// The tokens are pushed one at a time and the class validates them as they
+/// arrive. Instead of building the postfix form itself, it reports each
+/// number and each operation to a Sink, which must provide:
+///
+///   void number(double value);
+///   void apply(Action action);
+///
+/// This allows the same algorithm to be used both for compiling an
+/// expression to a program and for evaluating it directly.
+///
+/// Errors are reported with codes instead of exceptions, so that callers
+/// which process many expressions can handle incorrect ones cheaply.
+///
+template <typename Sink>
+class ShuntingYard {
+
+  /// An entry in the stack of operations that are waiting for their right operand.
+  /// Brackets are stored in the stack too, as entries with isBracket set.
+  struct Pending {
+    Operation operation;
+    bool isBracket;
+  };
+
+  const OperationSet& m_operations;
+  Sink& m_sink;
+  std::vector<Pending> m_pending;
+  bool m_expectOperand = true;
+  bool m_empty = true;
+
+public:
+  ShuntingYard(const OperationSet& operations, Sink& sink)
+    : m_operations(operations), m_sink(sink)
+  {
+  }
+
+  /// Processes the next token of the expression.
+  /// Returns expression_error::none on success or the reason why the token cannot appear at this position.
+  expression_error push(const Token& token)
+  {
+    m_empty = false;
+
+    switch (token.type) {
+      case TokenType::Number:
+        if ( ! m_expectOperand)
+          return expression_error::unexpected_number;
+        m_sink.number(token.value);
+        m_expectOperand = false;
+        break;
+
+      case TokenType::OpeningBracket:
+        if ( ! m_expectOperand)
+          return expression_error::unexpected_opening_bracket;
+        m_pending.push_back({Operation(), true});
+        break;
+
+      case TokenType::Operation:
+        if (m_expectOperand)
+          return expression_error::unexpected_operation;
+        if ( ! m_operations.contains(token.symbol))
+          return expression_error::undefined_operation;
+        pushOperation(m_operations.get(token.symbol));
+        m_expectOperand = true;
+        break;
+
+      case TokenType::ClosingBracket:
+        if (m_expectOperand)
+          return expression_error::unexpected_closing_bracket;
+        return popUntilBracket();
+
+      case TokenType::Invalid:
+        return expression_error::invalid_token;
+
+      case TokenType::End:
+        // The end of the expression is handled by finish()
+        break;
+    }
+
+    return expression_error::none;
+  }
+
+  /// Completes the processing of the expression.
+  /// Returns expression_error::none on success or the reason why the expression is not complete.
+  expression_error finish()
+  {
+    if (m_empty)
+      return expression_error::none;
+
+    if (m_expectOperand)
+      return expression_error::incomplete_expression;
+
+    while ( ! m_pending.empty()) {
+      if (m_pending.back().isBracket)
+        return expression_error::unclosed_bracket;
+
+      m_sink.apply(m_pending.back().operation.action);
+      m_pending.pop_back();
+    }
+
+    return expression_error::none;
+  }
+
+  /// Checks whether no tokens were pushed, i.e. the expression is empty and evaluates to 0
+  bool empty() const noexcept
+  {
+    return m_empty;
+  }
+
+private:
+  void pushOperation(const Operation& operation)
+  {
+    while ( ! m_pending.empty() && ! m_pending.back().isBracket) {
+      const Operation& top = m_pending.back().operation;
+
+      bool topFirst =
+        top.priority > operation.priority ||
+        (top.priority == operation.priority && ! operation.rightAssociative);
+
+      if ( ! topFirst)
+        break;
+
+      m_sink.apply(top.action);
+      m_pending.pop_back();
+    }
+
+    m_pending.push_back({operation, false});
+  }
+
+  expression_error popUntilBracket()
+  {
+    while ( ! m_pending.empty() && ! m_pending.back().isBracket) {
+      m_sink.apply(m_pending.back().operation.action);
+      m_pending.pop_back();
+    }
+
+    if (m_pending.empty())
+      return expression_error::unmatched_closing_bracket;
+
+    m_pending.pop_back();
+    return expression_error::none;
+  }
+};
@@ -0,0 +1,126 @@
+#include "streaming-parser.h"
+
+#include "tokenizer.h"
+
+StreamingParser::StreamingParser(const OperationSet& operations)
+  : m_parser(operations, m_evaluator)
+{
+}
+
+bool StreamingParser::feed(const char* data, size_t size)
+{
+  const char* p = data;
+  const char* end = data + size;
+
+  while (p != end && ! failed()) {
+    if (Tokenizer::isSeparator(*p)) {
+      // A separator at the start of the fragment completes a token from the previous one
+      if ( ! m_token.empty())
+        completePendingToken();
+
+      ++p;
+      continue;
+    }
+
+    const char* begin = p;
+
+    while (p != end && ! Tokenizer::isSeparator(*p))
+      ++p;
+
+    size_t offset = m_offset + (begin - data);
+
+    if (p != end && m_token.empty()) {
+      // The whole token is in this fragment, so it does not need to be copied
+      completeToken(begin, p, offset);
+      continue;
+    }
+
+    // The token continues from the previous fragment or into the next one
+    if (m_token.empty())
+      m_tokenOffset = offset;
+
+    if (m_token.size() + (p - begin) > MaxTokenLength) {
+      fail(expression_error::invalid_token, m_tokenOffset);
+      break;
+    }
+
+    m_token.append(begin, p);
+
+    if (p != end)
+      completePendingToken();
+  }
+
+  m_offset += size;
+  return ! failed();
+}
+
+double StreamingParser::finish()
+{
+  double result;
+  ParseError error;
+
+  if ( ! tryFinish(result, error))
+    throw error.toException();
+
+  return result;
+}
+
+bool StreamingParser::tryFinish(double& result, ParseError& error)
+{
+  if ( ! failed() && ! m_token.empty())
+    completePendingToken();
+
+  if ( ! failed()) {
+    expression_error code = m_parser.finish();
+
+    if (code != expression_error::none)
+      fail(code, m_offset);
+  }
+
+  error = m_error;
+
+  if (failed())
+    return false;
+
+  result = m_evaluator.result();
+  return true;
+}
+
+double StreamingParser::evaluate(std::istream& expression, const OperationSet& operations)
+{
+  StreamingParser parser(operations);
+  std::vector<char> fragment(FragmentSize);
+
+  while (expression) {
+    expression.read(fragment.data(), fragment.size());
+
+    if ( ! parser.feed(fragment.data(), static_cast<size_t>(expression.gcount())))
+      break;
+  }
+
+  return parser.finish();
+}
+
+void StreamingParser::completeToken(const char* begin, const char* end, size_t offset)
+{
+  Token token = Tokenizer::classify(begin, end);
+  token.offset = offset;
+
+  expression_error code = m_parser.push(token);
+
+  if (code != expression_error::none)
+    fail(code, offset);
+  else
+    ++m_tokensCount;
+}
+
+void StreamingParser::completePendingToken()
+{
+  completeToken(m_token.data(), m_token.data() + m_token.size(), m_tokenOffset);
+  m_token.clear();
+}
+
+void StreamingParser::fail(expression_error code, size_t offset)
+{
+  m_error = {code, m_tokensCount, offset};
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "operation-set.h"
+#include "program.h"
+#include "shunting-yard.h"
+
+///
+/// @brief Evaluates an expression, which arrives in fragments.
+///
+/// The fragments are passed to feed() as they arrive, for example while
+/// reading from a pipe. A token may be split between two fragments. The
+/// parser keeps the state of the shunting-yard algorithm between the calls
+/// and evaluates each operation as soon as both of its operands are known,
+/// so it never stores the expression itself or its postfix form.
+///
+/// The memory used is proportional to the largest number of operations
+/// that wait for their right operand at the same time. This is bounded by
+/// the nesting depth of the brackets plus the length of the longest chain
+/// of operations, which cannot be evaluated yet because of their priority
+/// or associativity (e.g. "1 r 2 r 3 r ..." for a right-associative r).
+/// It does not depend on the length of the expression.
+///
+class StreamingParser {
+
+  /// A sink for ShuntingYard, which evaluates each operation immediately
+  class Evaluator {
+    std::vector<double> m_operands;
+
+  public:
+    void number(double value)
+    {
+      m_operands.push_back(value);
+    }
+
+    void apply(Action action)
+    {
+      double rhs = m_operands.back();
+      m_operands.pop_back();
+      m_operands.back() = ::apply(action, m_operands.back(), rhs);
+    }
+
+    double result() const noexcept
+    {
+      return m_operands.empty() ? 0 : m_operands.back();
+    }
+  };
+
+  Evaluator m_evaluator;
+  ShuntingYard<Evaluator> m_parser;
+
+  std::string m_token;          ///< Characters of a token that may continue in the next fragment
+  size_t m_tokenOffset = 0;     ///< Offset of the first character of m_token
+  size_t m_tokensCount = 0;     ///< Number of completed tokens
+  size_t m_offset = 0;          ///< Number of characters received so far
+  ParseError m_error;
+
+public:
+  /// Tokens longer than this are reported as invalid, which keeps the token buffer bounded too
+  static constexpr size_t MaxTokenLength = 1024;
+
+  /// Size of the fragments in which evaluate() reads a stream
+  static constexpr size_t FragmentSize = 64 * 1024;
+
+  /// Creates a parser for expressions, which use a given set of operations.
+  /// The set must outlive the parser.
+  explicit StreamingParser(const OperationSet& operations);
+
+  StreamingParser(const StreamingParser&) = delete;
+  StreamingParser& operator=(const StreamingParser&) = delete;
+
+  /// Processes the next fragment of the expression.
+  /// Returns false if an error has been detected, either in this fragment or in a previous one.
+  /// After an error, the parser ignores the remaining fragments.
+  bool feed(const char* data, size_t size);
+
+  /// Completes the expression and computes its value
+  /// @exception incorrect_expression If the expression is not valid
+  double finish();
+
+  /// Completes the expression without throwing for incorrect expressions.
+  /// Returns false and describes the problem in error if the expression is not valid.
+  bool tryFinish(double& result, ParseError& error);
+
+  /// Checks whether an error has been detected
+  bool failed() const noexcept
+  {
+    return m_error.code != expression_error::none;
+  }
+
+  /// The first detected error, or an error with code expression_error::none
+  const ParseError& error() const noexcept
+  {
+    return m_error;
+  }
+
+  /// Reads a whole expression from a stream in fragments and evaluates it
+  /// @exception incorrect_expression If the expression is not valid
+  static double evaluate(std::istream& expression, const OperationSet& operations);
+
+private:
+  void completeToken(const char* begin, const char* end, size_t offset);
+  void completePendingToken();
+  void fail(expression_error code, size_t offset);
+};
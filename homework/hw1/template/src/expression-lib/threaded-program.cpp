@@ -0,0 +1,112 @@
+#include "threaded-program.h"
+
+namespace {
+
+/// Position of the target that stops the execution. It follows the targets of all opcodes.
+const size_t HaltIndex = static_cast<size_t>(OpCode::Divide) + 1;
+
+} // namespace
+
+ThreadedProgram::ThreadedProgram(const Program& program)
+  : m_stackDepth(program.stackDepth())
+{
+  if (program.empty())
+    return;
+
+  const Target* targets = nullptr;
+  execute(nullptr, nullptr, &targets);
+
+  m_code.reserve(program.code().size() + 1);
+
+  for (const Instruction& instruction : program.code())
+    m_code.push_back({targets[static_cast<size_t>(instruction.code)], instruction.value});
+
+  m_code.push_back({targets[HaltIndex], 0});
+}
+
+double ThreadedProgram::run() const
+{
+  if (m_code.empty())
+    return 0;
+
+  ScratchStack stack(m_stackDepth);
+  return execute(m_code.data(), stack.data(), nullptr);
+}
+
+#if defined(__GNUC__)
+
+//
+// The addresses of the labels are only available inside this function,
+// so when targets is not null, it only returns the table of addresses.
+// The order in the table must match the order of the opcodes.
+//
+double ThreadedProgram::execute(const Cell* ip, double* stack, const Target** targets)
+{
+  static const Target table[] = { &&push, &&add, &&subtract, &&multiply, &&divide, &&halt };
+
+  if (targets) {
+    *targets = table;
+    return 0;
+  }
+
+  double* top = stack - 1;
+
+  goto *ip->target;
+
+push:
+  *++top = ip->value;
+  goto *(++ip)->target;
+
+add:
+  --top; *top = top[0] + top[1];
+  goto *(++ip)->target;
+
+subtract:
+  --top; *top = top[0] - top[1];
+  goto *(++ip)->target;
+
+multiply:
+  --top; *top = top[0] * top[1];
+  goto *(++ip)->target;
+
+divide:
+  --top; *top = top[0] / top[1];
+  goto *(++ip)->target;
+
+halt:
+  return *top;
+}
+
+#else
+
+namespace {
+
+using Cell = ThreadedProgram::Cell;
+
+double* push(const Cell& cell, double* top)     { *++top = cell.value; return top; }
+double* add(const Cell&, double* top)           { --top; *top = top[0] + top[1]; return top; }
+double* subtract(const Cell&, double* top)      { --top; *top = top[0] - top[1]; return top; }
+double* multiply(const Cell&, double* top)      { --top; *top = top[0] * top[1]; return top; }
+double* divide(const Cell&, double* top)        { --top; *top = top[0] / top[1]; return top; }
+double* halt(const Cell&, double* top)          { return top; }
+
+} // namespace
+
+double ThreadedProgram::execute(const Cell* ip, double* stack, const Target** targets)
+{
+  static const Target table[] = { push, add, subtract, multiply, divide, halt };
+
+  if (targets) {
+    *targets = table;
+    return 0;
+  }
+
+  double* top = stack - 1;
+
+  for (; ip->target != halt; ++ip)
+    top = ip->target(*ip, top);
+
+  return *top;
+}
+
+#endif
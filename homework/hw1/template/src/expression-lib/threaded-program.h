@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "program.h"
+
+///
+/// @brief A program translated to threaded code.
+///
+/// Each instruction stores the address of the code that executes it, so the
+/// interpreter jumps directly from one handler to the next instead of going
+/// back to a central switch. With GCC and Clang this uses computed goto
+/// (labels as values). Other compilers get call threading: each instruction
+/// stores a pointer to a function that executes it.
+///
+class ThreadedProgram {
+public:
+  struct Cell;
+
+#if defined(__GNUC__)
+  using Target = const void*;
+#else
+  using Target = double* (*)(const Cell&, double*);
+#endif
+
+  struct Cell {
+    Target target;
+    double value;
+  };
+
+private:
+  std::vector<Cell> m_code;
+  size_t m_stackDepth = 0;
+
+public:
+  /// Constructs an empty program, which evaluates to 0
+  ThreadedProgram() = default;
+
+  /// Translates a compiled program to threaded code
+  explicit ThreadedProgram(const Program& program);
+
+  double run() const;
+
+private:
+  static double execute(const Cell* code, double* stack, const Target** targets);
+};
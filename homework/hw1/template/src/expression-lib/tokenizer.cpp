@@ -0,0 +1,81 @@
+#include "tokenizer.h"
+
+#include "operation-set.h"
+
+#include <charconv>
+
+Tokenizer::Tokenizer(const char* expression) noexcept
+  : m_begin(expression), m_position(expression)
+{
+}
+
+Token Tokenizer::next() noexcept
+{
+  while (isSeparator(*m_position))
+    ++m_position;
+
+  if (*m_position == '\0') {
+    Token end;
+    end.offset = m_position - m_begin;
+    return end;
+  }
+
+  const char* begin = m_position;
+
+  while (*m_position != '\0' && ! isSeparator(*m_position))
+    ++m_position;
+
+  Token token = classify(begin, m_position);
+  token.offset = begin - m_begin;
+  return token;
+}
+
+Token Tokenizer::classify(const char* begin, const char* end) noexcept
+{
+  Token token;
+
+  if (end - begin == 1) {
+    switch (*begin) {
+      case '(':
+        token.type = TokenType::OpeningBracket;
+        return token;
+      case ')':
+        token.type = TokenType::ClosingBracket;
+        return token;
+      default:
+        if (OperationSet::isSymbol(*begin)) {
+          token.type = TokenType::Operation;
+          token.symbol = *begin;
+          return token;
+        }
+    }
+  }
+
+  // A number is an optional minus, followed by digits and an optional fraction.
+  // std::from_chars also accepts forms like "inf" and "1e5", so the format
+  // is checked separately.
+  const char* p = begin;
+
+  if (*p == '-')
+    ++p;
+
+  const char* digits = p;
+
+  while (p != end && '0' <= *p && *p <= '9')
+    ++p;
+
+  if (p != end && *p == '.') {
+    ++p;
+    while (p != end && '0' <= *p && *p <= '9')
+      ++p;
+  }
+
+  if (p != end || p == digits || *digits == '.') {
+    token.type = TokenType::Invalid;
+    return token;
+  }
+
+  token.type = TokenType::Number;
+  std::from_chars(begin, end, token.value);
+  return token;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+
+/// Kinds of tokens that can appear in an expression
+enum class TokenType {
+  Number,
+  Operation,
+  OpeningBracket,
+  ClosingBracket,
+  End,
+  Invalid     ///< A sequence of characters, which is not a valid token
+};
+
+/// A single token extracted from an expression
+struct Token {
+  TokenType type = TokenType::End;
+  double value = 0;         ///< Value of a Number token
+  char symbol = 0;          ///< Symbol of an Operation token
+  size_t offset = 0;        ///< Position of the first character of the token in the expression
+};
+
+///
+/// @brief Splits an expression into tokens.
+///
+/// Tokens are separated by one or more whitespace characters. A token is
+/// either a bracket, a single latin letter (an operation) or a number with
+/// an optional minus sign attached to it.
+///
+class Tokenizer {
+  const char* m_begin;
+  const char* m_position;
+
+public:
+  /// Creates a tokenizer for a null-terminated string
+  explicit Tokenizer(const char* expression) noexcept;
+
+  /// Extracts the next token. Returns a token of type End when there are none left
+  /// and a token of type Invalid when the next characters do not form a valid token.
+  Token next() noexcept;
+
+  /// Classifies a single token, whose characters are [begin, end).
+  /// Returns a token of type Invalid if the characters do not form a valid token.
+  static Token classify(const char* begin, const char* end) noexcept;
+
+  /// Checks whether a character separates tokens
+  static bool isSeparator(char c) noexcept
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+};
@@ -0,0 +1,130 @@
+#include "catch2/catch_all.hpp"
+
+#include "expression-lib/expression.h"
+#include "expression-lib/program.h"
+
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+// Ensures (with REQUIRE) that compiling an expression fails with a given error at a given token
+void requireErrorAt(const char* expression, const OperationSet& ops, expression_error code, size_t tokenIndex, size_t offset)
+{
+	Program program;
+	ParseError error;
+
+	REQUIRE_FALSE(Program::tryCompile(expression, ops, program, error));
+	CHECK(error.code == code);
+	CHECK(error.tokenIndex == tokenIndex);
+	CHECK(error.offset == offset);
+}
+
+TEST_CASE("Program::tryCompile() reports the reason and the position of errors")
+{
+	std::stringstream in("a + 10 L");
+	OperationSet ops = OperationSet::read(in);
+
+	SECTION("Null expression") {
+		requireErrorAt(nullptr, ops, expression_error::null_expression, 0, 0);
+	}
+	SECTION("Invalid token") {
+		requireErrorAt("1 a - 2", ops, expression_error::invalid_token, 2, 4);
+	}
+	SECTION("Undefined operation") {
+		requireErrorAt("1  b 2", ops, expression_error::undefined_operation, 1, 3);
+	}
+	SECTION("Two consecutive numbers") {
+		requireErrorAt("1 a 2 3", ops, expression_error::unexpected_number, 3, 6);
+	}
+	SECTION("Two consecutive operations") {
+		requireErrorAt("1 a a 2", ops, expression_error::unexpected_operation, 2, 4);
+	}
+	SECTION("Opening bracket after a number") {
+		requireErrorAt("1 ( 2 )", ops, expression_error::unexpected_opening_bracket, 1, 2);
+	}
+	SECTION("Empty brackets") {
+		requireErrorAt("( )", ops, expression_error::unexpected_closing_bracket, 1, 2);
+	}
+	SECTION("Closing bracket without an opening one") {
+		requireErrorAt("1 a 2 )", ops, expression_error::unmatched_closing_bracket, 3, 6);
+	}
+	SECTION("Bracket that is not closed") {
+		requireErrorAt("( 1 a 2", ops, expression_error::unclosed_bracket, 4, 7);
+	}
+	SECTION("Expression ending with an operation") {
+		requireErrorAt("1 a ", ops, expression_error::incomplete_expression, 2, 4);
+	}
+}
+
+TEST_CASE("Program::tryCompile() succeeds for correct expressions")
+{
+	std::stringstream in("a + 10 L");
+	OperationSet ops = OperationSet::read(in);
+
+	Program program;
+	ParseError error;
+
+	REQUIRE(Program::tryCompile("1 a ( 2 a 3 )", ops, program, error));
+	REQUIRE(program.run() == 6);
+}
+
+TEST_CASE("incorrect_expression carries the error code and position")
+{
+	std::stringstream ops("a + 10 L");
+
+	try {
+		evaluate("1 a b", ops);
+		FAIL("evaluate() did not throw");
+	}
+	catch (const incorrect_expression& e) {
+		CHECK(e.code() == expression_error::unexpected_operation);
+		CHECK(e.token_index() == 2);
+		CHECK(e.offset() == 4);
+
+		const char* message = e.what();
+		CHECK(std::strstr(message, describe(expression_error::unexpected_operation)) != nullptr);
+		CHECK(std::strstr(message, "token 2") != nullptr);
+		CHECK(std::strstr(message, "offset 4") != nullptr);
+
+		// The message is formatted once and then reused
+		CHECK(e.what() == message);
+	}
+}
+
+TEST_CASE("incorrect_expression::what() can be called by several threads")
+{
+	std::exception_ptr error = std::make_exception_ptr(incorrect_expression(expression_error::unclosed_bracket, 3, 5));
+	const char* messages[2] = {};
+
+	auto read = [&error](const char*& message) {
+		try {
+			std::rethrow_exception(error);
+		}
+		catch (const incorrect_expression& e) {
+			message = e.what();
+		}
+	};
+
+	std::thread first(read, std::ref(messages[0]));
+	std::thread second(read, std::ref(messages[1]));
+	first.join();
+	second.join();
+
+	REQUIRE(messages[0] != nullptr);
+	REQUIRE(messages[1] != nullptr);
+	CHECK(std::string(messages[0]) == std::string(messages[1]));
+	CHECK(std::strstr(messages[0], "offset 5") != nullptr);
+}
+
+TEST_CASE("incorrect_expression created with a message keeps that message")
+{
+	incorrect_expression e("custom message");
+
+	CHECK(e.code() == expression_error::unspecified);
+	CHECK(e.token_index() == incorrect_expression::npos);
+	CHECK(std::strcmp(e.what(), "custom message") == 0);
+}
@@ -0,0 +1,121 @@
+#include "catch2/catch_all.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "expression-lib/closure-tree.h"
+#include "expression-lib/expression.h"
+#include "expression-lib/program.h"
+#include "expression-lib/threaded-program.h"
+
+#include <sstream>
+
+
+// Ensures (with REQUIRE) that all evaluation strategies compute the expected value
+void requireAllStrategiesEvaluateTo(const char* expression, const OperationSet& ops, double expectedValue)
+{
+	Program program = Program::compile(expression, ops);
+	ThreadedProgram threaded(program);
+	ClosureTree tree(program);
+
+	REQUIRE_THAT(program.run(), Catch::Matchers::WithinRel(expectedValue, 0.001));
+	REQUIRE_THAT(threaded.run(), Catch::Matchers::WithinRel(expectedValue, 0.001));
+	REQUIRE_THAT(tree.run(), Catch::Matchers::WithinRel(expectedValue, 0.001));
+}
+
+TEST_CASE("Empty programs evaluate to 0 with all strategies")
+{
+	OperationSet ops;
+	Program program = Program::compile("   ", ops);
+
+	REQUIRE(program.empty());
+	REQUIRE(program.run() == 0);
+	REQUIRE(ThreadedProgram(program).run() == 0);
+	REQUIRE(ClosureTree(program).run() == 0);
+}
+
+TEST_CASE("A moved ClosureTree keeps its nodes and the source becomes empty")
+{
+	std::stringstream in(
+		"a + 10 L\n"
+		"m * 20 L");
+	OperationSet ops = OperationSet::read(in);
+	ClosureTree tree(Program::compile("1 a 2 m 3", ops));
+
+	ClosureTree moved(std::move(tree));
+	REQUIRE(moved.run() == 7);
+	REQUIRE(tree.run() == 0);
+
+	tree = std::move(moved);
+	REQUIRE(tree.run() == 7);
+	REQUIRE(moved.run() == 0);
+}
+
+TEST_CASE("Program::compile() produces postfix code")
+{
+	std::stringstream in(
+		"a + 10 L\n"
+		"m * 20 L");
+	OperationSet ops = OperationSet::read(in);
+
+	Program program = Program::compile("1 a 2 m 3", ops);
+	const std::vector<Instruction>& code = program.code();
+
+	REQUIRE(code.size() == 5);
+	CHECK(code[0].code == OpCode::Push);
+	CHECK(code[1].code == OpCode::Push);
+	CHECK(code[2].code == OpCode::Push);
+	CHECK(code[3].code == OpCode::Multiply);
+	CHECK(code[4].code == OpCode::Add);
+	CHECK(program.stackDepth() == 3);
+}
+
+TEST_CASE("Program::compile() throws for incorrect expressions")
+{
+	std::stringstream in("a + 10 L");
+	OperationSet ops = OperationSet::read(in);
+
+	REQUIRE_THROWS_AS(Program::compile(nullptr, ops), incorrect_expression);
+	REQUIRE_THROWS_AS(Program::compile("1 a", ops), incorrect_expression);
+	REQUIRE_THROWS_AS(Program::compile("1 b 2", ops), incorrect_expression);
+}
+
+TEST_CASE("All evaluation strategies compute the same values")
+{
+	std::stringstream in(
+		"a + 10 L\n"
+		"b - 10 L\n"
+		"m * 20 L\n"
+		"d / 10 R");
+	OperationSet ops = OperationSet::read(in);
+
+	SECTION("Single number") {
+		requireAllStrategiesEvaluateTo("42", ops, 42);
+	}
+	SECTION("Single operation") {
+		requireAllStrategiesEvaluateTo("2 a 3", ops, 5);
+	}
+	SECTION("Different priorities") {
+		requireAllStrategiesEvaluateTo("1 a -2 m 3", ops, -5);
+	}
+	SECTION("Right associativity") {
+		requireAllStrategiesEvaluateTo("8 d 4 d 2", ops, 4);
+	}
+	SECTION("Brackets on both sides") {
+		requireAllStrategiesEvaluateTo("( 5 a -2 ) m ( 3 b 1 )", ops, 6);
+	}
+	SECTION("Nested brackets") {
+		requireAllStrategiesEvaluateTo("2 m ( 51 a ( -1 m 8 ) ) b ( 1 a ( 2 d ( 4 ) ) )", ops, 84.5);
+	}
+}
+
+TEST_CASE("All evaluation strategies handle programs deeper than the local stack buffer")
+{
+	std::stringstream in("d / 10 R");
+	OperationSet ops = OperationSet::read(in);
+
+	// A right-associative chain keeps every operand on the stack until the end
+	std::string expression = "1";
+	for (int i = 0; i < 500; ++i)
+		expression += " d 1";
+
+	requireAllStrategiesEvaluateTo(expression.c_str(), ops, 1);
+}
@@ -0,0 +1,159 @@
+#include "catch2/catch_all.hpp"
+
+#include "expression-lib/expression.h"
+#include "expression-lib/expression-cache.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+OperationSet makeOperations(const char* description)
+{
+	std::stringstream in(description);
+	return OperationSet::read(in);
+}
+
+TEST_CASE("ExpressionCache::normalize() collapses whitespace")
+{
+	CHECK(ExpressionCache::normalize("") == "");
+	CHECK(ExpressionCache::normalize("   ") == "");
+	CHECK(ExpressionCache::normalize("1 a 2") == "1 a 2");
+	CHECK(ExpressionCache::normalize("  1 \t a\n\n2  ") == "1 a 2");
+}
+
+TEST_CASE("ExpressionCache serves repeated expressions from the cache")
+{
+	OperationSet ops = makeOperations("a + 10 L");
+	ExpressionCache cache(16);
+
+	REQUIRE(cache.evaluate("1 a 2", ops) == 3);
+	CHECK(cache.misses() == 1);
+	CHECK(cache.hits() == 0);
+
+	SECTION("The same text is a hit") {
+		REQUIRE(cache.evaluate("1 a 2", ops) == 3);
+		CHECK(cache.hits() == 1);
+		CHECK(cache.misses() == 1);
+	}
+	SECTION("The same tokens with different whitespace are a hit") {
+		REQUIRE(cache.evaluate("  1    a 2 ", ops) == 3);
+		CHECK(cache.hits() == 1);
+	}
+	SECTION("A different expression is a miss") {
+		REQUIRE(cache.evaluate("1 a 3", ops) == 4);
+		CHECK(cache.misses() == 2);
+		CHECK(cache.size() == 2);
+	}
+}
+
+TEST_CASE("ExpressionCache does not mix results for different operation sets")
+{
+	OperationSet add = makeOperations("a + 10 L");
+	OperationSet multiply = makeOperations("a * 10 L");
+	ExpressionCache cache(16);
+
+	REQUIRE(cache.evaluate("2 a 3", add) == 5);
+	REQUIRE(cache.evaluate("2 a 3", multiply) == 6);
+	CHECK(cache.misses() == 2);
+	CHECK(cache.hits() == 0);
+}
+
+TEST_CASE("ExpressionCache does not cache incorrect expressions")
+{
+	OperationSet ops = makeOperations("a + 10 L");
+	ExpressionCache cache(16);
+
+	REQUIRE_THROWS_AS(cache.evaluate("1 a", ops), incorrect_expression);
+	REQUIRE_THROWS_AS(cache.evaluate("1 a", ops), incorrect_expression);
+	REQUIRE_THROWS_AS(cache.evaluate(nullptr, ops), incorrect_expression);
+	CHECK(cache.size() == 0);
+}
+
+TEST_CASE("ExpressionCache reports errors at their position in the original expression")
+{
+	OperationSet ops = makeOperations("a + 10 L");
+	ExpressionCache cache(16);
+
+	try {
+		cache.evaluate("  1    a   b", ops);
+		FAIL("evaluate() did not throw");
+	}
+	catch (const incorrect_expression& e) {
+		CHECK(e.token_index() == 2);
+		CHECK(e.offset() == 11);
+	}
+}
+
+TEST_CASE("ExpressionCache never exceeds its capacity")
+{
+	OperationSet ops = makeOperations("a + 10 L");
+	const size_t capacity = 32;
+	ExpressionCache cache(capacity);
+
+	for (int i = 0; i < 1000; ++i) {
+		std::string expression = std::to_string(i) + " a 1";
+		REQUIRE(cache.evaluate(expression.c_str(), ops) == i + 1);
+		REQUIRE(cache.size() <= capacity);
+	}
+
+	CHECK(cache.misses() == 1000);
+}
+
+TEST_CASE("ExpressionCache with zero capacity evaluates without caching")
+{
+	OperationSet ops = makeOperations("a + 10 L");
+	ExpressionCache cache(0);
+
+	REQUIRE(cache.evaluate("1 a 2", ops) == 3);
+	REQUIRE(cache.evaluate("1 a 2", ops) == 3);
+	CHECK(cache.hits() == 0);
+	CHECK(cache.misses() == 2);
+	CHECK(cache.size() == 0);
+}
+
+TEST_CASE("ExpressionCache::clear() removes all entries and resets the counters")
+{
+	OperationSet ops = makeOperations("a + 10 L");
+	ExpressionCache cache(16);
+
+	cache.evaluate("1 a 2", ops);
+	cache.evaluate("1 a 2", ops);
+	cache.clear();
+
+	CHECK(cache.size() == 0);
+	CHECK(cache.hits() == 0);
+	CHECK(cache.misses() == 0);
+}
+
+TEST_CASE("ExpressionCache can be used by several threads at the same time")
+{
+	OperationSet ops = makeOperations("a + 10 L");
+	ExpressionCache cache(64);
+
+	const int threadsCount = 4;
+	const int iterations = 2000;
+	std::vector<std::thread> threads;
+	std::vector<int> errors(threadsCount, 0);
+
+	for (int t = 0; t < threadsCount; ++t) {
+		threads.emplace_back([&, t]() {
+			for (int i = 0; i < iterations; ++i) {
+				int n = i % 100;
+				std::string expression = std::to_string(n) + " a " + std::to_string(n);
+				if (cache.evaluate(expression.c_str(), ops) != 2 * n)
+					++errors[t];
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	for (int e : errors)
+		CHECK(e == 0);
+
+	CHECK(cache.hits() + cache.misses() == threadsCount * iterations);
+	CHECK(cache.size() <= 64);
+}
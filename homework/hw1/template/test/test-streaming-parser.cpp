@@ -0,0 +1,143 @@
+#include "catch2/catch_all.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "expression-lib/expression.h"
+#include "expression-lib/program.h"
+#include "expression-lib/streaming-parser.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+
+OperationSet makeStreamingOperations()
+{
+	std::stringstream in(
+		"a + 10 L\n"
+		"b - 10 L\n"
+		"m * 20 L\n"
+		"d / 10 R");
+	return OperationSet::read(in);
+}
+
+// Feeds an expression to a parser in fragments of a given size
+double evaluateInFragments(const char* expression, const OperationSet& ops, size_t fragmentSize)
+{
+	StreamingParser parser(ops);
+	size_t length = std::strlen(expression);
+
+	for (size_t i = 0; i < length; i += fragmentSize)
+		parser.feed(expression + i, std::min(fragmentSize, length - i));
+
+	return parser.finish();
+}
+
+TEST_CASE("StreamingParser computes the same values as evaluate() for any split of the input")
+{
+	OperationSet ops = makeStreamingOperations();
+
+	const char* expressions[] = {
+		"",
+		"   ",
+		"42",
+		"-1.5",
+		"1 a 2",
+		"1 a -2 m 3",
+		"8 d 4 d 2",
+		"( 5 a -2 ) m ( 3 b 1 )",
+		"  2 m ( 51 a ( -1 m 8 ) ) b ( 1 a ( 2 d ( 4 ) ) )  "
+	};
+
+	for (const char* expression : expressions) {
+		double expected = Program::compile(expression, ops).run();
+		size_t length = std::strlen(expression);
+
+		for (size_t fragmentSize = 1; fragmentSize <= length + 1; ++fragmentSize) {
+			INFO("Expression: \"" << expression << "\", fragment size: " << fragmentSize);
+			REQUIRE_THAT(evaluateInFragments(expression, ops, fragmentSize), Catch::Matchers::WithinRel(expected, 0.001));
+		}
+	}
+}
+
+TEST_CASE("StreamingParser detects incorrect expressions split into fragments")
+{
+	OperationSet ops = makeStreamingOperations();
+
+	const char* expressions[] = {
+		"1 a",
+		"1 2",
+		"1 x 2",
+		"( 1 a 2",
+		"1 a 2 )",
+		"( )",
+		"1 a - 2",
+		"12a 3"
+	};
+
+	for (const char* expression : expressions) {
+		ParseError expected;
+		Program program;
+		REQUIRE_FALSE(Program::tryCompile(expression, ops, program, expected));
+
+		size_t length = std::strlen(expression);
+
+		for (size_t fragmentSize = 1; fragmentSize <= length; ++fragmentSize) {
+			INFO("Expression: \"" << expression << "\", fragment size: " << fragmentSize);
+			REQUIRE_THROWS_AS(evaluateInFragments(expression, ops, fragmentSize), incorrect_expression);
+
+			StreamingParser parser(ops);
+			for (size_t i = 0; i < length; i += fragmentSize)
+				parser.feed(expression + i, std::min(fragmentSize, length - i));
+
+			double result;
+			ParseError error;
+			REQUIRE_FALSE(parser.tryFinish(result, error));
+			CHECK(error.code == expected.code);
+			CHECK(error.tokenIndex == expected.tokenIndex);
+			CHECK(error.offset == expected.offset);
+		}
+	}
+}
+
+TEST_CASE("StreamingParser::feed() stops at the first error")
+{
+	OperationSet ops = makeStreamingOperations();
+	StreamingParser parser(ops);
+
+	REQUIRE(parser.feed("1 a ", 4));
+	REQUIRE_FALSE(parser.feed("a 2 ", 4));
+	REQUIRE(parser.failed());
+	REQUIRE_FALSE(parser.feed("a 3", 3));
+	CHECK(parser.error().code == expression_error::unexpected_operation);
+	CHECK(parser.error().tokenIndex == 2);
+	CHECK(parser.error().offset == 4);
+}
+
+TEST_CASE("StreamingParser rejects tokens that are too long")
+{
+	OperationSet ops = makeStreamingOperations();
+	StreamingParser parser(ops);
+
+	std::string digits(StreamingParser::MaxTokenLength + 1, '1');
+
+	for (char digit : digits)
+		parser.feed(&digit, 1);
+
+	REQUIRE(parser.failed());
+	CHECK(parser.error().code == expression_error::invalid_token);
+}
+
+TEST_CASE("StreamingParser::evaluate() reads long expressions from a stream")
+{
+	OperationSet ops = makeStreamingOperations();
+
+	// Large enough to span many fragments
+	const size_t operationsCount = 200'000;
+
+	std::string expression = "0";
+	for (size_t i = 0; i < operationsCount; ++i)
+		expression += (i % 2 == 0) ? " a ( 2 m 1 )" : " b 1";
+
+	std::stringstream in(expression);
+	REQUIRE(StreamingParser::evaluate(in, ops) == operationsCount / 2);
+}
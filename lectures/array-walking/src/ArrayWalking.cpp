@@ -1,11 +1,17 @@
+#include "containers/Matrix.h"
 #include "utils/Stopwatch.h"
+#include "utils/ThreadPool.h"
 
-int main()
+const size_t RowsCount = 5'000;
+const size_t ColsCount = 300'000;
+
+/// Walks a RowsCount x ColsCount matrix of type MatrixType in several orders
+template <typename MatrixType>
+void walk(const char* title)
 {
-	const size_t RowsCount = 5'000;
-	const size_t ColsCount = 300'000;
+	std::cout << "=== " << title << " ===\n\n";
 
-	int *parr = new int[RowsCount * ColsCount];
+	MatrixType matrix(RowsCount, ColsCount);
 
 	size_t row, col;
 	unsigned long long sum;
@@ -19,7 +25,7 @@ int main()
 
 	for (row = 0; row < RowsCount; ++row)
 		for (col = 0; col < ColsCount; ++col)
-			parr[ColsCount * row + col] = static_cast<int>(row);
+			matrix(row, col) = static_cast<int>(row);
 
 	sw.stop();
 	std::cout << "\n    execution took " << sw << "\n\n";
@@ -35,10 +41,10 @@ int main()
 
 	for (col = 0; col < ColsCount; ++col)
 		for (row = 0; row < RowsCount; ++row)
-			sum += parr[ColsCount * row + col];
+			sum += matrix(row, col);
 
 	sw.stop();
-	std::cout << "\n    execution took " << sw << "\n\n";
+	std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
 
 
 	//
@@ -51,12 +57,61 @@ int main()
 
 	for (row = 0; row < RowsCount; ++row)
 		for (col = 0; col < ColsCount; ++col)
-			sum += parr[ColsCount * row + col];
+			sum += matrix(row, col);
 
 	sw.stop();
-	std::cout << "\n    execution took " << sw << "\n\n";
+	std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+
+
+	//
+	// Let the layout pick the order
+	//
+	std::cout << "Iterating with forEach() in storage order...";
+
+	sum = 0;
+	sw.start();
+
+	matrix.forEach([&sum](size_t, size_t, int value) { sum += value; });
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+
+
+	//
+	// Iterate over the rows on all cores
+	//
+	ThreadPool& pool = ThreadPool::shared();
+	std::cout << "Iterating by rows and then columns on " << pool.threadCount() << " threads...";
+
+	sw.start();
+
+	sum = pool.parallelReduce<unsigned long long>(0, RowsCount, 16, 0,
+		[&matrix](size_t firstRow, size_t lastRow) {
+			unsigned long long partial = 0;
+
+			for (size_t r = firstRow; r < lastRow; ++r)
+				for (size_t c = 0; c < ColsCount; ++c)
+					partial += matrix(r, c);
+
+			return partial;
+		},
+		[](unsigned long long left, unsigned long long right) { return left + right; });
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+}
+
+int main()
+{
+	walk<Matrix<int, RowMajorLayout>>("Row-major layout");
+	walk<Matrix<int, ColumnMajorLayout>>("Column-major layout");
+
+	// Both walks stay within a tile for a while, so neither is penalized as much
+	walk<Matrix<int, TiledLayout<>>>("Tiled layout");
 
-	delete[] parr;
+	// Walking by columns touches a different page on every access, so it
+	// needs far fewer TLB entries when the array is backed by huge pages.
+	walk<Matrix<int, RowMajorLayout, HugePageAllocation>>("Row-major layout, huge pages");
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,192 @@
+#include "containers/ArrayQueue.h"
+#include "containers/ArrayStack.h"
+#include "containers/DynamicArray.h"
+#include "containers/Matrix.h"
+#include "utils/BenchmarkSuite.h"
+
+#include <memory>
+#include <utility>
+
+const size_t ArraySize = 1'000'000;
+const size_t MovesCount = 1'000'000;
+
+const size_t RowsCount = 2'048;
+const size_t ColsCount = 2'048;
+
+/// An array with the numbers 0, 1, ..., size - 1
+DynamicArray<int> makeArray(size_t size)
+{
+	DynamicArray<int> array(size);
+
+	for (size_t i = 0; i < size; ++i)
+		array[i] = static_cast<int>(i);
+
+	return array;
+}
+
+/// A matrix, whose elements are equal to the indices of their rows
+template <typename MatrixType>
+std::shared_ptr<MatrixType> makeMatrix()
+{
+	auto matrix = std::make_shared<MatrixType>(RowsCount, ColsCount);
+	matrix->forEach([](size_t row, size_t, int& value) { value = static_cast<int>(row); });
+	return matrix;
+}
+
+/// Sums the elements of a matrix, iterating over the rows and then the columns
+template <typename MatrixType>
+unsigned long long sumByRows(const MatrixType& matrix)
+{
+	unsigned long long sum = 0;
+
+	for (size_t row = 0; row < RowsCount; ++row)
+		for (size_t col = 0; col < ColsCount; ++col)
+			sum += matrix(row, col);
+
+	return sum;
+}
+
+/// Sums the elements of a matrix, iterating over the columns and then the rows
+template <typename MatrixType>
+unsigned long long sumByColumns(const MatrixType& matrix)
+{
+	unsigned long long sum = 0;
+
+	for (size_t col = 0; col < ColsCount; ++col)
+		for (size_t row = 0; row < RowsCount; ++row)
+			sum += matrix(row, col);
+
+	return sum;
+}
+
+void addDynamicArrayBenchmarks(BenchmarkSuite& suite)
+{
+	suite.add("DynamicArray::push_back", ArraySize, []() {
+		DynamicArray<int> array;
+
+		for (size_t i = 0; i < ArraySize; ++i)
+			array.push_back(static_cast<int>(i));
+
+		return array;
+	});
+
+	suite.add("DynamicArray::push_back after reserve", ArraySize, []() {
+		DynamicArray<int> array;
+		array.reserve(ArraySize);
+
+		for (size_t i = 0; i < ArraySize; ++i)
+			array.push_back(static_cast<int>(i));
+
+		return array;
+	});
+
+	// Each call reallocates the buffer and moves all elements to the new one
+	suite.add("DynamicArray::reserve, doubling the capacity", 20, []() {
+		DynamicArray<int> array;
+
+		for (size_t capacity = 1; capacity <= ArraySize; capacity *= 2)
+			array.reserve(capacity);
+
+		return array;
+	});
+
+	suite.add("DynamicArray copy constructor", ArraySize, [source = makeArray(ArraySize)]() {
+		return DynamicArray<int>(source);
+	});
+
+	suite.add("DynamicArray move constructor and assignment", MovesCount, [array = makeArray(ArraySize)]() mutable {
+		for (size_t i = 0; i < MovesCount; ++i) {
+			DynamicArray<int> moved(std::move(array));
+			BenchmarkSuite::keep(moved);
+			array = std::move(moved);
+		}
+
+		return array.size();
+	});
+
+	suite.add("DynamicArray::swap", MovesCount, [first = makeArray(ArraySize), second = makeArray(ArraySize / 2)]() mutable {
+		for (size_t i = 0; i < MovesCount; ++i) {
+			first.swap(second);
+			BenchmarkSuite::keep(first);
+		}
+
+		return first.size();
+	});
+
+	suite.add("DynamicArray::operator==", ArraySize, [first = makeArray(ArraySize), second = makeArray(ArraySize)]() {
+		return first == second;
+	});
+}
+
+void addStackAndQueueBenchmarks(BenchmarkSuite& suite)
+{
+	suite.add("ArrayStack::push and pop", ArraySize, []() {
+		ArrayStack<int> stack;
+
+		for (size_t i = 0; i < ArraySize; ++i)
+			stack.push(static_cast<int>(i));
+
+		unsigned long long sum = 0;
+
+		while ( ! stack.empty()) {
+			sum += stack.top();
+			stack.pop();
+		}
+
+		return sum;
+	});
+
+	// The queue holds at most 1000 elements, so it keeps wrapping around its buffer
+	suite.add("ArrayQueue::push and pop", ArraySize, []() {
+		ArrayQueue<int> queue;
+		unsigned long long sum = 0;
+
+		for (size_t i = 0; i < ArraySize; ++i) {
+			queue.push(static_cast<int>(i));
+
+			if (queue.size() == 1000) {
+				sum += queue.front();
+				queue.pop();
+			}
+		}
+
+		return sum;
+	});
+}
+
+void addArrayWalkingBenchmarks(BenchmarkSuite& suite)
+{
+	const size_t elements = RowsCount * ColsCount;
+
+	auto rowMajor = makeMatrix<Matrix<int, RowMajorLayout>>();
+	auto tiled = makeMatrix<Matrix<int, TiledLayout<>>>();
+
+	suite.add("Matrix<RowMajorLayout> by rows", elements, [rowMajor]() {
+		return sumByRows(*rowMajor);
+	});
+
+	suite.add("Matrix<RowMajorLayout> by columns", elements, [rowMajor]() {
+		return sumByColumns(*rowMajor);
+	});
+
+	suite.add("Matrix<TiledLayout> by columns", elements, [tiled]() {
+		return sumByColumns(*tiled);
+	});
+
+	suite.add("Matrix<TiledLayout>::forEach", elements, [tiled]() {
+		unsigned long long sum = 0;
+		static_cast<const Matrix<int, TiledLayout<>>&>(*tiled).forEach([&sum](size_t, size_t, int value) { sum += value; });
+		return sum;
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSuite suite("containers and array walking");
+
+	addDynamicArrayBenchmarks(suite);
+	addStackAndQueueBenchmarks(suite);
+	addArrayWalkingBenchmarks(suite);
+
+	return suite.run(argc, argv);
+}
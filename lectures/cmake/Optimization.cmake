@@ -0,0 +1,130 @@
+#
+# Options for optimized builds
+#
+#   OPTIMIZE_FOR_NATIVE   Compile with -O3 -march=native (GCC and Clang) or /O2 /arch:AVX2 (MSVC)
+#   ENABLE_IPO            Interprocedural (link-time) optimization, if the toolchain supports it
+#   PGO_MODE              Profile-guided optimization phase:
+#                           OFF       no profile-guided optimization
+#                           GENERATE  instrument the code, so that running it writes a profile
+#                           USE       optimize the code with the profile written by GENERATE
+#   PGO_PROFILE_DIR       The directory, where GENERATE writes the profile and USE reads it
+#
+# GENERATE and USE must be built in the same build directory, because
+# GCC names the profile of each object file after the path of that file.
+#
+# add_pgo_report_target() adds a target, which runs the whole workflow and
+# reports the speedup. See ProfileGuidedOptimization.cmake.
+#
+# lectures/cmake and homework/hw1/template/cmake hold identical copies of
+# this module and of ProfileGuidedOptimization.cmake, so that the homework
+# template can be built on its own. The lectures copies are the canonical
+# ones: change them and then copy them to the template.
+#
+
+option(OPTIMIZE_FOR_NATIVE "Compile with -O3 -march=native" OFF)
+option(ENABLE_IPO "Enable interprocedural (link-time) optimization" OFF)
+
+set(PGO_MODE "OFF" CACHE STRING "Profile-guided optimization phase: OFF, GENERATE or USE")
+set_property(CACHE PGO_MODE PROPERTY STRINGS OFF GENERATE USE)
+
+set(PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profile" CACHE PATH "Directory for the profile-guided optimization data")
+
+set(PGO_WORKFLOW_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/ProfileGuidedOptimization.cmake")
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+	# Debian and Ubuntu only install llvm-profdata-<major version> with versioned Clang packages
+	string(REGEX MATCH "^[0-9]+" compilerMajorVersion "${CMAKE_CXX_COMPILER_VERSION}")
+	find_program(LLVM_PROFDATA NAMES llvm-profdata "llvm-profdata-${compilerMajorVersion}")
+endif()
+
+
+if(OPTIMIZE_FOR_NATIVE)
+	if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+		add_compile_options(-O3 -march=native)
+	elseif(MSVC)
+		add_compile_options(/O2 /arch:AVX2)
+	else()
+		message(WARNING "OPTIMIZE_FOR_NATIVE is not supported for ${CMAKE_CXX_COMPILER_ID}")
+	endif()
+endif()
+
+
+if(ENABLE_IPO)
+	include(CheckIPOSupported)
+	check_ipo_supported(RESULT ipoSupported OUTPUT ipoError LANGUAGES CXX)
+
+	if(ipoSupported)
+		message(STATUS "Interprocedural optimization is enabled")
+		set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+	else()
+		message(WARNING "Interprocedural optimization is not supported: ${ipoError}")
+	endif()
+endif()
+
+
+if(PGO_MODE STREQUAL "GENERATE")
+	file(MAKE_DIRECTORY "${PGO_PROFILE_DIR}")
+
+	if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+		# The benchmarks are multithreaded, so the counters are updated atomically where possible
+		add_compile_options("-fprofile-generate=${PGO_PROFILE_DIR}" -fprofile-update=prefer-atomic)
+		add_link_options("-fprofile-generate=${PGO_PROFILE_DIR}")
+	elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+		add_compile_options("-fprofile-generate=${PGO_PROFILE_DIR}")
+		add_link_options("-fprofile-generate=${PGO_PROFILE_DIR}")
+	else()
+		message(WARNING "Profile-guided optimization is not supported for ${CMAKE_CXX_COMPILER_ID}")
+	endif()
+
+elseif(PGO_MODE STREQUAL "USE")
+	if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+		# -fprofile-correction tolerates the inconsistencies left by concurrent updates
+		add_compile_options("-fprofile-use=${PGO_PROFILE_DIR}" -fprofile-correction -Wno-missing-profile)
+		add_link_options("-fprofile-use=${PGO_PROFILE_DIR}")
+	elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+		# Clang writes raw profiles, which llvm-profdata merges into default.profdata
+		add_compile_options("-fprofile-use=${PGO_PROFILE_DIR}/default.profdata" -Wno-profile-instr-unprofiled)
+		add_link_options("-fprofile-use=${PGO_PROFILE_DIR}/default.profdata")
+	else()
+		message(WARNING "Profile-guided optimization is not supported for ${CMAKE_CXX_COMPILER_ID}")
+	endif()
+
+elseif(NOT PGO_MODE STREQUAL "OFF")
+	message(FATAL_ERROR "PGO_MODE is set to an incorrect value!")
+endif()
+
+
+#
+# Adds the pgo-report target. It builds the given benchmarks in separate
+# build directories, as a plain release build, with OPTIMIZE_FOR_NATIVE and
+# ENABLE_IPO, and finally with profile-guided optimization trained on the same
+# benchmarks. Then it runs all three variants and reports the speedups.
+#
+# The benchmarks can be changed with the PGO_TRAINING_TARGETS cache variable.
+# Each variant is run PGO_REPETITIONS times and the shortest run is reported.
+#
+function(add_pgo_report_target)
+	set(PGO_TRAINING_TARGETS "${ARGN}" CACHE STRING "Benchmarks, which train the profile-guided optimization and measure the speedup")
+	set(PGO_REPETITIONS 3 CACHE STRING "How many times pgo-report runs each benchmark")
+
+	# A list cannot be passed on the command line as it is, so its items are separated with commas
+	string(REPLACE ";" "," targets "${PGO_TRAINING_TARGETS}")
+
+	add_custom_target(
+		pgo-report
+		COMMAND
+			${CMAKE_COMMAND}
+			"-DSOURCE_DIR=${CMAKE_SOURCE_DIR}"
+			"-DWORK_DIR=${CMAKE_BINARY_DIR}/pgo-report"
+			"-DGENERATOR=${CMAKE_GENERATOR}"
+			"-DCXX_COMPILER=${CMAKE_CXX_COMPILER}"
+			"-DCXX_COMPILER_ID=${CMAKE_CXX_COMPILER_ID}"
+			"-DLLVM_PROFDATA=${LLVM_PROFDATA}"
+			"-DEXECUTABLE_SUFFIX=${CMAKE_EXECUTABLE_SUFFIX}"
+			"-DTARGETS=${targets}"
+			"-DREPETITIONS=${PGO_REPETITIONS}"
+			-P "${PGO_WORKFLOW_SCRIPT}"
+		USES_TERMINAL
+		COMMENT "Measuring the speedup of native, link-time and profile-guided optimization"
+	)
+endfunction()
@@ -0,0 +1,185 @@
+#
+# The profile-guided optimization workflow, run with cmake -P by the pgo-report target.
+#
+#   1. Build the benchmarks as a plain release build and time them.
+#   2. Build them with OPTIMIZE_FOR_NATIVE and ENABLE_IPO and time them.
+#   3. Build them instrumented (PGO_MODE=GENERATE) and run them to collect a profile.
+#   4. Rebuild them in the same directory with PGO_MODE=USE and time them.
+#
+# The benchmarks are trained and measured on the same inputs, so the
+# reported speedup of step 4 is an upper bound for other workloads.
+#
+# Each variant is timed REPETITIONS times and the shortest run is reported,
+# which filters out most of the noise of a busy machine.
+#
+# Parameters (-D): SOURCE_DIR, WORK_DIR, GENERATOR, CXX_COMPILER, CXX_COMPILER_ID,
+# LLVM_PROFDATA, EXECUTABLE_SUFFIX, TARGETS (comma-separated), REPETITIONS
+#
+# The copy in lectures/cmake is the canonical one (see Optimization.cmake).
+#
+
+cmake_minimum_required(VERSION 3.13)
+
+string(REPLACE "," ";" TARGETS "${TARGETS}")
+
+# Microseconds since the epoch. %f is available since CMake 3.23, older versions measure whole seconds.
+function(now result)
+	if(CMAKE_VERSION VERSION_LESS 3.23)
+		string(TIMESTAMP seconds "%s" UTC)
+		math(EXPR microseconds "${seconds} * 1000000")
+	else()
+		string(TIMESTAMP microseconds "%s%f" UTC)
+	endif()
+
+	set(${result} ${microseconds} PARENT_SCOPE)
+endfunction()
+
+# Configures a release build in directory with the given options and builds the benchmarks
+function(build_benchmarks directory)
+	message(STATUS "Building ${directory}")
+
+	execute_process(
+		COMMAND
+			${CMAKE_COMMAND} -S "${SOURCE_DIR}" -B "${directory}" -G "${GENERATOR}"
+			"-DCMAKE_CXX_COMPILER=${CXX_COMPILER}"
+			-DCMAKE_BUILD_TYPE=Release
+			-DBUILD_TESTING=OFF
+			"-DCMAKE_RUNTIME_OUTPUT_DIRECTORY=${directory}/bin"
+			${ARGN}
+		RESULT_VARIABLE result
+		OUTPUT_QUIET
+	)
+
+	if(result)
+		message(FATAL_ERROR "Configuring ${directory} failed")
+	endif()
+
+	foreach(target IN LISTS TARGETS)
+		execute_process(
+			COMMAND ${CMAKE_COMMAND} --build "${directory}" --config Release --target ${target}
+			RESULT_VARIABLE result
+			OUTPUT_QUIET
+		)
+
+		if(result)
+			message(FATAL_ERROR "Building ${target} in ${directory} failed")
+		endif()
+	endforeach()
+endfunction()
+
+# Runs each benchmark the given number of times and stores
+# its shortest running time in milliseconds in <prefix>_<target>
+function(run_benchmarks directory prefix repetitions)
+	foreach(target IN LISTS TARGETS)
+		# Multi-configuration generators place the executables in a subdirectory
+		set(executable "${directory}/bin/${target}${EXECUTABLE_SUFFIX}")
+
+		if(NOT EXISTS "${executable}")
+			set(executable "${directory}/bin/Release/${target}${EXECUTABLE_SUFFIX}")
+		endif()
+
+		set(shortest "")
+
+		foreach(repetition RANGE 1 ${repetitions})
+			now(start)
+			execute_process(COMMAND "${executable}" WORKING_DIRECTORY "${directory}" RESULT_VARIABLE result OUTPUT_QUIET)
+			now(end)
+
+			if(result)
+				message(FATAL_ERROR "${executable} failed: ${result}")
+			endif()
+
+			math(EXPR milliseconds "(${end} - ${start}) / 1000")
+
+			if(shortest STREQUAL "" OR milliseconds LESS shortest)
+				set(shortest ${milliseconds})
+			endif()
+		endforeach()
+
+		set(${prefix}_${target} ${shortest} PARENT_SCOPE)
+		message(STATUS "    ${target}: ${shortest} ms")
+	endforeach()
+endfunction()
+
+# Formats baseline / optimized as a speedup factor with two decimals, e.g. 1.25x
+function(speedup baseline optimized result)
+	if(optimized EQUAL 0)
+		set(${result} "n/a" PARENT_SCOPE)
+		return()
+	endif()
+
+	math(EXPR hundredths "${baseline} * 100 / ${optimized}")
+	math(EXPR whole "${hundredths} / 100")
+	math(EXPR fraction "${hundredths} % 100")
+
+	if(fraction LESS 10)
+		set(fraction "0${fraction}")
+	endif()
+
+	set(${result} "${whole}.${fraction}x" PARENT_SCOPE)
+endfunction()
+
+
+set(releaseDir "${WORK_DIR}/release")
+set(nativeDir "${WORK_DIR}/native-ipo")
+set(pgoDir "${WORK_DIR}/native-ipo-pgo")
+set(profileDir "${WORK_DIR}/profile")
+
+build_benchmarks("${releaseDir}")
+message(STATUS "Running the release build")
+run_benchmarks("${releaseDir}" release ${REPETITIONS})
+
+build_benchmarks("${nativeDir}" -DOPTIMIZE_FOR_NATIVE=ON -DENABLE_IPO=ON)
+message(STATUS "Running the build with -O3 -march=native and IPO")
+run_benchmarks("${nativeDir}" native ${REPETITIONS})
+
+# Train
+file(REMOVE_RECURSE "${profileDir}")
+build_benchmarks("${pgoDir}" -DOPTIMIZE_FOR_NATIVE=ON -DENABLE_IPO=ON -DPGO_MODE=GENERATE "-DPGO_PROFILE_DIR=${profileDir}")
+message(STATUS "Training the instrumented build")
+run_benchmarks("${pgoDir}" training 1)
+
+if(CXX_COMPILER_ID MATCHES "Clang")
+	if(NOT LLVM_PROFDATA)
+		message(FATAL_ERROR "llvm-profdata was not found, so the profile cannot be merged")
+	endif()
+
+	file(GLOB rawProfiles "${profileDir}/*.profraw")
+	execute_process(COMMAND "${LLVM_PROFDATA}" merge "-output=${profileDir}/default.profdata" ${rawProfiles} RESULT_VARIABLE result)
+
+	if(result)
+		message(FATAL_ERROR "Merging the profile failed")
+	endif()
+endif()
+
+# Rebuild with the profile in the same directory
+build_benchmarks("${pgoDir}" -DPGO_MODE=USE)
+message(STATUS "Running the build with -O3 -march=native, IPO and PGO")
+run_benchmarks("${pgoDir}" pgo ${REPETITIONS})
+
+
+message("")
+message("Shortest running time of the benchmarks in ms out of ${REPETITIONS} runs (speedup over the release build)")
+message("")
+
+set(releaseTotal 0)
+set(nativeTotal 0)
+set(pgoTotal 0)
+
+foreach(target IN LISTS TARGETS)
+	speedup(${release_${target}} ${native_${target}} nativeSpeedup)
+	speedup(${release_${target}} ${pgo_${target}} pgoSpeedup)
+
+	message("    ${target}")
+	message("        release ${release_${target}}, native + IPO ${native_${target}} (${nativeSpeedup}), native + IPO + PGO ${pgo_${target}} (${pgoSpeedup})")
+
+	math(EXPR releaseTotal "${releaseTotal} + ${release_${target}}")
+	math(EXPR nativeTotal "${nativeTotal} + ${native_${target}}")
+	math(EXPR pgoTotal "${pgoTotal} + ${pgo_${target}}")
+endforeach()
+
+speedup(${releaseTotal} ${nativeTotal} nativeSpeedup)
+speedup(${releaseTotal} ${pgoTotal} pgoSpeedup)
+
+message("    total")
+message("        release ${releaseTotal}, native + IPO ${nativeTotal} (${nativeSpeedup}), native + IPO + PGO ${pgoTotal} (${pgoSpeedup})")
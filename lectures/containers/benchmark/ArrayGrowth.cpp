@@ -0,0 +1,101 @@
+#include "containers/Allocation.h"
+#include "containers/DynamicArray.h"
+#include "utils/Stopwatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Starts a new measurement of the peak resident memory of the process.
+/// Returns false if the system does not support it.
+bool resetPeakMemory()
+{
+#if defined(__linux__)
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+	clearRefs.flush();
+	return static_cast<bool>(clearRefs);
+#else
+	return false;
+#endif
+}
+
+/// Peak resident memory since the last resetPeakMemory() in MiB, or 0 if unknown
+size_t peakMemoryMiB()
+{
+	std::ifstream status("/proc/self/status");
+	std::string line;
+
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::stoul(line.substr(6)) / 1024;
+	}
+
+	return 0;
+}
+
+/// Appends count integers one by one and reports the total time,
+/// the longest single push_back (i.e. the slowest reallocation) and the peak memory
+template <typename Array>
+void measure(const char* title, size_t count)
+{
+	using clock = std::chrono::steady_clock;
+
+	bool hasPeakMemory = resetPeakMemory();
+	size_t baseMemory = hasPeakMemory ? peakMemoryMiB() : 0;
+
+	Stopwatch sw;
+	clock::duration slowest{};
+	size_t reallocations = 0;
+	long long sum = 0;
+
+	std::cout << "    " << title << "...";
+	std::cout.flush();
+
+	{
+		Array arr;
+		sw.start();
+
+		for (size_t i = 0; i < count; ++i) {
+			if (arr.size() < arr.capacity()) {
+				arr.push_back(static_cast<int>(i));
+				continue;
+			}
+
+			// Only the push_backs, which reallocate, are timed individually
+			clock::time_point start = clock::now();
+			arr.push_back(static_cast<int>(i));
+			slowest = std::max(slowest, clock::now() - start);
+			++reallocations;
+		}
+
+		sw.stop();
+		sum = arr[count / 2] + arr[count - 1];
+	}
+
+	std::cout
+		<< " (check " << sum << ")\n"
+		<< "        execution took " << sw << ", " << reallocations << " reallocations\n"
+		<< "        slowest reallocation took " << std::chrono::duration_cast<std::chrono::microseconds>(slowest).count() << "us\n";
+
+	if (hasPeakMemory)
+		std::cout << "        peak memory " << peakMemoryMiB() - baseMemory << " MiB\n";
+}
+
+int main()
+{
+	// 512 MiB of ints
+	const size_t Count = size_t(1) << 27;
+
+	std::cout << "Append " << Count << " integers one by one\n";
+
+	measure<DynamicArray<int>>("DynamicArray, copied to a new buffer on growth (DefaultAllocation)", Count);
+	measure<DynamicArray<int, RemappableAllocation>>("DynamicArray, remapped in place on growth (RemappableAllocation)", Count);
+	measure<std::vector<int>>("std::vector", Count);
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include "containers/ArraySerialization.h"
+#include "utils/Stopwatch.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+///
+/// Compares a round-trip through the binary array format with one through text.
+///
+/// Usage: benchmark-array-serialization [elements-count]
+///
+/// By default the array takes 1 GiB.
+///
+int main(int argc, char* argv[])
+{
+	const size_t ElementsCount = (argc > 1) ? std::stoull(argv[1]) : (size_t(1) << 30) / sizeof(int);
+	const std::filesystem::path directory = std::filesystem::temp_directory_path();
+	const std::string binaryPath = (directory / "benchmark-array-serialization.bin").string();
+	const std::string textPath = (directory / "benchmark-array-serialization.txt").string();
+
+	FixedSizeArray<int> arr(ElementsCount);
+
+	for (size_t i = 0; i < ElementsCount; ++i)
+		arr[i] = static_cast<int>(i * 2654435761u);
+
+	Stopwatch sw;
+	unsigned long long sum;
+
+	std::cout << "Array of " << ElementsCount << " ints (" << ElementsCount * sizeof(int) / (1024 * 1024) << " MiB)\n\n";
+
+	//
+	// Text
+	//
+	std::cout << "Writing as text with operator<<...";
+	sw.start();
+	{
+		std::ofstream out(textPath);
+
+		for (size_t i = 0; i < arr.size(); ++i)
+			out << arr[i] << '\n';
+	}
+	sw.stop();
+	std::cout << "\n    execution took " << sw << "\n\n";
+
+	std::cout << "Reading the text back with operator>>...";
+	sum = 0;
+	sw.start();
+	{
+		std::ifstream in(textPath);
+		FixedSizeArray<int> loaded(ElementsCount);
+
+		for (size_t i = 0; i < loaded.size(); ++i)
+			in >> loaded[i];
+
+		for (size_t i = 0; i < loaded.size(); ++i)
+			sum += loaded[i];
+	}
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+
+	std::filesystem::remove(textPath);
+
+	//
+	// Binary
+	//
+	std::cout << "Writing with saveArray()...";
+	sw.start();
+	saveArray(binaryPath, arr);
+	sw.stop();
+	std::cout << "\n    execution took " << sw << "\n\n";
+
+	std::cout << "Loading with loadArray() and verifying the checksum...";
+	sum = 0;
+	sw.start();
+	{
+		ArrayFileView<int> loaded = loadArray<int>(binaryPath);
+
+		for (size_t i = 0; i < loaded.size(); ++i)
+			sum += loaded[i];
+	}
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+
+	std::cout << "Loading with loadArray() without verifying the checksum...";
+	sum = 0;
+	sw.start();
+	{
+		ArrayFileView<int> loaded = loadArray<int>(binaryPath, ChecksumVerification::Skip);
+		loaded.advise(AccessPattern::Sequential);
+
+		for (size_t i = 0; i < loaded.size(); ++i)
+			sum += loaded[i];
+	}
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+
+	std::filesystem::remove(binaryPath);
+
+	return 0;
+}
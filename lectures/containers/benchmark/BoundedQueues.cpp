@@ -0,0 +1,169 @@
+#include "containers/ArrayQueue.h"
+#include "containers/MpmcQueue.h"
+#include "containers/SpscQueue.h"
+#include "utils/Stopwatch.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// An ArrayQueue guarded by a mutex, bounded to a fixed capacity. Used as a baseline.
+template <typename T>
+class LockedQueue {
+	ArrayQueue<T> m_queue;
+	size_t m_capacity;
+	std::mutex m_mutex;
+
+public:
+	explicit LockedQueue(size_t capacity)
+		: m_capacity(capacity)
+	{
+		m_queue.reserve(capacity);
+	}
+
+	bool tryPush(const T& value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_queue.size() == m_capacity)
+			return false;
+
+		m_queue.push(value);
+		return true;
+	}
+
+	bool tryPop(T& result)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_queue.empty())
+			return false;
+
+		result = m_queue.front();
+		m_queue.pop();
+		return true;
+	}
+};
+
+template <typename Queue, typename T>
+void pushWaiting(Queue& queue, const T& value)
+{
+	while ( ! queue.tryPush(value))
+		std::this_thread::yield();
+}
+
+template <typename Queue, typename T>
+void popWaiting(Queue& queue, T& result)
+{
+	while ( ! queue.tryPop(result))
+		std::this_thread::yield();
+}
+
+/// Transfers total elements from producersCount threads to consumersCount threads
+template <typename Queue>
+void measureThroughput(const char* title, size_t producersCount, size_t consumersCount, size_t total)
+{
+	Queue queue(1024);
+	std::atomic<size_t> checksum{0};
+
+	Stopwatch sw;
+
+	std::cout << "    " << title << ", " << producersCount << " producer(s), " << consumersCount << " consumer(s)...";
+	sw.start();
+
+	std::vector<std::thread> threads;
+
+	for (size_t p = 0; p < producersCount; ++p) {
+		threads.emplace_back([&queue, p, producersCount, total]() {
+			for (size_t i = p; i < total; i += producersCount)
+				pushWaiting(queue, i);
+		});
+	}
+
+	for (size_t c = 0; c < consumersCount; ++c) {
+		threads.emplace_back([&queue, &checksum, c, consumersCount, total]() {
+			size_t sum = 0;
+			size_t value;
+
+			// The elements are split evenly, so each consumer knows how many to take
+			for (size_t i = c; i < total; i += consumersCount) {
+				popWaiting(queue, value);
+				sum += value;
+			}
+
+			checksum += sum;
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	sw.stop();
+
+	double seconds = std::chrono::duration<double>(sw.elapsed()).count();
+	std::cout
+		<< " (checksum " << checksum << ")\n        execution took " << sw
+		<< ", " << static_cast<size_t>(total / seconds) << " elements/s\n";
+}
+
+/// Bounces a value between two threads through a pair of queues
+template <typename Queue>
+void measureLatency(const char* title, size_t roundTrips)
+{
+	Queue requests(16);
+	Queue responses(16);
+
+	Stopwatch sw;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+
+	std::thread echo([&]() {
+		size_t value;
+
+		for (size_t i = 0; i < roundTrips; ++i) {
+			popWaiting(requests, value);
+			pushWaiting(responses, value + 1);
+		}
+	});
+
+	size_t value = 0;
+
+	for (size_t i = 0; i < roundTrips; ++i) {
+		pushWaiting(requests, value);
+		popWaiting(responses, value);
+	}
+
+	echo.join();
+	sw.stop();
+
+	auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(sw.elapsed()).count();
+	std::cout
+		<< " (value " << value << ")\n        execution took " << sw
+		<< ", " << nanoseconds / roundTrips << "ns per round trip\n";
+}
+
+int main()
+{
+	const size_t ElementsCount = 10'000'000;
+	const size_t RoundTrips = 1'000'000;
+
+	std::cout << "Throughput: transferring " << ElementsCount << " elements\n";
+	measureThroughput<LockedQueue<size_t>>("ArrayQueue + std::mutex", 1, 1, ElementsCount);
+	measureThroughput<SpscQueue<size_t>>("SpscQueue", 1, 1, ElementsCount);
+	measureThroughput<MpmcQueue<size_t>>("MpmcQueue", 1, 1, ElementsCount);
+
+	for (size_t threadsCount : { 2, 4 }) {
+		measureThroughput<LockedQueue<size_t>>("ArrayQueue + std::mutex", threadsCount, threadsCount, ElementsCount);
+		measureThroughput<MpmcQueue<size_t>>("MpmcQueue", threadsCount, threadsCount, ElementsCount);
+	}
+
+	std::cout << "\nLatency: " << RoundTrips << " round trips between two threads\n";
+	measureLatency<LockedQueue<size_t>>("ArrayQueue + std::mutex", RoundTrips);
+	measureLatency<SpscQueue<size_t>>("SpscQueue", RoundTrips);
+	measureLatency<MpmcQueue<size_t>>("MpmcQueue", RoundTrips);
+
+	return 0;
+}
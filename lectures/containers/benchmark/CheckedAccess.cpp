@@ -0,0 +1,130 @@
+#include "containers/DynamicArray.h"
+#include "containers/FixedSizeArray.h"
+#include "utils/Stopwatch.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+// The array fits in the L2 cache, so the loops are limited by the
+// instructions they execute and not by the bandwidth of the memory
+const size_t ElementsCount = 64 * 1024;
+const int Repetitions = 4'000;
+
+/// Times a function, which sums the elements of an array Repetitions times
+template <typename Sum>
+void measure(const char* title, Sum sum)
+{
+	Stopwatch sw;
+	std::uint64_t total = 0;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+
+	for (int r = 0; r < Repetitions; ++r)
+		total += sum();
+
+	sw.stop();
+	std::cout << " (sum " << total << ")\n        execution took " << sw << "\n";
+}
+
+int main()
+{
+	std::cout
+		<< "operator[] is "
+		<< (CONTAINERS_CHECKED_ACCESS ? "checked" : "unchecked")
+		<< " in this build (CONTAINERS_CHECKED_ACCESS=" << CONTAINERS_CHECKED_ACCESS << ")\n\n";
+
+	FixedSizeArray<std::uint32_t> array(ElementsCount);
+	DynamicArray<std::uint32_t> dynamicArray(ElementsCount);
+	FixedSizeArray<std::uint32_t> indices(ElementsCount);
+
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<std::uint32_t> index(0, ElementsCount - 1);
+
+	for (size_t i = 0; i < ElementsCount; ++i) {
+		array[i] = static_cast<std::uint32_t>(i);
+		dynamicArray[i] = static_cast<std::uint32_t>(i);
+		indices[i] = index(rng);
+	}
+
+	const std::uint32_t* raw = array.data();
+	const std::uint32_t* rawIndices = indices.data();
+
+	//
+	// The loop bound is the size of the array, so the compiler can prove
+	// that a checked index never fails and remove the check
+	//
+	std::cout << "Walking the array in order\n";
+
+	measure("raw pointer", [raw]() {
+		std::uint64_t sum = 0;
+
+		for (size_t i = 0; i < ElementsCount; ++i)
+			sum += raw[i];
+
+		return sum;
+	});
+
+	measure("FixedSizeArray::operator[]", [&array]() {
+		std::uint64_t sum = 0;
+
+		for (size_t i = 0; i < array.size(); ++i)
+			sum += array[i];
+
+		return sum;
+	});
+
+	measure("DynamicArray::operator[]", [&dynamicArray]() {
+		std::uint64_t sum = 0;
+
+		for (size_t i = 0; i < dynamicArray.size(); ++i)
+			sum += dynamicArray[i];
+
+		return sum;
+	});
+
+	measure("FixedSizeArray::at()", [&array]() {
+		std::uint64_t sum = 0;
+
+		for (size_t i = 0; i < array.size(); ++i)
+			sum += array.at(i);
+
+		return sum;
+	});
+
+	//
+	// The indices come from another array, so every checked access
+	// has to compare the index to the size of the array
+	//
+	std::cout << "\nGathering the elements at random indices\n";
+
+	measure("raw pointer", [raw, rawIndices]() {
+		std::uint64_t sum = 0;
+
+		for (size_t i = 0; i < ElementsCount; ++i)
+			sum += raw[rawIndices[i]];
+
+		return sum;
+	});
+
+	measure("FixedSizeArray::operator[]", [&array, &indices]() {
+		std::uint64_t sum = 0;
+
+		for (size_t i = 0; i < indices.size(); ++i)
+			sum += array[indices[i]];
+
+		return sum;
+	});
+
+	measure("FixedSizeArray::at()", [&array, &indices]() {
+		std::uint64_t sum = 0;
+
+		for (size_t i = 0; i < indices.size(); ++i)
+			sum += array.at(indices[i]);
+
+		return sum;
+	});
+
+	return 0;
+}
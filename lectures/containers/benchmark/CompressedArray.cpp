@@ -0,0 +1,116 @@
+#include "containers/CompressedArray.h"
+#include "containers/DynamicArray.h"
+#include "utils/Stopwatch.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+/// A fixed-seed xorshift generator
+struct Random {
+	std::uint64_t state = 0x2545F4914F6CDD1Dull;
+
+	std::uint64_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+};
+
+double seconds(const Stopwatch& sw)
+{
+	return std::chrono::duration<double>(sw.elapsed()).count();
+}
+
+void measure(const char* title, const DynamicArray<int>& values)
+{
+	const size_t Rounds = 20;
+
+	CompressedArray<int> compressed(values);
+	size_t rawBytes = values.size() * sizeof(int);
+
+	std::cout << title << ": " << rawBytes / 1024 << " KiB raw, " << compressed.compressedBytes() / 1024
+		<< " KiB compressed, ratio " << double(rawBytes) / compressed.compressedBytes() << "\n";
+
+	Stopwatch sw;
+	long long sum = 0;
+
+	std::cout << "    DynamicArray, sum...";
+	sw.start();
+
+	for (size_t round = 0; round < Rounds; ++round) {
+		for (size_t i = 0; i < values.size(); ++i)
+			sum += values[i];
+	}
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << ", " << Rounds * rawBytes / seconds(sw) / 1e9 << " GB/s\n";
+
+	DynamicArray<int> decoded(CompressedArray<int>::BlockSize);
+	sum = 0;
+
+	std::cout << "    CompressedArray::decodeBlock()...";
+	sw.start();
+
+	for (size_t round = 0; round < Rounds; ++round) {
+		for (size_t block = 0; block < compressed.blockCount(); ++block) {
+			compressed.decodeBlock(block, decoded.data());
+			sum += decoded[block % CompressedArray<int>::BlockSize];
+		}
+	}
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << ", "
+		<< Rounds * compressed.blockCount() * CompressedArray<int>::BlockSize * sizeof(int) / seconds(sw) / 1e9 << " GB/s decoded\n";
+
+	sum = 0;
+
+	std::cout << "    CompressedArray::forEach(), sum...";
+	sw.start();
+
+	for (size_t round = 0; round < Rounds; ++round)
+		compressed.forEach([&](int value) { sum += value; });
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << ", " << Rounds * rawBytes / seconds(sw) / 1e9 << " GB/s\n";
+
+	const size_t Lookups = 1'000'000;
+	Random random;
+	sum = 0;
+
+	std::cout << "    CompressedArray, random lookups...";
+	sw.start();
+
+	for (size_t i = 0; i < Lookups; ++i)
+		sum += compressed[random.next() % values.size()];
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << ", "
+		<< std::chrono::duration_cast<std::chrono::nanoseconds>(sw.elapsed()).count() / Lookups << " ns per lookup\n\n";
+}
+
+int main()
+{
+	const size_t Size = 16 * 1024 * 1024;
+	Random random;
+
+	DynamicArray<int> timestamps(Size);
+	DynamicArray<int> sensor(Size);
+	DynamicArray<int> noise(Size);
+	int time = 0;
+
+	for (size_t i = 0; i < Size; ++i) {
+		time += int(random.next() % 32);
+		timestamps[i] = time;
+		sensor[i] = 20'000 + int(random.next() % 1000);
+		noise[i] = int(random.next());
+	}
+
+	measure("Sorted timestamps (delta)", timestamps);
+	measure("Sensor readings in a range of 1000 (frame of reference)", sensor);
+	measure("Random 32-bit values (incompressible)", noise);
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include "containers/ConcurrentArray.h"
+#include "containers/DynamicArray.h"
+#include "utils/Stopwatch.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Runs pushOne(i) for all i in [0, total), split evenly between threadsCount threads
+template <typename Function>
+void runInThreads(size_t threadsCount, size_t total, Function pushOne)
+{
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < threadsCount; ++t) {
+		threads.emplace_back([=]() {
+			for (size_t i = t; i < total; i += threadsCount)
+				pushOne(i);
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+int main()
+{
+	const size_t ElementsCount = 20'000'000;
+	const size_t threadCounts[] = { 1, 2, 4, 8 };
+
+	Stopwatch sw;
+
+	for (size_t threadsCount : threadCounts) {
+		std::cout << "Appending " << ElementsCount << " elements from " << threadsCount << " thread(s)\n";
+
+		//
+		// DynamicArray, guarded by a mutex
+		//
+		{
+			DynamicArray<size_t> arr;
+			std::mutex mutex;
+
+			std::cout << "    DynamicArray + std::mutex...";
+			sw.start();
+
+			runInThreads(threadsCount, ElementsCount, [&arr, &mutex](size_t i) {
+				std::lock_guard<std::mutex> lock(mutex);
+				arr.push_back(i);
+			});
+
+			sw.stop();
+			std::cout << "\n        execution took " << sw << "\n";
+		}
+
+		//
+		// ConcurrentArray
+		//
+		{
+			ConcurrentArray<size_t> arr;
+
+			std::cout << "    ConcurrentArray...";
+			sw.start();
+
+			runInThreads(threadsCount, ElementsCount, [&arr](size_t i) {
+				arr.push_back(i);
+			});
+
+			sw.stop();
+			std::cout << "\n        execution took " << sw << "\n";
+		}
+
+		std::cout << "\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+#include "containers/DynamicArray.h"
+#include "containers/HashMap.h"
+#include "utils/Stopwatch.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/// A fixed-seed xorshift generator, so both maps see the same keys
+struct Random {
+	std::uint64_t state = 0x2545F4914F6CDD1Dull;
+
+	std::uint64_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+};
+
+/// Inserts count keys into a map with a fixed number of slots, then looks up
+/// every key and as many missing keys
+template <typename Map>
+void measure(const char* title, size_t slots, double loadFactor)
+{
+	size_t count = static_cast<size_t>(slots * loadFactor);
+
+	DynamicArray<std::uint64_t> keys;
+	keys.reserve(count);
+	Random random;
+
+	for (size_t i = 0; i < count; ++i)
+		keys.push_back(random.next());
+
+	Stopwatch sw;
+	Map map;
+	map.reserve(count);
+
+	std::cout << "    " << title << ", load factor " << loadFactor << ", insert...";
+	sw.start();
+
+	for (size_t i = 0; i < count; ++i)
+		map[keys[i]] = i;
+
+	sw.stop();
+	std::cout << " (size " << map.size() << ")\n        execution took " << sw << "\n";
+
+	std::cout << "    " << title << ", load factor " << loadFactor << ", successful lookup...";
+	std::uint64_t sum = 0;
+	sw.start();
+
+	for (size_t i = 0; i < count; ++i)
+		sum += map.find(keys[i]) != nullptr;
+
+	sw.stop();
+	std::cout << " (found " << sum << ")\n        execution took " << sw << "\n";
+
+	std::cout << "    " << title << ", load factor " << loadFactor << ", failed lookup...";
+	sum = 0;
+	sw.start();
+
+	for (size_t i = 0; i < count; ++i)
+		sum += map.find(random.next()) != nullptr;
+
+	sw.stop();
+	std::cout << " (found " << sum << ")\n        execution took " << sw << "\n\n";
+}
+
+/// std::unordered_map with the same find() interface as HashMap
+struct StdMap : std::unordered_map<std::uint64_t, std::uint64_t> {
+	const std::uint64_t* find(std::uint64_t key) const
+	{
+		auto it = std::unordered_map<std::uint64_t, std::uint64_t>::find(key);
+		return it != end() ? &it->second : nullptr;
+	}
+};
+
+/// Builds a symbol table of short identifiers and looks them up through string views
+void measureSymbols()
+{
+	const size_t SymbolsCount = 200'000;
+	const int Repetitions = 20;
+
+	DynamicArray<std::string> names;
+	names.reserve(SymbolsCount);
+
+	for (size_t i = 0; i < SymbolsCount; ++i)
+		names.push_back("symbol_" + std::to_string(i * 7919));
+
+	Stopwatch sw;
+
+	{
+		std::unordered_map<std::string, size_t> symbols;
+
+		for (size_t i = 0; i < SymbolsCount; ++i)
+			symbols[names[i]] = i;
+
+		std::cout << "    std::unordered_map<std::string, size_t> symbol lookup...";
+		size_t sum = 0;
+		sw.start();
+
+		// Without heterogeneous lookup, every view has to be copied into a string
+		for (int r = 0; r < Repetitions; ++r)
+			for (size_t i = 0; i < SymbolsCount; ++i)
+				sum += symbols.find(std::string(std::string_view(names[i])))->second;
+
+		sw.stop();
+		std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n";
+	}
+
+	{
+		HashMap<std::string, size_t, TransparentStringHash, std::equal_to<>> symbols;
+
+		for (size_t i = 0; i < SymbolsCount; ++i)
+			symbols[names[i]] = i;
+
+		std::cout << "    HashMap<std::string, size_t> symbol lookup...";
+		size_t sum = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			for (size_t i = 0; i < SymbolsCount; ++i)
+				sum += *symbols.find(std::string_view(names[i]));
+
+		sw.stop();
+		std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n\n";
+	}
+}
+
+int main()
+{
+	const size_t Slots = size_t(1) << 22;
+
+	for (double loadFactor : { 0.25, 0.5, 0.75, 0.875 }) {
+		std::cout << "Load factor " << loadFactor << " of " << Slots << " slots\n";
+		measure<StdMap>("std::unordered_map", Slots, loadFactor);
+		measure<HashMap<std::uint64_t, std::uint64_t>>("HashMap", Slots, loadFactor);
+	}
+
+	std::cout << "Symbol table\n";
+	measureSymbols();
+
+	return 0;
+}
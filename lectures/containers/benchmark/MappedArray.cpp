@@ -0,0 +1,106 @@
+#include "containers/FixedSizeArray.h"
+#include "containers/MappedArray.h"
+#include "utils/Stopwatch.h"
+
+#include <filesystem>
+#include <string>
+
+///
+/// Compares initializing an array in memory, the way array-walking does,
+/// with loading the same data from a memory-mapped file.
+///
+/// Usage: benchmark-mapped-array [path [elements-count]]
+///
+/// If a path is given, the file is kept, so running the benchmark again
+/// shows how quickly an existing array is loaded. Otherwise a temporary
+/// file is used and removed at the end.
+///
+int main(int argc, char* argv[])
+{
+	const bool keepFile = (argc > 1);
+	const std::string path = keepFile ? argv[1] : (std::filesystem::temp_directory_path() / "benchmark-mapped-array.bin").string();
+	const size_t ElementsCount = (argc > 2) ? std::stoull(argv[2]) : 250'000'000;
+
+	Stopwatch sw;
+	unsigned long long sum;
+
+	//
+	// Allocate and initialize the array in memory
+	//
+	{
+		std::cout << "Initializing a FixedSizeArray of " << ElementsCount << " elements...";
+		sw.start();
+
+		FixedSizeArray<int> arr(ElementsCount);
+
+		for (size_t i = 0; i < ElementsCount; ++i)
+			arr[i] = static_cast<int>(i % 1000);
+
+		sw.stop();
+		std::cout << "\n    execution took " << sw << "\n\n";
+
+		std::cout << "Summing the FixedSizeArray...";
+		sum = 0;
+		sw.start();
+
+		for (size_t i = 0; i < ElementsCount; ++i)
+			sum += arr[i];
+
+		sw.stop();
+		std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+	}
+
+	//
+	// Create the file, unless it was kept from a previous run
+	//
+	std::error_code error;
+
+	if (std::filesystem::file_size(path, error) != ElementsCount * sizeof(int)) {
+		std::cout << "Creating and initializing " << path << "...";
+		sw.start();
+
+		MappedArray<int> arr(path, ElementsCount);
+		arr.advise(AccessPattern::Sequential);
+
+		for (size_t i = 0; i < ElementsCount; ++i)
+			arr[i] = static_cast<int>(i % 1000);
+
+		arr.flush();
+
+		sw.stop();
+		std::cout << "\n    execution took " << sw << "\n\n";
+	}
+	else {
+		std::cout << "Reusing " << path << " from a previous run\n\n";
+	}
+
+	//
+	// Load the array from the file
+	//
+	{
+		std::cout << "Opening the MappedArray...";
+		sw.start();
+
+		MappedArray<int> arr(path);
+
+		sw.stop();
+		std::cout << "\n    execution took " << sw << "\n\n";
+
+		std::cout << "Summing the MappedArray sequentially...";
+		sum = 0;
+		sw.start();
+
+		arr.advise(AccessPattern::Sequential);
+
+		for (size_t i = 0; i < arr.size(); ++i)
+			sum += arr[i];
+
+		sw.stop();
+		std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+	}
+
+	if ( ! keepFile)
+		std::filesystem::remove(path);
+
+	return 0;
+}
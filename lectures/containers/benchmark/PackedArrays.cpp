@@ -0,0 +1,153 @@
+#include "containers/BitArray.h"
+#include "containers/FixedSizeArray.h"
+#include "containers/PackedIntArray.h"
+#include "utils/Stopwatch.h"
+
+#include <cstdint>
+#include <iostream>
+
+/// Size in MiB of count objects of the given size
+double mebibytes(size_t count, size_t objectSize)
+{
+	return static_cast<double>(count) * objectSize / (1024 * 1024);
+}
+
+int main()
+{
+	const size_t BitsCount = 200'000'000;
+	const size_t ValuesCount = 100'000'000;
+	const int Repetitions = 5;
+
+	Stopwatch sw;
+
+	//
+	// Booleans
+	//
+	{
+		FixedSizeArray<bool> a(BitsCount);
+		FixedSizeArray<bool> b(BitsCount);
+
+		for (size_t i = 0; i < BitsCount; ++i) {
+			a[i] = i % 3 == 0;
+			b[i] = i % 5 == 0;
+		}
+
+		std::cout << "Counting the true values in FixedSizeArray<bool> (" << mebibytes(BitsCount, sizeof(bool)) << " MiB)...";
+		size_t total = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			for (size_t i = 0; i < BitsCount; ++i)
+				total += a[i];
+
+		sw.stop();
+		std::cout << " (count " << total << ")\n    execution took " << sw << "\n";
+
+		std::cout << "And-ing two FixedSizeArray<bool>...";
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			for (size_t i = 0; i < BitsCount; ++i)
+				a[i] = a[i] & b[i];
+
+		sw.stop();
+		total = 0;
+
+		for (size_t i = 0; i < BitsCount; ++i)
+			total += a[i];
+
+		std::cout << " (count " << total << ")\n    execution took " << sw << "\n\n";
+	}
+
+	{
+		BitArray a(BitsCount);
+		BitArray b(BitsCount);
+
+		for (size_t i = 0; i < BitsCount; ++i) {
+			a[i] = i % 3 == 0;
+			b[i] = i % 5 == 0;
+		}
+
+		std::cout << "Counting the set bits in BitArray (" << mebibytes(a.wordCount(), sizeof(std::uint64_t)) << " MiB)...";
+		size_t total = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			total += a.count();
+
+		sw.stop();
+		std::cout << " (count " << total << ")\n    execution took " << sw << "\n";
+
+		std::cout << "And-ing two BitArrays...";
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			a &= b;
+
+		sw.stop();
+		std::cout << " (count " << a.count() << ")\n    execution took " << sw << "\n";
+
+		RankSelectIndex index(a);
+		std::cout << "Selecting every 1000th set bit with a RankSelectIndex...";
+		size_t sum = 0;
+		size_t ones = a.count();
+		sw.start();
+
+		for (size_t r = 0; r < ones; r += 1000)
+			sum += index.select(r);
+
+		sw.stop();
+		std::cout << " (sum " << sum << ")\n    execution took " << sw << "\n\n";
+	}
+
+	//
+	// Small integers in the range [0, 16)
+	//
+	{
+		FixedSizeArray<int> values(ValuesCount);
+
+		for (size_t i = 0; i < ValuesCount; ++i)
+			values[i] = static_cast<int>(i % 16);
+
+		std::cout << "Summing FixedSizeArray<int> (" << mebibytes(ValuesCount, sizeof(int)) << " MiB)...";
+		std::uint64_t total = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			for (size_t i = 0; i < ValuesCount; ++i)
+				total += values[i];
+
+		sw.stop();
+		std::cout << " (sum " << total << ")\n    execution took " << sw << "\n\n";
+	}
+
+	{
+		PackedIntArray<4> values(ValuesCount);
+
+		for (size_t i = 0; i < ValuesCount; ++i)
+			values[i] = static_cast<std::uint8_t>(i % 16);
+
+		std::cout << "Summing PackedIntArray<4> (" << mebibytes(values.wordCount(), sizeof(std::uint64_t)) << " MiB)...";
+		std::uint64_t total = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			for (size_t i = 0; i < ValuesCount; ++i)
+				total += values[i];
+
+		sw.stop();
+		std::cout << " (sum " << total << ")\n    execution took " << sw << "\n";
+
+		std::cout << "Summing PackedIntArray<4> with forEach()...";
+		total = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r)
+			values.forEach([&total](std::uint8_t value) { total += value; });
+
+		sw.stop();
+		std::cout << " (sum " << total << ")\n    execution took " << sw << "\n\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+#include "containers/DynamicArray.h"
+#include "containers/PersistentVector.h"
+#include "utils/Stopwatch.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+// The global operator new and delete are replaced to measure the memory held by the versions.
+// Each allocation is prefixed with its size.
+static size_t g_allocatedBytes = 0;
+
+void* operator new(size_t bytes)
+{
+	void* memory = std::malloc(bytes + alignof(std::max_align_t));
+
+	if ( ! memory)
+		throw std::bad_alloc();
+
+	*static_cast<size_t*>(memory) = bytes;
+	g_allocatedBytes += bytes;
+	return static_cast<char*>(memory) + alignof(std::max_align_t);
+}
+
+void operator delete(void* p) noexcept
+{
+	if ( ! p)
+		return;
+
+	void* memory = static_cast<char*>(p) - alignof(std::max_align_t);
+	g_allocatedBytes -= *static_cast<size_t*>(memory);
+	std::free(memory);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	operator delete(p);
+}
+
+/// A fixed-seed xorshift generator, so both variants update the same indices
+struct Random {
+	std::uint64_t state = 0x2545F4914F6CDD1Dull;
+
+	std::uint64_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+};
+
+void report(const Stopwatch& sw, size_t operations, size_t bytesBefore)
+{
+	std::cout << "        execution took " << sw << ", "
+		<< std::chrono::duration_cast<std::chrono::nanoseconds>(sw.elapsed()).count() / operations << " ns per version, "
+		<< (g_allocatedBytes - bytesBefore) / 1024 << " KiB for all versions\n";
+}
+
+/// Creates each version from the previous one by changing a random element. Keeps all versions.
+void updateDynamicArray(size_t size, size_t versions)
+{
+	size_t bytesBefore = g_allocatedBytes;
+	std::vector<DynamicArray<int>> history;
+	history.reserve(versions + 1);
+	history.emplace_back(size);
+
+	for (size_t i = 0; i < size; ++i)
+		history.back()[i] = int(i);
+
+	Random random;
+	Stopwatch sw;
+
+	std::cout << "    DynamicArray, a full copy per version...";
+	sw.start();
+
+	for (size_t version = 0; version < versions; ++version) {
+		history.push_back(history.back());
+		history.back()[random.next() % size] = int(version);
+	}
+
+	sw.stop();
+	std::cout << " (last " << history.back()[size / 2] << ")\n";
+	report(sw, versions, bytesBefore);
+}
+
+/// Creates each version from the previous one by changing a random element. Keeps all versions.
+void updatePersistentVector(size_t size, size_t versions)
+{
+	size_t bytesBefore = g_allocatedBytes;
+	std::vector<PersistentVector<int>> history;
+	history.reserve(versions + 1);
+
+	PersistentVector<int>::Transient builder;
+
+	for (size_t i = 0; i < size; ++i)
+		builder.push_back(int(i));
+
+	history.push_back(builder.persistent());
+
+	Random random;
+	Stopwatch sw;
+
+	std::cout << "    PersistentVector, structural sharing...";
+	sw.start();
+
+	for (size_t version = 0; version < versions; ++version)
+		history.push_back(history.back().set(random.next() % size, int(version)));
+
+	sw.stop();
+	std::cout << " (last " << history.back()[size / 2] << ")\n";
+	report(sw, versions, bytesBefore);
+}
+
+template <typename Function>
+void measure(const char* title, Function function)
+{
+	Stopwatch sw;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+	long long sum = function();
+	sw.stop();
+
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n";
+}
+
+int main()
+{
+	const size_t Versions = 200;
+
+	for (size_t size : { size_t(1'000), size_t(100'000) }) {
+		std::cout << Versions << " versions of an array of " << size << " ints, each with one element changed\n";
+		updateDynamicArray(size, Versions);
+		updatePersistentVector(size, Versions);
+		std::cout << "\n";
+	}
+
+	const size_t Size = 1'000'000;
+	std::cout << "Build an array of " << Size << " ints and sum it\n";
+
+	measure("DynamicArray::push_back()", [=]() {
+		DynamicArray<int> array;
+
+		for (size_t i = 0; i < Size; ++i)
+			array.push_back(int(i));
+
+		long long sum = 0;
+
+		for (size_t i = 0; i < array.size(); ++i)
+			sum += array[i];
+
+		return sum;
+	});
+
+	measure("PersistentVector::push_back(), a version per element", [=]() {
+		PersistentVector<int> vector;
+
+		for (size_t i = 0; i < Size; ++i)
+			vector = vector.push_back(int(i));
+
+		long long sum = 0;
+		vector.forEach([&](int value) { sum += value; });
+		return sum;
+	});
+
+	measure("PersistentVector::Transient::push_back()", [=]() {
+		PersistentVector<int>::Transient transient;
+
+		for (size_t i = 0; i < Size; ++i)
+			transient.push_back(int(i));
+
+		PersistentVector<int> vector = transient.persistent();
+		long long sum = 0;
+		vector.forEach([&](int value) { sum += value; });
+		return sum;
+	});
+
+	return 0;
+}
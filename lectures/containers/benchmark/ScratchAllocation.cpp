@@ -0,0 +1,188 @@
+#include "containers/Allocation.h"
+#include "containers/DynamicArray.h"
+#include "utils/Arena.h"
+#include "utils/ObjectPool.h"
+#include "utils/Stopwatch.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// A fixed-seed xorshift generator, so every variant evaluates the same expressions
+struct Random {
+	std::uint64_t state = 0x2545F4914F6CDD1Dull;
+
+	std::uint64_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+};
+
+struct Token {
+	/// One of + - * ( ) or 0 for a number
+	char op = 0;
+	double value = 0;
+};
+
+/// Appends a random expression with the given number of operands, e.g. "3 * (2 + 7) - 1"
+void generateExpression(Random& random, size_t operands, std::string& text)
+{
+	static const char Operators[] = "+-*";
+	size_t openParentheses = 0;
+
+	for (size_t i = 0; i < operands; ++i) {
+		if (random.next() % 4 == 0 && i + 1 < operands) {
+			text += '(';
+			++openParentheses;
+		}
+
+		text += char('1' + random.next() % 9);
+
+		if (openParentheses && random.next() % 3 == 0) {
+			text += ')';
+			--openParentheses;
+		}
+
+		if (i + 1 < operands) {
+			text += ' ';
+			text += Operators[random.next() % 3];
+			text += ' ';
+		}
+	}
+
+	text.append(openParentheses, ')');
+}
+
+int precedence(char op)
+{
+	return op == '*' ? 2 : (op == '+' || op == '-') ? 1 : 0;
+}
+
+///
+/// Tokenizes the expression, converts it to postfix with the shunting-yard
+/// algorithm and evaluates it. Every intermediate array obtains its memory
+/// from allocation, which is what the benchmark measures.
+///
+template <typename Allocation>
+double evaluate(const std::string& text, const Allocation& allocation)
+{
+	DynamicArray<Token, Allocation> tokens(allocation);
+
+	for (char c : text) {
+		if (c >= '0' && c <= '9')
+			tokens.push_back(Token{ 0, double(c - '0') });
+		else if (c != ' ')
+			tokens.push_back(Token{ c, 0 });
+	}
+
+	DynamicArray<Token, Allocation> postfix(allocation);
+	DynamicArray<char, Allocation> operators(allocation);
+
+	for (size_t i = 0; i < tokens.size(); ++i) {
+		const Token& token = tokens[i];
+
+		if (token.op == 0) {
+			postfix.push_back(token);
+		}
+		else if (token.op == '(') {
+			operators.push_back('(');
+		}
+		else if (token.op == ')') {
+			while (operators[operators.size() - 1] != '(') {
+				postfix.push_back(Token{ operators[operators.size() - 1], 0 });
+				operators.pop_back();
+			}
+
+			operators.pop_back();
+		}
+		else {
+			while (operators.size() && precedence(operators[operators.size() - 1]) >= precedence(token.op)) {
+				postfix.push_back(Token{ operators[operators.size() - 1], 0 });
+				operators.pop_back();
+			}
+
+			operators.push_back(token.op);
+		}
+	}
+
+	while (operators.size()) {
+		postfix.push_back(Token{ operators[operators.size() - 1], 0 });
+		operators.pop_back();
+	}
+
+	DynamicArray<double, Allocation> stack(allocation);
+
+	for (size_t i = 0; i < postfix.size(); ++i) {
+		const Token& token = postfix[i];
+
+		if (token.op == 0) {
+			stack.push_back(token.value);
+			continue;
+		}
+
+		double right = stack[stack.size() - 1];
+		stack.pop_back();
+		double& left = stack[stack.size() - 1];
+
+		switch (token.op) {
+		case '+': left += right; break;
+		case '-': left -= right; break;
+		case '*': left *= right; break;
+		}
+	}
+
+	return stack[0];
+}
+
+/// Evaluates every expression the given number of times.
+/// reset is called after each evaluation, which is where an arena reclaims its memory.
+template <typename Allocation, typename Reset>
+void measure(const char* title, const std::vector<std::string>& expressions, size_t rounds, const Allocation& allocation, Reset reset)
+{
+	Stopwatch sw;
+	double sum = 0;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+
+	for (size_t round = 0; round < rounds; ++round) {
+		for (const std::string& text : expressions) {
+			sum += evaluate(text, allocation);
+			reset();
+		}
+	}
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n";
+}
+
+int main()
+{
+	const size_t Rounds = 200;
+
+	for (size_t operands : { size_t(4), size_t(16), size_t(64) }) {
+		Random random;
+		std::vector<std::string> expressions(1000);
+
+		for (std::string& text : expressions)
+			generateExpression(random, operands, text);
+
+		std::cout << "Parse and evaluate " << expressions.size() << " expressions with " << operands << " operands, " << Rounds << " rounds\n";
+
+		measure("General heap (DefaultAllocation)", expressions, Rounds, DefaultAllocation(), []() {});
+
+		Arena arena;
+		measure("Arena, reset after each expression", expressions, Rounds, MemoryResourceAllocation(&arena), [&]() { arena.reset(); });
+
+		ObjectPool pool(256);
+		measure("ObjectPool with 256-byte blocks", expressions, Rounds, MemoryResourceAllocation(&pool), []() {});
+
+		std::cout << "\n";
+	}
+
+	return 0;
+}
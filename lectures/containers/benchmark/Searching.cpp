@@ -0,0 +1,73 @@
+#include "containers/FixedSizeArray.h"
+#include "containers/Searching.h"
+#include "utils/Stopwatch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+/// Looks up the same pseudo-random keys with each search and reports the times
+void measure(size_t tableSize, size_t lookups)
+{
+	FixedSizeArray<std::uint32_t> sorted(tableSize);
+
+	for (size_t i = 0; i < tableSize; ++i)
+		sorted[i] = static_cast<std::uint32_t>(2 * i);
+
+	FixedSizeArray<std::uint32_t> keys(lookups);
+	std::uint64_t state = 0x2545F4914F6CDD1Dull;
+
+	for (size_t i = 0; i < lookups; ++i) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		// Not greater than the largest element, so every search finds one
+		keys[i] = static_cast<std::uint32_t>(state % (2 * tableSize - 1));
+	}
+
+	EytzingerArray<std::uint32_t> table(sorted);
+	Stopwatch sw;
+	std::uint64_t sum;
+
+	std::cout << "Table of " << tableSize << " elements, " << lookups << " lookups\n";
+
+	std::cout << "    std::lower_bound...";
+	sum = 0;
+	sw.start();
+
+	for (size_t i = 0; i < lookups; ++i)
+		sum += *std::lower_bound(sorted.data(), sorted.data() + tableSize, keys[i]);
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n";
+
+	std::cout << "    branchlessLowerBound...";
+	sum = 0;
+	sw.start();
+
+	for (size_t i = 0; i < lookups; ++i)
+		sum += sorted[branchlessLowerBound(sorted, keys[i])];
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n";
+
+	std::cout << "    EytzingerArray::lowerBound...";
+	sum = 0;
+	sw.start();
+
+	for (size_t i = 0; i < lookups; ++i)
+		sum += *table.lowerBound(keys[i]);
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n\n";
+}
+
+int main()
+{
+	const size_t Lookups = 10'000'000;
+
+	for (size_t tableSize : { 1'000, 100'000, 10'000'000 })
+		measure(tableSize, Lookups);
+
+	return 0;
+}
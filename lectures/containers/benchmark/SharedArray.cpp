@@ -0,0 +1,101 @@
+#include "containers/DynamicArray.h"
+#include "containers/SharedArray.h"
+#include "utils/Stopwatch.h"
+
+#include <iostream>
+#include <vector>
+
+/// A component, which receives the array by value and reads a few elements.
+/// Every modifyEvery-th component also changes an element of its copy.
+template <typename Array>
+double component(Array values, size_t id, size_t modifyEvery)
+{
+	if (id % modifyEvery == 0)
+		values[id % values.size()] += 1;
+
+	const Array& readOnly = values;
+	double sum = 0;
+
+	for (size_t i = id % 64; i < readOnly.size(); i += readOnly.size() / 16)
+		sum += readOnly[i];
+
+	return sum;
+}
+
+/// Passes the array to the given number of components
+template <typename Array>
+void passToComponents(const char* title, const Array& values, size_t components, size_t modifyEvery)
+{
+	Stopwatch sw;
+	double sum = 0;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+
+	for (size_t id = 0; id < components; ++id)
+		sum += component(values, id, modifyEvery);
+
+	sw.stop();
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n";
+}
+
+/// Takes a snapshot of the array before every snapshotEvery-th edit and keeps the
+/// most recent HistoryLength of them, e.g. as an undo history
+template <typename Array>
+void keepHistory(const char* title, Array values, size_t edits, size_t snapshotEvery)
+{
+	const size_t HistoryLength = 16;
+
+	Stopwatch sw;
+	std::vector<Array> history(HistoryLength);
+	size_t snapshots = 0;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+
+	for (size_t edit = 0; edit < edits; ++edit) {
+		if (edit % snapshotEvery == 0)
+			history[snapshots++ % HistoryLength] = values;
+
+		values[edit % values.size()] = double(edit);
+	}
+
+	sw.stop();
+	std::cout << " (" << snapshots << " snapshots)\n        execution took " << sw << "\n";
+}
+
+int main()
+{
+	const size_t Size = 1'000'000;
+	const size_t Components = 1000;
+
+	DynamicArray<double> dynamic(Size);
+	SharedArray<double> shared(Size);
+
+	for (size_t i = 0; i < Size; ++i) {
+		dynamic[i] = double(i);
+		shared[i] = double(i);
+	}
+
+	for (size_t modifyEvery : { size_t(1'000'000), size_t(100), size_t(10) }) {
+		std::cout << "Pass an array of " << Size << " doubles to " << Components << " components, every " << modifyEvery << "th modifies its copy\n";
+		passToComponents("DynamicArray (deep copy)", dynamic, Components, modifyEvery);
+		passToComponents("SharedArray (copy on write)", shared, Components, modifyEvery);
+		std::cout << "\n";
+	}
+
+	const size_t HistorySize = 100'000;
+	const size_t Edits = 100'000;
+
+	DynamicArray<double> document(HistorySize);
+	SharedArray<double> sharedDocument(HistorySize);
+
+	for (size_t snapshotEvery : { size_t(1000), size_t(100), size_t(10) }) {
+		std::cout << "Make " << Edits << " edits to " << HistorySize << " doubles, with a snapshot before every " << snapshotEvery << "th\n";
+		keepHistory("DynamicArray (deep copy)", document, Edits, snapshotEvery);
+		keepHistory("SharedArray (copy on write)", sharedDocument, Edits, snapshotEvery);
+		std::cout << "\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+#include "containers/DynamicArray.h"
+#include "containers/Sorting.h"
+#include "utils/Stopwatch.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/// The order of the input
+enum class Distribution { Random, FewUnique, Sorted, Reversed };
+
+const char* nameOf(Distribution distribution)
+{
+	switch (distribution) {
+		case Distribution::Random: return "random";
+		case Distribution::FewUnique: return "few unique";
+		case Distribution::Sorted: return "sorted";
+		case Distribution::Reversed: return "reversed";
+	}
+
+	return "";
+}
+
+FixedSizeArray<std::uint32_t> makeInput(size_t size, Distribution distribution)
+{
+	FixedSizeArray<std::uint32_t> result(size);
+	std::uint64_t state = 0x2545F4914F6CDD1Dull;
+
+	for (size_t i = 0; i < size; ++i) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		switch (distribution) {
+			case Distribution::Random: result[i] = static_cast<std::uint32_t>(state); break;
+			case Distribution::FewUnique: result[i] = static_cast<std::uint32_t>(state % 16); break;
+			case Distribution::Sorted: result[i] = static_cast<std::uint32_t>(i); break;
+			case Distribution::Reversed: result[i] = static_cast<std::uint32_t>(size - i); break;
+		}
+	}
+
+	return result;
+}
+
+/// Sorts a copy of input and reports the time
+template <typename Sort>
+void measure(const char* title, const FixedSizeArray<std::uint32_t>& input, Sort sort)
+{
+	FixedSizeArray<std::uint32_t> arr(input);
+	Stopwatch sw;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+	sort(arr);
+	sw.stop();
+
+	bool sorted = std::is_sorted(arr.data(), arr.data() + arr.size());
+	std::cout << (sorted ? "" : " NOT SORTED") << "\n        execution took " << sw << "\n";
+}
+
+int main()
+{
+	// Powers of two up to the number of cores, but at least up to 4
+	unsigned maxThreads = std::max(4u, ThreadPool::defaultThreadCount());
+
+	for (size_t size : { 100'000, 10'000'000 }) {
+		for (Distribution distribution : { Distribution::Random, Distribution::FewUnique, Distribution::Sorted, Distribution::Reversed }) {
+			std::cout << size << " elements, " << nameOf(distribution) << "\n";
+			FixedSizeArray<std::uint32_t> input = makeInput(size, distribution);
+
+			measure("std::sort", input, [](auto& arr) { std::sort(arr.data(), arr.data() + arr.size()); });
+			measure("introSort", input, [](auto& arr) { introSort(arr); });
+			measure("radixSort", input, [](auto& arr) { radixSort(arr); });
+
+			for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+				ThreadPool pool(threads);
+				std::string title = "parallelMergeSort, " + std::to_string(threads) + " worker threads";
+				measure(title.c_str(), input, [&pool](auto& arr) { parallelMergeSort(arr, std::less<>(), pool); });
+			}
+
+			std::cout << "\n";
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,174 @@
+#include "containers/DynamicArray.h"
+#include "containers/GapBuffer.h"
+#include "containers/SparseArray.h"
+#include "utils/Stopwatch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/// A fixed-seed xorshift generator, so every variant sees the same data
+struct Random {
+	std::uint64_t state = 0x2545F4914F6CDD1Dull;
+
+	std::uint64_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+};
+
+template <typename Function>
+void measure(const char* title, Function function)
+{
+	Stopwatch sw;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+	long long sum = function();
+	sw.stop();
+
+	std::cout << " (sum " << sum << ")\n        execution took " << sw << "\n";
+}
+
+/// A mostly-zero dataset: runs of runLength non-zero values, one run per period elements
+void sparseScan(size_t size, size_t period, size_t runLength)
+{
+	DynamicArray<double> dense(size);
+	SparseArray<double> sparse(size);
+
+	for (size_t i = 0; i < size; ++i) {
+		dense[i] = i % period < runLength ? double(i % 7 + 1) : 0.0;
+
+		if (dense[i] != 0.0)
+			sparse.set(i, dense[i]);
+	}
+
+	std::cout << "Sum " << size << " doubles with " << runLength << " non-zero values in every " << period << ": "
+		<< size * sizeof(double) / 1024 << " KiB dense, "
+		<< sparse.storedCount() * sizeof(double) / 1024 << " KiB sparse in " << sparse.runCount() << " runs\n";
+
+	measure("DynamicArray, every element", [&]() {
+		double sum = 0;
+
+		for (size_t i = 0; i < dense.size(); ++i)
+			sum += dense[i];
+
+		return (long long)sum;
+	});
+
+	measure("SparseArray::forEachRun()", [&]() {
+		double sum = 0;
+
+		sparse.forEachRun([&](size_t, const double* values, size_t count) {
+			for (size_t i = 0; i < count; ++i)
+				sum += values[i];
+		});
+
+		return (long long)sum;
+	});
+
+	const size_t Lookups = 1'000'000;
+
+	measure("DynamicArray, random lookups", [&]() {
+		Random random;
+		double sum = 0;
+
+		for (size_t i = 0; i < Lookups; ++i)
+			sum += dense[random.next() % size];
+
+		return (long long)sum;
+	});
+
+	measure("SparseArray, random lookups", [&]() {
+		Random random;
+		double sum = 0;
+
+		for (size_t i = 0; i < Lookups; ++i)
+			sum += sparse[random.next() % size];
+
+		return (long long)sum;
+	});
+}
+
+/// Inserts into a DynamicArray, which has no insert(), by appending and rotating the tail
+void insertShifting(DynamicArray<char>& arr, size_t index, char value)
+{
+	arr.push_back(value);
+	std::rotate(arr.data() + index, arr.data() + arr.size() - 1, arr.data() + arr.size());
+}
+
+/// Edits a text of the given size like a user would: a few keystrokes at a time at a random position
+void editText(size_t size, size_t edits, size_t burst)
+{
+	std::cout << "\n" << edits << " bursts of " << burst << " insertions at random positions of a " << size << "-character text\n";
+
+	measure("DynamicArray, shifting the tail", [&]() {
+		DynamicArray<char> text;
+
+		for (size_t i = 0; i < size; ++i)
+			text.push_back('a' + i % 26);
+
+		Random random;
+
+		for (size_t edit = 0; edit < edits; ++edit) {
+			size_t position = random.next() % text.size();
+
+			for (size_t i = 0; i < burst; ++i)
+				insertShifting(text, position + i, 'x');
+		}
+
+		return (long long)text.size();
+	});
+
+	measure("std::vector::insert()", [&]() {
+		std::vector<char> text;
+
+		for (size_t i = 0; i < size; ++i)
+			text.push_back('a' + i % 26);
+
+		Random random;
+
+		for (size_t edit = 0; edit < edits; ++edit) {
+			size_t position = random.next() % text.size();
+
+			for (size_t i = 0; i < burst; ++i)
+				text.insert(text.begin() + position + i, 'x');
+		}
+
+		return (long long)text.size();
+	});
+
+	measure("GapBuffer::insert() at the cursor", [&]() {
+		GapBuffer<char> text;
+
+		for (size_t i = 0; i < size; ++i)
+			text.push_back('a' + i % 26);
+
+		Random random;
+
+		for (size_t edit = 0; edit < edits; ++edit) {
+			text.moveCursor(random.next() % text.size());
+
+			for (size_t i = 0; i < burst; ++i)
+				text.insert('x');
+		}
+
+		return (long long)text.size();
+	});
+}
+
+int main()
+{
+	sparseScan(10'000'000, 1000, 10);
+	std::cout << "\n";
+	sparseScan(10'000'000, 100, 50);
+
+	editText(1'000'000, 1000, 50);
+	editText(100'000, 100, 1000);
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include "containers/ArrayQueue.h"
+#include "containers/ArrayStack.h"
+#include "utils/Stopwatch.h"
+
+#include <queue>
+#include <stack>
+
+/// Pushes count elements, then pops all of them. Repeated for the given number of rounds.
+template <typename Stack>
+size_t fillAndDrainStack(size_t rounds, size_t count)
+{
+	Stack stack;
+	size_t checksum = 0;
+
+	for (size_t round = 0; round < rounds; ++round) {
+		for (size_t i = 0; i < count; ++i)
+			stack.push(i);
+
+		while ( ! stack.empty()) {
+			checksum += stack.top();
+			stack.pop();
+		}
+	}
+
+	return checksum;
+}
+
+/// Pushes count elements, then pops all of them. Repeated for the given number of rounds.
+template <typename Queue>
+size_t fillAndDrainQueue(size_t rounds, size_t count)
+{
+	Queue queue;
+	size_t checksum = 0;
+
+	for (size_t round = 0; round < rounds; ++round) {
+		for (size_t i = 0; i < count; ++i)
+			queue.push(i);
+
+		while ( ! queue.empty()) {
+			checksum += queue.front();
+			queue.pop();
+		}
+	}
+
+	return checksum;
+}
+
+/// Keeps the queue at a steady size, so that the elements continuously wrap around the ring
+template <typename Queue>
+size_t slidingWindow(size_t window, size_t total)
+{
+	Queue queue;
+	size_t checksum = 0;
+
+	for (size_t i = 0; i < window; ++i)
+		queue.push(i);
+
+	for (size_t i = window; i < total; ++i) {
+		checksum += queue.front();
+		queue.pop();
+		queue.push(i);
+	}
+
+	return checksum;
+}
+
+template <typename Function>
+void measure(const char* title, Function function)
+{
+	Stopwatch sw;
+
+	std::cout << "    " << title << "...";
+	sw.start();
+	size_t checksum = function();
+	sw.stop();
+
+	std::cout << " (checksum " << checksum << ")\n        execution took " << sw << "\n";
+}
+
+int main()
+{
+	const size_t Rounds = 100;
+	const size_t Count = 1'000'000;
+	const size_t Window = 1000;
+	const size_t Total = 100'000'000;
+
+	std::cout << "Stack: " << Rounds << " rounds of " << Count << " pushes and pops\n";
+	measure("std::stack<size_t> (std::deque)", [=]() { return fillAndDrainStack<std::stack<size_t>>(Rounds, Count); });
+	measure("ArrayStack<size_t>", [=]() { return fillAndDrainStack<ArrayStack<size_t>>(Rounds, Count); });
+
+	std::cout << "\nQueue: " << Rounds << " rounds of " << Count << " pushes and pops\n";
+	measure("std::queue<size_t> (std::deque)", [=]() { return fillAndDrainQueue<std::queue<size_t>>(Rounds, Count); });
+	measure("ArrayQueue<size_t>", [=]() { return fillAndDrainQueue<ArrayQueue<size_t>>(Rounds, Count); });
+
+	std::cout << "\nQueue: sliding window of " << Window << " elements over " << Total << " elements\n";
+	measure("std::queue<size_t> (std::deque)", [=]() { return slidingWindow<std::queue<size_t>>(Window, Total); });
+	measure("ArrayQueue<size_t>", [=]() { return slidingWindow<ArrayQueue<size_t>>(Window, Total); });
+
+	return 0;
+}
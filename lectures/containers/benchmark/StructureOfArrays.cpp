@@ -0,0 +1,79 @@
+#include "containers/DynamicArray.h"
+#include "containers/SoAArray.h"
+#include "utils/Stopwatch.h"
+
+/// A record with several fields, of which a scan needs only one
+struct Particle {
+	double x, y, z;
+	double vx, vy, vz;
+	float mass;
+	int id;
+};
+
+int main()
+{
+	const size_t ParticlesCount = 20'000'000;
+	const int Repetitions = 10;
+
+	Stopwatch sw;
+	double total;
+
+	//
+	// Array of structures
+	//
+	{
+		DynamicArray<Particle> particles;
+		particles.reserve(ParticlesCount);
+
+		for (size_t i = 0; i < ParticlesCount; ++i)
+			particles.push_back(Particle{ 0, 0, 0, 0, 0, 0, static_cast<float>(i % 100), static_cast<int>(i) });
+
+		std::cout << "Summing the masses in DynamicArray<Particle> (" << sizeof(Particle) << " bytes per record)...";
+
+		total = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r) {
+			float sum = 0;
+
+			for (size_t i = 0; i < particles.size(); ++i)
+				sum += particles[i].mass;
+
+			total += sum;
+		}
+
+		sw.stop();
+		std::cout << " (total " << total << ")\n    execution took " << sw << "\n\n";
+	}
+
+	//
+	// Structure of arrays
+	//
+	{
+		SoAArray<double, double, double, double, double, double, float, int> particles;
+		particles.reserve(ParticlesCount);
+
+		for (size_t i = 0; i < ParticlesCount; ++i)
+			particles.push_back({ 0, 0, 0, 0, 0, 0, static_cast<float>(i % 100), static_cast<int>(i) });
+
+		std::cout << "Summing the masses in an SoAArray (" << sizeof(float) << " bytes per value)...";
+
+		total = 0;
+		sw.start();
+
+		for (int r = 0; r < Repetitions; ++r) {
+			ArraySpan<float> masses = particles.column<6>();
+			float sum = 0;
+
+			for (float mass : masses)
+				sum += mass;
+
+			total += sum;
+		}
+
+		sw.stop();
+		std::cout << " (total " << total << ")\n    execution took " << sw << "\n\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "CacheLine.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+	#include <sys/mman.h>
+#endif
+
+///
+/// @brief Allocates memory with operator new, which is what `new T[]` does.
+///
+/// This is the default allocation policy of FixedSizeArray and DynamicArray.
+/// A policy determines where an array obtains the memory for its elements.
+/// It provides two member functions:
+///
+///     void* allocate(size_t bytes, size_t alignment);
+///     void deallocate(void* p, size_t bytes, size_t alignment) noexcept;
+///
+/// allocate() returns memory for bytes bytes (never zero), aligned to at least
+/// alignment, or throws std::bad_alloc. deallocate() receives the same
+/// arguments as the allocate() call, which returned p.
+///
+/// A policy may also provide
+///
+///     void* reallocate(void* p, size_t oldBytes, size_t newBytes, size_t alignment);
+///
+/// which resizes a buffer without constructing or destroying anything in it
+/// (see RemappableAllocation). DynamicArray uses it to grow arrays of
+/// trivially copyable elements.
+///
+struct DefaultAllocation {
+	void* allocate(size_t bytes, size_t alignment)
+	{
+		if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			return ::operator new(bytes);
+
+		return ::operator new(bytes, std::align_val_t(alignment));
+	}
+
+	void deallocate(void* p, size_t /* bytes */, size_t alignment) noexcept
+	{
+		if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			::operator delete(p);
+		else
+			::operator delete(p, std::align_val_t(alignment));
+	}
+};
+
+/// Allocates memory with operator new, aligned to at least Alignment bytes
+template <size_t Alignment>
+struct AlignedAllocation : private DefaultAllocation {
+	static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "the alignment must be a power of two");
+
+	void* allocate(size_t bytes, size_t alignment)
+	{
+		return DefaultAllocation::allocate(bytes, std::max(alignment, Alignment));
+	}
+
+	void deallocate(void* p, size_t bytes, size_t alignment) noexcept
+	{
+		DefaultAllocation::deallocate(p, bytes, std::max(alignment, Alignment));
+	}
+};
+
+/// The elements start at the beginning of a cache line
+using CacheLineAllocation = AlignedAllocation<CacheLineSize>;
+
+/// The elements are aligned for the widest SIMD loads and stores (AVX-512)
+using SimdAllocation = AlignedAllocation<64>;
+
+///
+/// @brief Allocates large buffers in huge (2 MiB) pages.
+///
+/// A buffer, which spans many regular 4 KiB pages, needs as many TLB entries
+/// to translate its addresses, so walking it in a non-sequential order causes
+/// a TLB miss on almost every access. Backing it with huge pages reduces the
+/// number of entries by a factor of 512.
+///
+/// On Linux, buffers of at least HugePageSize bytes are mapped with mmap.
+/// Reserved huge pages (MAP_HUGETLB) are used if the system has any.
+/// Otherwise the mapping is aligned to a huge page boundary and marked with
+/// MADV_HUGEPAGE, so that the kernel backs it with transparent huge pages.
+/// If transparent huge pages are disabled, the buffer simply uses regular pages.
+/// Smaller buffers, and all buffers on other systems, are allocated with
+/// operator new and aligned to HugePageSize.
+///
+struct HugePageAllocation : private DefaultAllocation {
+	static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+	void* allocate(size_t bytes, size_t alignment)
+	{
+#if defined(__linux__)
+		if (bytes >= HugePageSize && alignment <= HugePageSize)
+			return mapHugePages(roundUp(bytes));
+#endif
+
+		return DefaultAllocation::allocate(bytes, std::max(alignment, HugePageSize));
+	}
+
+	void deallocate(void* p, size_t bytes, size_t alignment) noexcept
+	{
+#if defined(__linux__)
+		if (bytes >= HugePageSize && alignment <= HugePageSize) {
+			munmap(p, roundUp(bytes));
+			return;
+		}
+#endif
+
+		DefaultAllocation::deallocate(p, bytes, std::max(alignment, HugePageSize));
+	}
+
+private:
+	static size_t roundUp(size_t bytes) noexcept
+	{
+		return (bytes + HugePageSize - 1) & ~(HugePageSize - 1);
+	}
+
+#if defined(__linux__)
+	static void* mapHugePages(size_t length)
+	{
+		const int protection = PROT_READ | PROT_WRITE;
+		const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+	#if defined(MAP_HUGETLB)
+		void* reserved = mmap(nullptr, length, protection, flags | MAP_HUGETLB, -1, 0);
+
+		if (reserved != MAP_FAILED)
+			return reserved;
+	#endif
+
+		// Map one extra huge page, so that the buffer can start at a huge page boundary,
+		// then return the unused parts at both ends.
+		void* mapped = mmap(nullptr, length + HugePageSize, protection, flags, -1, 0);
+
+		if (mapped == MAP_FAILED)
+			throw std::bad_alloc();
+
+		std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(mapped);
+		std::uintptr_t aligned = (begin + HugePageSize - 1) & ~std::uintptr_t(HugePageSize - 1);
+
+		if (aligned != begin)
+			munmap(mapped, aligned - begin);
+
+		munmap(reinterpret_cast<void*>(aligned + length), HugePageSize - (aligned - begin));
+
+	#if defined(MADV_HUGEPAGE)
+		madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+	#endif
+
+		return reinterpret_cast<void*>(aligned);
+	}
+#endif
+};
+
+///
+/// @brief Maps large buffers directly from the kernel, so that they can grow without being copied.
+///
+/// On Linux, buffers of at least MinMappedSize bytes are anonymous mappings.
+/// reallocate() resizes them with mremap(MREMAP_MAYMOVE): if the buffer cannot
+/// be extended where it is, the kernel moves its pages to a new address by
+/// rewriting the page tables, instead of copying their contents. So growing a
+/// buffer of hundreds of MiB takes microseconds instead of hundreds of
+/// milliseconds, and the pages of the old buffer are never duplicated.
+///
+/// Smaller buffers, and all buffers on other systems, are allocated with
+/// operator new and reallocate() copies them.
+///
+struct RemappableAllocation : private DefaultAllocation {
+	static constexpr size_t MinMappedSize = 1024 * 1024;
+
+	/// Mappings are aligned to at least a page, which is never smaller than this
+	static constexpr size_t MinPageSize = 4096;
+
+	void* allocate(size_t bytes, size_t alignment)
+	{
+#if defined(__linux__)
+		if (isMapped(bytes, alignment)) {
+			void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (mapped == MAP_FAILED)
+				throw std::bad_alloc();
+
+			return mapped;
+		}
+#endif
+
+		return DefaultAllocation::allocate(bytes, alignment);
+	}
+
+	void deallocate(void* p, size_t bytes, size_t alignment) noexcept
+	{
+#if defined(__linux__)
+		if (isMapped(bytes, alignment)) {
+			munmap(p, bytes);
+			return;
+		}
+#endif
+
+		DefaultAllocation::deallocate(p, bytes, alignment);
+	}
+
+	/// Resizes a buffer, which was returned by allocate(oldBytes, alignment), and returns its new address.
+	/// The first min(oldBytes, newBytes) bytes are preserved.
+	/// @exception std::bad_alloc The buffer cannot be resized. It remains valid and unchanged.
+	void* reallocate(void* p, size_t oldBytes, size_t newBytes, size_t alignment)
+	{
+#if defined(__linux__)
+		if (isMapped(oldBytes, alignment) && isMapped(newBytes, alignment)) {
+			void* remapped = mremap(p, oldBytes, newBytes, MREMAP_MAYMOVE);
+
+			if (remapped == MAP_FAILED)
+				throw std::bad_alloc();
+
+			return remapped;
+		}
+#endif
+
+		void* buffer = allocate(newBytes, alignment);
+		std::memcpy(buffer, p, std::min(oldBytes, newBytes));
+		deallocate(p, oldBytes, alignment);
+		return buffer;
+	}
+
+	/// Checks whether a buffer of the given size is (or would be) a mapping of its own
+	static constexpr bool isMapped(size_t bytes, size_t alignment) noexcept
+	{
+#if defined(__linux__)
+		return bytes >= MinMappedSize && alignment <= MinPageSize;
+#else
+		return false;
+#endif
+	}
+};
+
+/// Checks whether an allocation policy can resize its buffers with reallocate()
+template <typename Allocation, typename = void>
+struct CanReallocate : std::false_type {};
+
+template <typename Allocation>
+struct CanReallocate<Allocation, std::void_t<decltype(std::declval<Allocation&>().reallocate(nullptr, size_t(), size_t(), size_t()))>> : std::true_type {};
+
+///
+/// @brief Obtains the memory from a std::pmr::memory_resource, e.g. an Arena or an ObjectPool.
+///
+/// Unlike the other policies, this one has state: a pointer to the resource.
+/// The resource is not owned and must outlive every array, which uses it.
+/// Copies of an array, and the buffers DynamicArray allocates when it grows,
+/// use the same resource. A default-constructed policy uses
+/// std::pmr::get_default_resource().
+///
+class MemoryResourceAllocation {
+	std::pmr::memory_resource* m_resource;
+
+public:
+	MemoryResourceAllocation() noexcept
+		: m_resource(std::pmr::get_default_resource())
+	{}
+
+	MemoryResourceAllocation(std::pmr::memory_resource* resource) noexcept
+		: m_resource(resource)
+	{}
+
+	std::pmr::memory_resource* resource() const noexcept
+	{
+		return m_resource;
+	}
+
+	void* allocate(size_t bytes, size_t alignment)
+	{
+		return m_resource->allocate(bytes, alignment);
+	}
+
+	void deallocate(void* p, size_t bytes, size_t alignment) noexcept
+	{
+		m_resource->deallocate(p, bytes, alignment);
+	}
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "FixedSizeArray.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+///
+/// @brief A FIFO queue, which stores its elements in a ring buffer.
+///
+/// The capacity of the buffer is always a power of two, so wrapping an index
+/// around is a single bitwise AND. The head and tail are free-running
+/// counters, so push() and pop() each update only their own end of the
+/// queue. When the buffer is full, its capacity is doubled and the elements
+/// are moved to the new buffer in order, starting at index 0. This unwraps
+/// the ring in a single pass and makes push() amortized O(1). There is no
+/// per-element allocation.
+///
+template <typename T>
+class ArrayQueue {
+public:
+	/// Capacity of the buffer allocated by the first push()
+	static constexpr size_t MinCapacity = 16;
+
+	/// Thrown when an operation, that requires the queue to have at least one element,
+	/// was performed on an empty queue.
+	class EmptyQueueException : public std::logic_error {
+	public:
+		EmptyQueueException()
+			: std::logic_error("Operation was performed on an empty queue")
+		{}
+	};
+
+private:
+	FixedSizeArray<T> m_buffer;
+	size_t m_head = 0;
+	size_t m_tail = 0;
+
+public:
+	/// Constructs an empty queue with zero capacity
+	ArrayQueue() = default;
+
+	ArrayQueue(const ArrayQueue&) = default;
+	ArrayQueue& operator=(const ArrayQueue&) = default;
+
+	/// Takes over the buffer of other, which is left empty with zero capacity
+	ArrayQueue(ArrayQueue&& other) noexcept
+		: m_buffer(std::move(other.m_buffer)),
+		  m_head(std::exchange(other.m_head, 0)),
+		  m_tail(std::exchange(other.m_tail, 0))
+	{}
+
+	ArrayQueue& operator=(ArrayQueue&& other) noexcept
+	{
+		if (this != &other) {
+			m_buffer = std::move(other.m_buffer);
+			m_head = std::exchange(other.m_head, 0);
+			m_tail = std::exchange(other.m_tail, 0);
+		}
+
+		return *this;
+	}
+
+	/// Number of elements in the queue
+	size_t size() const noexcept
+	{
+		return m_tail - m_head;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_tail == m_head;
+	}
+
+	/// Number of elements the queue can hold without reallocating
+	size_t capacity() const noexcept
+	{
+		return m_buffer.size();
+	}
+
+	/// Ensure the queue can hold at least desiredCapacity elements without reallocating.
+	/// The capacity is rounded up to a power of two.
+	/// @exception std::bad_alloc Memory allocation failed
+	void reserve(size_t desiredCapacity)
+	{
+		if (desiredCapacity <= capacity())
+			return;
+
+		size_t newCapacity = std::max(MinCapacity, capacity());
+
+		while (newCapacity < desiredCapacity)
+			newCapacity *= 2;
+
+		reallocate(newCapacity);
+	}
+
+	/// Append a copy of value to the back of the queue
+	/// @exception std::bad_alloc Memory allocation failed
+	void push(const T& value)
+	{
+		if (size() == capacity())
+			reallocate(std::max(MinCapacity, 2 * capacity()));
+
+		m_buffer[wrap(m_tail)] = value;
+		++m_tail;
+	}
+
+	/// Move value to the back of the queue
+	/// @exception std::bad_alloc Memory allocation failed
+	void push(T&& value)
+	{
+		if (size() == capacity())
+			reallocate(std::max(MinCapacity, 2 * capacity()));
+
+		m_buffer[wrap(m_tail)] = std::move(value);
+		++m_tail;
+	}
+
+	/// Retrieve the element at the front of the queue
+	/// @exception EmptyQueueException The queue is empty
+	T& front()
+	{
+		if (empty())
+			throw EmptyQueueException();
+
+		return m_buffer[wrap(m_head)];
+	}
+
+	/// Retrieve the element at the front of the queue
+	/// @exception EmptyQueueException The queue is empty
+	const T& front() const
+	{
+		if (empty())
+			throw EmptyQueueException();
+
+		return m_buffer[wrap(m_head)];
+	}
+
+	/// Retrieve the element at the back of the queue
+	/// @exception EmptyQueueException The queue is empty
+	T& back()
+	{
+		if (empty())
+			throw EmptyQueueException();
+
+		return m_buffer[wrap(m_tail - 1)];
+	}
+
+	/// Retrieve the element at the back of the queue
+	/// @exception EmptyQueueException The queue is empty
+	const T& back() const
+	{
+		if (empty())
+			throw EmptyQueueException();
+
+		return m_buffer[wrap(m_tail - 1)];
+	}
+
+	/// Remove the element at the front of the queue
+	/// @exception EmptyQueueException The queue is empty
+	void pop()
+	{
+		if (empty())
+			throw EmptyQueueException();
+
+		// The buffer keeps its elements alive, so release the resources held by the removed one
+		if constexpr ( ! std::is_trivially_destructible_v<T>)
+			m_buffer[wrap(m_head)] = T();
+
+		++m_head;
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(ArrayQueue& other) noexcept
+	{
+		m_buffer.swap(other.m_buffer);
+		std::swap(m_head, other.m_head);
+		std::swap(m_tail, other.m_tail);
+	}
+
+private:
+	/// Moves the elements to a new buffer in order, starting at index 0
+	void reallocate(size_t newCapacity)
+	{
+		FixedSizeArray<T> buffer(newCapacity);
+		size_t used = size();
+
+		// The elements occupy at most two contiguous runs: [head, end) and [0, tail)
+		if (used != 0) {
+			size_t first = wrap(m_head);
+			size_t firstRun = std::min(used, capacity() - first);
+			T* next = std::move(m_buffer.data() + first, m_buffer.data() + first + firstRun, buffer.data());
+			std::move(m_buffer.data(), m_buffer.data() + (used - firstRun), next);
+		}
+
+		m_buffer = std::move(buffer);
+		m_head = 0;
+		m_tail = used;
+	}
+
+	size_t wrap(size_t index) const noexcept
+	{
+		return index & (m_buffer.size() - 1);
+	}
+};
@@ -0,0 +1,287 @@
+#pragma once
+
+#include "CheckedAccess.h"
+#include "DynamicArray.h"
+#include "FixedSizeArray.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/// Thrown when a file cannot be written, or does not contain a valid array of the requested type
+class ArrayFormatError : public std::runtime_error {
+public:
+	ArrayFormatError(const char* message)
+		: std::runtime_error(message)
+	{}
+};
+
+/// Identifies the type of the elements stored in a file
+enum class ArrayElementType : std::uint16_t {
+	/// A trivially copyable type, which is not one of the types below.
+	/// Only its size is checked when loading.
+	Other = 0,
+	Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64,
+	Float, Double, Char, Bool
+};
+
+/// Retrieves the tag, which identifies T in an array file
+template <typename T>
+constexpr ArrayElementType arrayElementTypeOf() noexcept
+{
+	if constexpr (std::is_same_v<T, char>) return ArrayElementType::Char;
+	else if constexpr (std::is_same_v<T, bool>) return ArrayElementType::Bool;
+	else if constexpr (std::is_same_v<T, float>) return ArrayElementType::Float;
+	else if constexpr (std::is_same_v<T, double>) return ArrayElementType::Double;
+	else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+		switch (sizeof(T)) {
+			case 1: return ArrayElementType::Int8;
+			case 2: return ArrayElementType::Int16;
+			case 4: return ArrayElementType::Int32;
+			case 8: return ArrayElementType::Int64;
+		}
+	}
+	else if constexpr (std::is_integral_v<T>) {
+		switch (sizeof(T)) {
+			case 1: return ArrayElementType::UInt8;
+			case 2: return ArrayElementType::UInt16;
+			case 4: return ArrayElementType::UInt32;
+			case 8: return ArrayElementType::UInt64;
+		}
+	}
+
+	return ArrayElementType::Other;
+}
+
+///
+/// @brief The header at the start of an array file.
+///
+/// An array file consists of this header, followed by the raw bytes of the
+/// elements. The header records the type and size of the elements, the
+/// byte order of the machine that wrote them and a checksum of the data.
+/// Its size is 64 bytes, so the elements are suitably aligned for any type
+/// when the file is mapped into memory.
+///
+struct ArrayFileHeader {
+	static constexpr char Signature[4] = { 'A', 'R', 'R', 'Y' };
+	static constexpr std::uint16_t CurrentVersion = 1;
+	static constexpr std::uint32_t ByteOrderMark = 0x01020304;
+
+	char signature[4];
+	std::uint16_t version;
+	ArrayElementType elementType;
+	std::uint32_t byteOrder;
+	std::uint32_t elementSize;
+	std::uint64_t size;
+	std::uint64_t checksum;
+	std::uint8_t reserved[32];
+};
+
+static_assert(sizeof(ArrayFileHeader) == 64, "the elements must start at a 64-byte boundary");
+
+/// Computes the checksum, which is stored in the header of an array file.
+/// The data is processed one 64-bit word at a time (FNV-1a over words).
+inline std::uint64_t arrayChecksum(const void* data, size_t bytes) noexcept
+{
+	const std::uint64_t Prime = 0x100000001b3;
+	std::uint64_t hash = 0xcbf29ce484222325;
+
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	const unsigned char* wordsEnd = p + (bytes & ~size_t(7));
+
+	for (; p != wordsEnd; p += 8) {
+		std::uint64_t word;
+		std::memcpy(&word, p, 8);
+		hash = (hash ^ word) * Prime;
+	}
+
+	for (; p != wordsEnd + (bytes & 7); ++p)
+		hash = (hash ^ *p) * Prime;
+
+	return hash;
+}
+
+///
+/// Saves an array of elements to a file
+///
+/// @exception ArrayFormatError The file cannot be written
+///
+template <typename T>
+void saveArray(const std::string& path, const T* data, size_t size)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "only arrays of trivially copyable types can be saved");
+
+	ArrayFileHeader header = {};
+	std::memcpy(header.signature, ArrayFileHeader::Signature, sizeof(header.signature));
+	header.version = ArrayFileHeader::CurrentVersion;
+	header.elementType = arrayElementTypeOf<T>();
+	header.byteOrder = ArrayFileHeader::ByteOrderMark;
+	header.elementSize = sizeof(T);
+	header.size = size;
+	header.checksum = arrayChecksum(data, size * sizeof(T));
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size * sizeof(T)));
+	out.close();
+
+	if ( ! out)
+		throw ArrayFormatError("cannot write the array file");
+}
+
+/// Saves the elements of a FixedSizeArray to a file
+/// @exception ArrayFormatError The file cannot be written
+template <typename T, typename Allocation>
+void saveArray(const std::string& path, const FixedSizeArray<T, Allocation>& arr)
+{
+	saveArray(path, arr.data(), arr.size());
+}
+
+/// Saves the elements of a DynamicArray to a file
+/// @exception ArrayFormatError The file cannot be written
+template <typename T, typename Allocation>
+void saveArray(const std::string& path, const DynamicArray<T, Allocation>& arr)
+{
+	saveArray(path, arr.data(), arr.size());
+}
+
+/// Whether loadArray() verifies the checksum of the data
+enum class ChecksumVerification {
+	/// Read the whole file and compare its checksum to the one in the header
+	Verify,
+
+	/// Only validate the header. The elements are not read until they are accessed.
+	Skip
+};
+
+///
+/// @brief A read-only view of the elements stored in an array file.
+///
+/// The view owns the mapping of the file. The elements are read from disk
+/// when they are accessed and are never copied.
+///
+template <typename T>
+class ArrayFileView {
+	MappedFile m_file;
+	const T* m_data = nullptr;
+	size_t m_size = 0;
+
+public:
+	/// Constructs an empty view
+	ArrayFileView() noexcept = default;
+
+	ArrayFileView(ArrayFileView&& other) noexcept
+	{
+		swap(other);
+	}
+
+	ArrayFileView& operator=(ArrayFileView&& other) noexcept
+	{
+		ArrayFileView temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	///
+	/// Maps an array file and validates its header
+	///
+	/// @exception std::system_error The file cannot be opened or mapped
+	/// @exception ArrayFormatError The file is not a valid array of T, or it was written on
+	///            a machine with a different byte order, or its checksum does not match
+	///
+	explicit ArrayFileView(const std::string& path, ChecksumVerification verification = ChecksumVerification::Verify)
+		: m_file(path, MappingMode::ReadOnly)
+	{
+		if (m_file.size() < sizeof(ArrayFileHeader))
+			throw ArrayFormatError("the file is too small to be an array file");
+
+		ArrayFileHeader header;
+		std::memcpy(&header, m_file.data(), sizeof(header));
+
+		if (std::memcmp(header.signature, ArrayFileHeader::Signature, sizeof(header.signature)) != 0)
+			throw ArrayFormatError("the file is not an array file");
+
+		// The byte order is checked first, because the other fields of a file
+		// written with a different byte order cannot be read correctly
+		if (header.byteOrder != ArrayFileHeader::ByteOrderMark)
+			throw ArrayFormatError("the array file was written with a different byte order");
+
+		if (header.version != ArrayFileHeader::CurrentVersion)
+			throw ArrayFormatError("the version of the array file is not supported");
+
+		if (header.elementType != arrayElementTypeOf<T>() || header.elementSize != sizeof(T))
+			throw ArrayFormatError("the array file stores elements of a different type");
+
+		if (header.size > (m_file.size() - sizeof(ArrayFileHeader)) / sizeof(T))
+			throw ArrayFormatError("the array file is truncated");
+
+		m_data = reinterpret_cast<const T*>(static_cast<const char*>(m_file.data()) + sizeof(ArrayFileHeader));
+		m_size = static_cast<size_t>(header.size);
+
+		if (verification == ChecksumVerification::Verify && arrayChecksum(m_data, m_size * sizeof(T)) != header.checksum)
+			throw ArrayFormatError("the checksum of the array file does not match its contents");
+	}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	const T* data() const noexcept
+	{
+		return m_data;
+	}
+
+	const T& at(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return m_data[index];
+	}
+
+	/// Retrieve the element at index.
+	/// The index is only checked if CONTAINERS_CHECKED_ACCESS is enabled (see CheckedAccess.h).
+	const T& operator[](size_t index) const noexcept
+	{
+		CONTAINERS_CHECK_INDEX(index, m_size);
+		return m_data[index];
+	}
+
+	/// Tells the operating system how the elements will be accessed
+	void advise(AccessPattern pattern) noexcept
+	{
+		m_file.advise(pattern);
+	}
+
+	void swap(ArrayFileView& other) noexcept
+	{
+		m_file.swap(other.m_file);
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+	}
+};
+
+///
+/// Loads an array file without copying its contents
+///
+/// @exception std::system_error The file cannot be opened or mapped
+/// @exception ArrayFormatError The file is not a valid array of T
+///
+template <typename T>
+ArrayFileView<T> loadArray(const std::string& path, ChecksumVerification verification = ChecksumVerification::Verify)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "only arrays of trivially copyable types can be loaded");
+	static_assert(alignof(T) <= sizeof(ArrayFileHeader), "the elements would not be aligned in the mapped file");
+
+	return ArrayFileView<T>(path, verification);
+}
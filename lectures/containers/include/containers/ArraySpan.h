@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+///
+/// @brief A non-owning view of a contiguous sequence of elements.
+///
+/// Containers return spans to give direct access to parts of their storage,
+/// e.g. the columns of an SoAArray. A span stays valid until the storage
+/// it refers to is reallocated or destroyed.
+///
+template <typename T>
+class ArraySpan {
+	T* m_data = nullptr;
+	size_t m_size = 0;
+
+public:
+	/// Constructs an empty span
+	ArraySpan() noexcept = default;
+
+	ArraySpan(T* data, size_t size) noexcept
+		: m_data(data), m_size(size)
+	{}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	T* data() const noexcept
+	{
+		return m_data;
+	}
+
+	T& at(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the span");
+
+		return m_data[index];
+	}
+
+	T& operator[](size_t index) const noexcept
+	{
+		return m_data[index];
+	}
+
+	T* begin() const noexcept
+	{
+		return m_data;
+	}
+
+	T* end() const noexcept
+	{
+		return m_data + m_size;
+	}
+};
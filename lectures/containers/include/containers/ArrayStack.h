@@ -0,0 +1,95 @@
+#pragma once
+
+#include "DynamicArray.h"
+
+#include <utility>
+
+///
+/// @brief A LIFO stack, which stores its elements in a single contiguous buffer.
+///
+/// The elements are kept in a DynamicArray, so push() is amortized O(1),
+/// pop() never frees memory and there is no per-element allocation.
+///
+template <typename T>
+class ArrayStack {
+	DynamicArray<T> m_data;
+
+public:
+	/// Thrown by top() and pop() when the stack is empty
+	using EmptyStackException = typename DynamicArray<T>::EmptyArrayException;
+
+public:
+	/// Constructs an empty stack
+	ArrayStack() = default;
+
+	/// Number of elements in the stack
+	size_t size() const noexcept
+	{
+		return m_data.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return m_data.size() == 0;
+	}
+
+	/// Number of elements the stack can hold without reallocating
+	size_t capacity() const noexcept
+	{
+		return m_data.capacity();
+	}
+
+	/// Ensure the stack can hold at least desiredCapacity elements without reallocating
+	/// @exception std::bad_alloc Memory allocation failed
+	void reserve(size_t desiredCapacity)
+	{
+		m_data.reserve(desiredCapacity);
+	}
+
+	/// Place a copy of value on top of the stack
+	/// @exception std::bad_alloc Memory allocation failed
+	void push(const T& value)
+	{
+		m_data.push_back(value);
+	}
+
+	/// Move value on top of the stack
+	/// @exception std::bad_alloc Memory allocation failed
+	void push(T&& value)
+	{
+		m_data.push_back(std::move(value));
+	}
+
+	/// Retrieve the element on top of the stack
+	/// @exception EmptyStackException The stack is empty
+	T& top()
+	{
+		if (empty())
+			throw EmptyStackException();
+
+		return m_data[m_data.size() - 1];
+	}
+
+	/// Retrieve the element on top of the stack
+	/// @exception EmptyStackException The stack is empty
+	const T& top() const
+	{
+		if (empty())
+			throw EmptyStackException();
+
+		return m_data[m_data.size() - 1];
+	}
+
+	/// Remove the element on top of the stack
+	/// @exception EmptyStackException The stack is empty
+	void pop()
+	{
+		m_data.pop_back();
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(ArrayStack& other) noexcept
+	{
+		m_data.swap(other.m_data);
+	}
+};
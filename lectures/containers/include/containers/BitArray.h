@@ -0,0 +1,375 @@
+#pragma once
+
+#include "Bits.h"
+#include "FixedSizeArray.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+///
+/// @brief An array of bits, whose size is set when it is created.
+///
+/// The bits are packed into 64-bit words, so the array takes 1/8 of the memory
+/// of an array of bool. Whole-array operations (count(), rank(), the bitwise
+/// operators) work on a word at a time.
+///
+/// The unused bits of the last word are always zero, so the operations never
+/// have to mask them out.
+///
+class BitArray {
+	FixedSizeArray<std::uint64_t> m_words;
+	size_t m_size = 0;
+
+public:
+	/// A reference to a single bit, returned by the non-const operator[] and at()
+	class Reference {
+		std::uint64_t& m_word;
+		std::uint64_t m_mask;
+
+	public:
+		Reference(std::uint64_t& word, size_t bit) noexcept
+			: m_word(word), m_mask(std::uint64_t(1) << bit)
+		{}
+
+		Reference(const Reference&) = default;
+
+		operator bool() const noexcept
+		{
+			return (m_word & m_mask) != 0;
+		}
+
+		Reference& operator=(bool value) noexcept
+		{
+			// Branch-free: clear the bit, then or in the new value
+			m_word = (m_word & ~m_mask) | ((std::uint64_t(0) - std::uint64_t(value)) & m_mask);
+			return *this;
+		}
+
+		Reference& operator=(const Reference& other) noexcept
+		{
+			return *this = bool(other);
+		}
+	};
+
+public:
+	/// Constructs an empty array
+	BitArray() noexcept = default;
+
+	BitArray(const BitArray&) = default;
+	BitArray& operator=(const BitArray&) = default;
+
+	/// Takes over the bits of other, which is left empty
+	BitArray(BitArray&& other) noexcept
+		: m_words(std::move(other.m_words)), m_size(std::exchange(other.m_size, 0))
+	{}
+
+	BitArray& operator=(BitArray&& other) noexcept
+	{
+		if (this != &other) {
+			m_words = std::move(other.m_words);
+			m_size = std::exchange(other.m_size, 0);
+		}
+
+		return *this;
+	}
+
+	/// Creates an array with a specified size, with all bits set to value
+	/// @exception std::bad_alloc if memory allocation fails
+	explicit BitArray(size_t size, bool value = false)
+		: m_words(bits::wordsFor(size)), m_size(size)
+	{
+		fill(value);
+	}
+
+	/// Number of bits in the array
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/// Number of words, which store the bits
+	size_t wordCount() const noexcept
+	{
+		return m_words.size();
+	}
+
+	/// The words, which store the bits. Bit i is bit (i % 64) of word (i / 64).
+	std::uint64_t* data() noexcept
+	{
+		return m_words.data();
+	}
+
+	const std::uint64_t* data() const noexcept
+	{
+		return m_words.data();
+	}
+
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	Reference at(size_t index)
+	{
+		checkIndex(index);
+		return (*this)[index];
+	}
+
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	bool at(size_t index) const
+	{
+		checkIndex(index);
+		return (*this)[index];
+	}
+
+	Reference operator[](size_t index) noexcept
+	{
+		return Reference(m_words[index / bits::WordBits], index % bits::WordBits);
+	}
+
+	bool operator[](size_t index) const noexcept
+	{
+		return (m_words[index / bits::WordBits] >> (index % bits::WordBits)) & 1;
+	}
+
+	/// Sets all bits to value
+	void fill(bool value) noexcept
+	{
+		std::fill_n(m_words.data(), m_words.size(), value ? ~std::uint64_t(0) : 0);
+		clearUnusedBits();
+	}
+
+	/// Inverts all bits
+	void flip() noexcept
+	{
+		for (size_t i = 0; i < m_words.size(); ++i)
+			m_words[i] = ~m_words[i];
+
+		clearUnusedBits();
+	}
+
+	/// Number of set bits
+	size_t count() const noexcept
+	{
+		size_t total = 0;
+
+		for (size_t i = 0; i < m_words.size(); ++i)
+			total += bits::popcount(m_words[i]);
+
+		return total;
+	}
+
+	///
+	/// Number of set bits in the range [0, position)
+	///
+	/// The bits are counted a word at a time, so the complexity is O(position / 64).
+	/// Use RankSelectIndex for constant-time queries on an array, which does not change.
+	///
+	/// @exception std::out_of_range If position > size()
+	///
+	size_t rank(size_t position) const
+	{
+		if (position > m_size)
+			throw std::out_of_range("position is out of the bounds of the array");
+
+		size_t fullWords = position / bits::WordBits;
+		size_t total = 0;
+
+		for (size_t i = 0; i < fullWords; ++i)
+			total += bits::popcount(m_words[i]);
+
+		if (position % bits::WordBits)
+			total += bits::popcount(m_words[fullWords] & bits::lowMask(position % bits::WordBits));
+
+		return total;
+	}
+
+	///
+	/// Index of the rank-th (counting from zero) set bit
+	///
+	/// @exception std::out_of_range If the array has rank or fewer set bits
+	///
+	size_t select(size_t rank) const
+	{
+		for (size_t i = 0; i < m_words.size(); ++i) {
+			unsigned ones = bits::popcount(m_words[i]);
+
+			if (rank < ones)
+				return i * bits::WordBits + bits::selectInWord(m_words[i], static_cast<unsigned>(rank));
+
+			rank -= ones;
+		}
+
+		throw std::out_of_range("the array does not have that many set bits");
+	}
+
+	/// @exception std::invalid_argument If the arrays have different sizes
+	BitArray& operator&=(const BitArray& other)
+	{
+		checkSameSize(other);
+
+		for (size_t i = 0; i < m_words.size(); ++i)
+			m_words[i] &= other.m_words[i];
+
+		return *this;
+	}
+
+	/// @exception std::invalid_argument If the arrays have different sizes
+	BitArray& operator|=(const BitArray& other)
+	{
+		checkSameSize(other);
+
+		for (size_t i = 0; i < m_words.size(); ++i)
+			m_words[i] |= other.m_words[i];
+
+		return *this;
+	}
+
+	/// @exception std::invalid_argument If the arrays have different sizes
+	BitArray& operator^=(const BitArray& other)
+	{
+		checkSameSize(other);
+
+		for (size_t i = 0; i < m_words.size(); ++i)
+			m_words[i] ^= other.m_words[i];
+
+		return *this;
+	}
+
+	void swap(BitArray& other) noexcept
+	{
+		m_words.swap(other.m_words);
+		std::swap(m_size, other.m_size);
+	}
+
+	/// Checks whether two arrays have the same size and contain the same bits
+	bool operator==(const BitArray& other) const noexcept
+	{
+		return m_size == other.m_size && m_words == other.m_words;
+	}
+
+	bool operator!=(const BitArray& other) const noexcept
+	{
+		return ! (*this == other);
+	}
+
+private:
+	void checkIndex(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the array");
+	}
+
+	void checkSameSize(const BitArray& other) const
+	{
+		if (m_size != other.m_size)
+			throw std::invalid_argument("the bit arrays have different sizes");
+	}
+
+	void clearUnusedBits() noexcept
+	{
+		if (m_size % bits::WordBits)
+			m_words[m_words.size() - 1] &= bits::lowMask(m_size % bits::WordBits);
+	}
+};
+
+inline BitArray operator&(BitArray left, const BitArray& right)
+{
+	return left &= right;
+}
+
+inline BitArray operator|(BitArray left, const BitArray& right)
+{
+	return left |= right;
+}
+
+inline BitArray operator^(BitArray left, const BitArray& right)
+{
+	return left ^= right;
+}
+
+///
+/// @brief Constant-time rank and logarithmic-time select over a BitArray.
+///
+/// The index stores the number of set bits before each block of 512 bits
+/// (8 words, a single cache line), which adds 1/8 to the memory of the array.
+/// rank() adds the count of the block to the popcounts of at most 8 words.
+/// select() finds the block with a binary search and then scans its words.
+///
+/// The index does not own the array. It must be rebuilt when the array changes.
+///
+class RankSelectIndex {
+public:
+	/// Number of words covered by each stored count
+	static constexpr size_t BlockWords = 8;
+
+private:
+	const BitArray* m_bits = nullptr;
+	FixedSizeArray<size_t> m_blockRanks;
+
+public:
+	/// Constructs an index over bits
+	/// @exception std::bad_alloc if memory allocation fails
+	explicit RankSelectIndex(const BitArray& bits)
+		: m_bits(&bits), m_blockRanks(bits.wordCount() / BlockWords + 1)
+	{
+		size_t total = 0;
+
+		for (size_t block = 0; block < m_blockRanks.size(); ++block) {
+			m_blockRanks[block] = total;
+
+			size_t end = std::min((block + 1) * BlockWords, bits.wordCount());
+
+			for (size_t i = block * BlockWords; i < end; ++i)
+				total += bits::popcount(bits.data()[i]);
+		}
+	}
+
+	/// Number of set bits in the range [0, position)
+	/// @exception std::out_of_range If position > size() of the array
+	size_t rank(size_t position) const
+	{
+		if (position > m_bits->size())
+			throw std::out_of_range("position is out of the bounds of the array");
+
+		const std::uint64_t* words = m_bits->data();
+		size_t word = position / bits::WordBits;
+		size_t total = m_blockRanks[word / BlockWords];
+
+		for (size_t i = word - word % BlockWords; i < word; ++i)
+			total += bits::popcount(words[i]);
+
+		if (position % bits::WordBits)
+			total += bits::popcount(words[word] & bits::lowMask(position % bits::WordBits));
+
+		return total;
+	}
+
+	/// Index of the rank-th (counting from zero) set bit
+	/// @exception std::out_of_range If the array has rank or fewer set bits
+	size_t select(size_t rank) const
+	{
+		const size_t* ranks = m_blockRanks.data();
+
+		// The last block whose count of preceding bits is <= rank
+		size_t block = std::upper_bound(ranks, ranks + m_blockRanks.size(), rank) - ranks - 1;
+		rank -= ranks[block];
+
+		const std::uint64_t* words = m_bits->data();
+		size_t end = std::min((block + 1) * BlockWords, m_bits->wordCount());
+
+		for (size_t i = block * BlockWords; i < end; ++i) {
+			unsigned ones = bits::popcount(words[i]);
+
+			if (rank < ones)
+				return i * bits::WordBits + bits::selectInWord(words[i], static_cast<unsigned>(rank));
+
+			rank -= ones;
+		}
+
+		throw std::out_of_range("the array does not have that many set bits");
+	}
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+#if defined(__BMI2__)
+	#include <immintrin.h>
+#endif
+
+///
+/// Operations on the bits of a 64-bit word, used by the bit-packed containers.
+///
+/// They map to single instructions (popcnt, tzcnt, pdep) where the target
+/// supports them. Otherwise they fall back to branch-free integer code,
+/// which the compiler can also vectorize when it is applied to whole arrays.
+///
+namespace bits {
+
+/// Number of bits in a word
+constexpr size_t WordBits = 64;
+
+/// Number of set bits in word
+inline unsigned popcount(std::uint64_t word) noexcept
+{
+#if defined(__POPCNT__) || defined(__ARM_NEON)
+	return static_cast<unsigned>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return static_cast<unsigned>(__popcnt64(word));
+#else
+	word = word - ((word >> 1) & 0x5555555555555555ull);
+	word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return static_cast<unsigned>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/// Index of the lowest set bit. The word must not be zero.
+inline unsigned countTrailingZeros(std::uint64_t word) noexcept
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+/// Index of the rank-th (counting from zero) set bit. The word must have more than rank set bits.
+inline unsigned selectInWord(std::uint64_t word, unsigned rank) noexcept
+{
+#if defined(__BMI2__)
+	return countTrailingZeros(_pdep_u64(std::uint64_t(1) << rank, word));
+#else
+	for (unsigned i = 0; i < rank; ++i)
+		word &= word - 1;
+
+	return countTrailingZeros(word);
+#endif
+}
+
+/// A word with the lowest count bits set, for count in [0, 64]
+constexpr std::uint64_t lowMask(size_t count) noexcept
+{
+	return count >= WordBits ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+}
+
+/// Number of words needed to store count bits
+constexpr size_t wordsFor(size_t count) noexcept
+{
+	return (count + WordBits - 1) / WordBits;
+}
+
+} // namespace bits
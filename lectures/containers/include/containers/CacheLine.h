@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+/// Assumed size of a cache line.
+/// Data written by different threads is aligned to it to avoid false sharing.
+constexpr size_t CacheLineSize = 64;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+///
+/// CONTAINERS_CHECKED_ACCESS selects whether operator[] of the arrays checks its index.
+///
+///   0  Unchecked. Indexing compiles to the same code as indexing a raw pointer.
+///      This is the default when NDEBUG is defined (i.e. in release builds).
+///   1  An index out of bounds prints a message and aborts the program.
+///      This is the default otherwise (i.e. in debug builds).
+///
+/// Define it to 1 to keep the checks in a hardened release build, e.g. with
+/// the ENABLE_CHECKED_ACCESS CMake option. at() always checks its index and
+/// throws std::out_of_range, regardless of this setting.
+///
+/// All translation units of a program must use the same setting.
+///
+#ifndef CONTAINERS_CHECKED_ACCESS
+	#if defined(NDEBUG)
+		#define CONTAINERS_CHECKED_ACCESS 0
+	#else
+		#define CONTAINERS_CHECKED_ACCESS 1
+	#endif
+#endif
+
+/// Reports an index out of bounds and aborts the program.
+/// It is kept out of line, so that a check adds only a comparison and a branch to the caller.
+[[noreturn]]
+#if defined(__GNUC__)
+__attribute__((noinline, cold))
+#endif
+inline void indexOutOfBounds(size_t index, size_t size) noexcept
+{
+	std::fprintf(stderr, "index %zu is out of the bounds of an array with %zu elements\n", index, size);
+	std::abort();
+}
+
+#if CONTAINERS_CHECKED_ACCESS
+	#define CONTAINERS_CHECK_INDEX(index, size) ((index) < (size) ? static_cast<void>(0) : indexOutOfBounds((index), (size)))
+#else
+	#define CONTAINERS_CHECK_INDEX(index, size) static_cast<void>(0)
+#endif
@@ -0,0 +1,444 @@
+#pragma once
+
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define CONTAINERS_COMPRESSED_SSE2
+	#include <emmintrin.h>
+#endif
+
+///
+/// @brief An append-only array of 32-bit integers, which stores them compressed in blocks.
+///
+/// Every BlockSize (128) elements form a block, which is encoded on its own
+/// with one of two schemes, whichever needs fewer bits:
+///
+/// - *frame of reference*: each element is stored as its difference from the
+///   smallest element of the block,
+/// - *delta*: each element is stored as its difference from the element four
+///   positions earlier, minus the smallest such difference. This suits sorted
+///   or slowly changing data.
+///
+/// The resulting non-negative numbers are bit-packed with the smallest width
+/// that fits all of them. The packing is *vertical*: element i goes into lane
+/// i % 4 of a sequence of 128-bit words, so that four elements are unpacked
+/// at once with SSE2 shifts (where available), and the delta scheme is undone
+/// with four-wide additions.
+///
+/// A header per block records its scheme, bit width, reference value and the
+/// position of its packed words, so a random access decodes only a part of
+/// one block. The last, incomplete block is kept uncompressed until it fills up.
+///
+template <typename T>
+class CompressedArray {
+	static_assert(std::is_integral_v<T> && sizeof(T) == 4, "CompressedArray stores 32-bit integers");
+
+public:
+	/// Number of elements encoded together
+	static constexpr size_t BlockSize = 128;
+
+private:
+	using Word = std::uint32_t;
+
+	/// Number of elements packed side by side into a 128-bit word
+	static constexpr size_t Lanes = 4;
+
+	enum class Scheme : std::uint8_t {
+		FrameOfReference,
+		Delta,
+	};
+
+	struct BlockHeader {
+		/// Index of the first packed word of the block
+		std::uint32_t offset;
+
+		/// The smallest element (FrameOfReference) or difference (Delta)
+		Word reference;
+
+		/// The first element, from which the differences are accumulated (Delta)
+		Word base;
+
+		std::uint8_t bits;
+		Scheme scheme;
+	};
+
+	DynamicArray<BlockHeader> m_headers;
+
+	/// Each block occupies Lanes * bits words
+	DynamicArray<Word> m_packed;
+
+	/// The elements after the last complete block
+	DynamicArray<T> m_tail;
+
+	size_t m_size = 0;
+
+public:
+	/// Constructs an empty array
+	CompressedArray() = default;
+
+	CompressedArray(const CompressedArray&) = default;
+	CompressedArray& operator=(const CompressedArray&) = default;
+
+	/// Takes over the blocks of other, which is left empty
+	CompressedArray(CompressedArray&& other) noexcept
+		: m_headers(std::move(other.m_headers)),
+		  m_packed(std::move(other.m_packed)),
+		  m_tail(std::move(other.m_tail)),
+		  m_size(std::exchange(other.m_size, 0))
+	{}
+
+	CompressedArray& operator=(CompressedArray&& other) noexcept
+	{
+		if (this != &other) {
+			m_headers = std::move(other.m_headers);
+			m_packed = std::move(other.m_packed);
+			m_tail = std::move(other.m_tail);
+			m_size = std::exchange(other.m_size, 0);
+		}
+
+		return *this;
+	}
+
+	/// Compresses count values
+	/// @exception std::bad_alloc Memory allocation failed
+	CompressedArray(const T* values, size_t count)
+	{
+		m_headers.reserve(count / BlockSize);
+
+		for (size_t i = 0; i < count; ++i)
+			push_back(values[i]);
+	}
+
+	/// Compresses the elements of a DynamicArray
+	/// @exception std::bad_alloc Memory allocation failed
+	template <typename Allocation>
+	explicit CompressedArray(const DynamicArray<T, Allocation>& values)
+		: CompressedArray(values.data(), values.size())
+	{}
+
+	/// Number of elements in the array
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/// Number of complete, compressed blocks
+	size_t blockCount() const noexcept
+	{
+		return m_headers.size();
+	}
+
+	/// Number of bytes used by the headers, the packed blocks and the uncompressed tail
+	size_t compressedBytes() const noexcept
+	{
+		return m_headers.size() * sizeof(BlockHeader) + m_packed.size() * sizeof(Word) + m_tail.size() * sizeof(T);
+	}
+
+	/// Append value to the array. Every BlockSize-th call compresses a block.
+	/// @exception std::bad_alloc Memory allocation failed
+	void push_back(T value)
+	{
+		m_tail.push_back(value);
+		++m_size;
+
+		if (m_tail.size() == BlockSize) {
+			encodeBlock(m_tail.data());
+			m_tail.resize(0);
+		}
+	}
+
+	///
+	/// Retrieve the element at index.
+	/// In a frame-of-reference block this unpacks a single element, in a delta
+	/// block the whole block.
+	///
+	T operator[](size_t index) const noexcept
+	{
+		size_t block = index / BlockSize;
+
+		if (block == m_headers.size())
+			return m_tail[index % BlockSize];
+
+		const BlockHeader& header = m_headers[block];
+		size_t position = index % BlockSize;
+
+		if (header.scheme == Scheme::FrameOfReference)
+			return T(header.reference + unpackOne(m_packed.data() + header.offset, header.bits, position));
+
+		// Decoding the whole block is faster than accumulating the differences one by one
+		alignas(16) T values[BlockSize];
+		decodeBlock(block, values);
+		return values[position];
+	}
+
+	/// Retrieve the element at index
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	T at(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return (*this)[index];
+	}
+
+	/// Decodes the BlockSize elements of a complete block into out
+	void decodeBlock(size_t block, T* out) const noexcept
+	{
+		// Stores to out may alias the (unsigned) header fields, so they are read into locals
+		const BlockHeader header = m_headers[block];
+
+		alignas(16) Word values[BlockSize];
+		unpackBlock(m_packed.data() + header.offset, header.bits, values);
+
+		if (header.scheme == Scheme::FrameOfReference) {
+			for (size_t i = 0; i < BlockSize; ++i)
+				out[i] = T(values[i] + header.reference);
+
+			return;
+		}
+
+#if defined(CONTAINERS_COMPRESSED_SSE2)
+		// Each element is the sum of the one four positions earlier and its difference, so four are computed at once
+		__m128i previous = _mm_set1_epi32(int(header.base));
+		const __m128i reference = _mm_set1_epi32(int(header.reference));
+
+		for (size_t i = 0; i < BlockSize; i += Lanes) {
+			__m128i difference = _mm_load_si128(reinterpret_cast<const __m128i*>(values + i));
+			previous = _mm_add_epi32(previous, _mm_add_epi32(difference, reference));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), previous);
+		}
+#else
+		Word previous[Lanes] = { header.base, header.base, header.base, header.base };
+
+		for (size_t i = 0; i < BlockSize; i += Lanes) {
+			for (size_t lane = 0; lane < Lanes; ++lane) {
+				previous[lane] += values[i + lane] + header.reference;
+				values[i + lane] = previous[lane];
+			}
+		}
+
+		for (size_t i = 0; i < BlockSize; ++i)
+			out[i] = T(values[i]);
+#endif
+	}
+
+	/// Calls function for each element in order, decoding one block at a time
+	template <typename Function>
+	void forEach(Function function) const
+	{
+		alignas(16) T values[BlockSize];
+
+		for (size_t block = 0; block < m_headers.size(); ++block) {
+			decodeBlock(block, values);
+
+			for (size_t i = 0; i < BlockSize; ++i)
+				function(values[i]);
+		}
+
+		for (size_t i = 0; i < m_tail.size(); ++i)
+			function(m_tail[i]);
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(CompressedArray& other) noexcept
+	{
+		m_headers.swap(other.m_headers);
+		m_packed.swap(other.m_packed);
+		m_tail.swap(other.m_tail);
+		std::swap(m_size, other.m_size);
+	}
+
+private:
+	/// Number of bits needed to store value
+	static unsigned bitsFor(Word value) noexcept
+	{
+		unsigned bits = 0;
+
+		while (value) {
+			++bits;
+			value >>= 1;
+		}
+
+		return bits;
+	}
+
+	static Word mask(unsigned bits) noexcept
+	{
+		return bits >= 32 ? ~Word(0) : (Word(1) << bits) - 1;
+	}
+
+	/// Range of the values, interpreted as Compare (a signed or unsigned 32-bit type)
+	template <typename Compare>
+	static void minMax(const Word* values, Word& min, Word& max) noexcept
+	{
+		Compare low = Compare(values[0]);
+		Compare high = low;
+
+		for (size_t i = 1; i < BlockSize; ++i) {
+			low = std::min(low, Compare(values[i]));
+			high = std::max(high, Compare(values[i]));
+		}
+
+		min = Word(low);
+		max = Word(high);
+	}
+
+	void encodeBlock(const T* block)
+	{
+		Word values[BlockSize];
+		Word differences[BlockSize];
+
+		for (size_t i = 0; i < BlockSize; ++i)
+			values[i] = Word(block[i]);
+
+		for (size_t i = 0; i < BlockSize; ++i)
+			differences[i] = values[i] - (i < Lanes ? values[0] : values[i - Lanes]);
+
+		Word min, max, minDifference, maxDifference;
+		minMax<T>(values, min, max);
+		minMax<std::int32_t>(differences, minDifference, maxDifference);
+
+		unsigned bits = bitsFor(max - min);
+		unsigned differenceBits = bitsFor(maxDifference - minDifference);
+
+		// Frame of reference is preferred on a tie, because it allows direct random access
+		BlockHeader header;
+		header.offset = std::uint32_t(m_packed.size());
+		header.base = values[0];
+
+		if (differenceBits < bits) {
+			header.scheme = Scheme::Delta;
+			header.bits = std::uint8_t(differenceBits);
+			header.reference = minDifference;
+
+			for (size_t i = 0; i < BlockSize; ++i)
+				values[i] = differences[i] - minDifference;
+		}
+		else {
+			header.scheme = Scheme::FrameOfReference;
+			header.bits = std::uint8_t(bits);
+			header.reference = min;
+
+			for (size_t i = 0; i < BlockSize; ++i)
+				values[i] -= min;
+		}
+
+		pack(values, header.bits);
+		m_headers.push_back(header);
+	}
+
+	/// Appends Lanes * bits words, which hold the values in vertical layout
+	void pack(const Word* values, unsigned bits)
+	{
+		size_t offset = m_packed.size();
+		m_packed.resize(offset + Lanes * bits);
+		Word* words = m_packed.data() + offset;
+		std::fill_n(words, Lanes * bits, Word(0));
+
+		for (size_t i = 0; i < BlockSize && bits != 0; ++i) {
+			size_t lane = i % Lanes;
+			size_t bit = (i / Lanes) * bits;
+			size_t word = bit / 32;
+			unsigned shift = unsigned(bit % 32);
+
+			words[word * Lanes + lane] |= values[i] << shift;
+
+			if (shift + bits > 32)
+				words[(word + 1) * Lanes + lane] |= values[i] >> (32 - shift);
+		}
+	}
+
+	/// Unpacks the element at position of a block
+	static Word unpackOne(const Word* words, unsigned bits, size_t position) noexcept
+	{
+		if (bits == 0)
+			return 0;
+
+		size_t lane = position % Lanes;
+		size_t bit = (position / Lanes) * bits;
+		size_t word = bit / 32;
+		unsigned shift = unsigned(bit % 32);
+
+		Word value = words[word * Lanes + lane] >> shift;
+
+		if (shift + bits > 32)
+			value |= words[(word + 1) * Lanes + lane] << (32 - shift);
+
+		return value & mask(bits);
+	}
+
+	using Unpacker = void (*)(const Word*, Word*);
+
+	/// Unpacks all elements of a block
+	static void unpackBlock(const Word* words, unsigned bits, Word* out) noexcept
+	{
+		static constexpr std::array<Unpacker, 33> Unpackers = makeUnpackers(std::make_index_sequence<33>());
+		Unpackers[bits](words, out);
+	}
+
+	template <size_t... Bits>
+	static constexpr std::array<Unpacker, sizeof...(Bits)> makeUnpackers(std::index_sequence<Bits...>) noexcept
+	{
+		return { &unpack<unsigned(Bits)>... };
+	}
+
+	///
+	/// Unpacks all elements of a block with a given bit width.
+	/// With the width known at compile time, every shift is a constant, so
+	/// there is a specialization for each width.
+	///
+	template <unsigned Bits>
+	static void unpack(const Word* words, Word* out) noexcept
+	{
+		if constexpr (Bits == 0) {
+			std::fill_n(out, BlockSize, Word(0));
+		}
+		else {
+#if defined(CONTAINERS_COMPRESSED_SSE2)
+			const __m128i* in = reinterpret_cast<const __m128i*>(words);
+			const __m128i valueMask = _mm_set1_epi32(int(mask(Bits)));
+			unpackRows<Bits>(in, out, valueMask, std::make_index_sequence<BlockSize / Lanes>());
+#else
+			for (size_t i = 0; i < BlockSize; ++i)
+				out[i] = unpackOne(words, Bits, i);
+#endif
+		}
+	}
+
+#if defined(CONTAINERS_COMPRESSED_SSE2)
+	/// Unpacks the rows one after the other, with all shifts and offsets known at compile time
+	template <unsigned Bits, size_t... Rows>
+	static void unpackRows(const __m128i* in, Word* out, __m128i valueMask, std::index_sequence<Rows...>) noexcept
+	{
+		(unpackRow<Bits, Rows>(in, out, valueMask), ...);
+	}
+
+	/// Unpacks the elements [4 * Row, 4 * Row + 4). Each 128-bit word holds the next bits of all four lanes.
+	template <unsigned Bits, size_t Row>
+	static void unpackRow(const __m128i* in, Word* out, __m128i valueMask) noexcept
+	{
+		constexpr size_t Index = Row * Bits / 32;
+		constexpr int Shift = int(Row * Bits % 32);
+
+		__m128i value = _mm_srli_epi32(_mm_loadu_si128(in + Index), Shift);
+
+		if constexpr (Shift + Bits > 32)
+			value = _mm_or_si128(value, _mm_slli_epi32(_mm_loadu_si128(in + Index + 1), 32 - Shift));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + Row * Lanes), _mm_and_si128(value, valueMask));
+	}
+#endif
+};
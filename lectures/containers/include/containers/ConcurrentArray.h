@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+///
+/// @brief An append-only array, which can be filled by many threads at the same time.
+///
+/// Each call to push_back() reserves a slot with a single atomic fetch-add
+/// and then constructs the element in it. The elements are stored in
+/// segments: the first one holds FirstSegmentSize elements and every
+/// following one is twice as large as the previous (64, 128, 256, ...).
+/// Growing the array only allocates a new segment. Existing elements are
+/// never moved, so references to them stay valid and readers never observe
+/// a reallocation.
+///
+/// No thread ever waits for another. Threads which need the same new segment
+/// at the same time, each allocate it and all but one discard their copy.
+/// Call reserve() in advance to avoid that cost when many threads append
+/// to a large array.
+///
+/// An element is *published* once the push_back() that stores it has
+/// completed. Any thread may read published elements concurrently with
+/// other threads appending new ones.
+///
+template <typename T>
+class ConcurrentArray {
+public:
+	/// Number of elements in the first segment. Must be a power of two.
+	static constexpr size_t FirstSegmentSize = 64;
+
+private:
+	static constexpr size_t MaxSegments = 48;
+
+	struct Slot {
+		alignas(T) unsigned char storage[sizeof(T)];
+		std::atomic<bool> published{false};
+
+		T& value() noexcept
+		{
+			return *std::launder(reinterpret_cast<T*>(storage));
+		}
+	};
+
+	std::atomic<Slot*> m_segments[MaxSegments] = {};
+	std::atomic<size_t> m_reserved{0};
+
+public:
+	/// Constructs an empty array
+	ConcurrentArray() = default;
+
+	ConcurrentArray(const ConcurrentArray&) = delete;
+	ConcurrentArray& operator=(const ConcurrentArray&) = delete;
+
+	~ConcurrentArray() noexcept
+	{
+		size_t reserved = m_reserved.load(std::memory_order_acquire);
+
+		for (size_t segment = 0; segment < MaxSegments; ++segment) {
+			Slot* slots = m_segments[segment].load(std::memory_order_acquire);
+
+			if ( ! slots)
+				continue;
+
+			size_t begin = segmentBegin(segment);
+			size_t end = begin + segmentSize(segment);
+
+			for (size_t i = begin; i < end && i < reserved; ++i) {
+				if (slots[i - begin].published.load(std::memory_order_acquire))
+					slots[i - begin].value().~T();
+			}
+
+			delete[] slots;
+		}
+	}
+
+	/// Number of slots reserved so far.
+	/// Some of them may still be filled by concurrent calls to push_back().
+	size_t size() const noexcept
+	{
+		return m_reserved.load(std::memory_order_acquire);
+	}
+
+	bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	/// Appends a copy of value and returns its index
+	/// @exception std::bad_alloc Memory allocation failed
+	size_t push_back(const T& value)
+	{
+		return emplace_back(value);
+	}
+
+	/// Appends value and returns its index
+	/// @exception std::bad_alloc Memory allocation failed
+	size_t push_back(T&& value)
+	{
+		return emplace_back(std::move(value));
+	}
+
+	/// Constructs a new element at the end of the array and returns its index.
+	///
+	/// If memory allocation or the constructor of T throws, the reserved slot
+	/// remains unpublished and is skipped by readers.
+	template <typename... Args>
+	size_t emplace_back(Args&&... args)
+	{
+		size_t index = m_reserved.fetch_add(1, std::memory_order_relaxed);
+
+		Slot& slot = slotAt(index, true);
+		new (slot.storage) T(std::forward<Args>(args)...);
+		slot.published.store(true, std::memory_order_release);
+
+		return index;
+	}
+
+	/// Allocates the segments needed to store at least desiredCapacity elements,
+	/// so that the corresponding calls to push_back() do not allocate.
+	/// @exception std::bad_alloc Memory allocation failed
+	void reserve(size_t desiredCapacity)
+	{
+		for (size_t segment = 0; segment < MaxSegments && segmentBegin(segment) < desiredCapacity; ++segment)
+			segmentAt(segment, true);
+	}
+
+	/// Checks whether the element at index has been published
+	bool isPublished(size_t index) const noexcept
+	{
+		if (index >= size())
+			return false;
+
+		const Slot* slot = findSlot(index);
+		return slot && slot->published.load(std::memory_order_acquire);
+	}
+
+	/// Retrieve a published element
+	/// @exception std::out_of_range If the element at index has not been published
+	T& at(size_t index)
+	{
+		if ( ! isPublished(index))
+			throw std::out_of_range("the element at index has not been published");
+
+		return const_cast<Slot*>(findSlot(index))->value();
+	}
+
+	/// Retrieve a published element
+	/// @exception std::out_of_range If the element at index has not been published
+	const T& at(size_t index) const
+	{
+		if ( ! isPublished(index))
+			throw std::out_of_range("the element at index has not been published");
+
+		return const_cast<Slot*>(findSlot(index))->value();
+	}
+
+	/// Retrieve an element, which the caller knows to be published
+	/// (e.g. after joining the threads that appended it)
+	T& operator[](size_t index) noexcept
+	{
+		return const_cast<Slot*>(findSlot(index))->value();
+	}
+
+	/// Retrieve an element, which the caller knows to be published
+	const T& operator[](size_t index) const noexcept
+	{
+		return const_cast<Slot*>(findSlot(index))->value();
+	}
+
+private:
+	/// Index of the segment that stores the element at index
+	static size_t segmentOf(size_t index) noexcept
+	{
+		// Segment k starts at FirstSegmentSize * (2^k - 1), so k = log2(index / FirstSegmentSize + 1)
+		size_t scaled = index / FirstSegmentSize + 1;
+
+#if defined(__GNUC__)
+		return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(scaled);
+#else
+		size_t segment = 0;
+
+		while (scaled >>= 1)
+			++segment;
+
+		return segment;
+#endif
+	}
+
+	static size_t segmentBegin(size_t segment) noexcept
+	{
+		return FirstSegmentSize * ((size_t(1) << segment) - 1);
+	}
+
+	static size_t segmentSize(size_t segment) noexcept
+	{
+		return FirstSegmentSize << segment;
+	}
+
+	/// Retrieves a segment, optionally allocating it if it does not exist yet
+	Slot* segmentAt(size_t segment, bool allocate)
+	{
+		Slot* slots = m_segments[segment].load(std::memory_order_acquire);
+
+		if (slots || ! allocate)
+			return slots;
+
+		// Several threads may try to allocate the same segment.
+		// Only one of them wins, the others discard their allocations.
+		Slot* allocated = new Slot[segmentSize(segment)];
+
+		if (m_segments[segment].compare_exchange_strong(slots, allocated, std::memory_order_acq_rel, std::memory_order_acquire))
+			return allocated;
+
+		delete[] allocated;
+		return slots;
+	}
+
+	Slot& slotAt(size_t index, bool allocate)
+	{
+		size_t segment = segmentOf(index);
+		return segmentAt(segment, allocate)[index - segmentBegin(segment)];
+	}
+
+	const Slot* findSlot(size_t index) const noexcept
+	{
+		size_t segment = segmentOf(index);
+		const Slot* slots = m_segments[segment].load(std::memory_order_acquire);
+		return slots ? slots + (index - segmentBegin(segment)) : nullptr;
+	}
+};
@@ -2,12 +2,16 @@
 
 #include "FixedSizeArray.h"
 
-template <typename T>
+template <typename T, typename Allocation = DefaultAllocation>
 class DynamicArray {
 
-	FixedSizeArray<T> m_data;
+	FixedSizeArray<T, Allocation> m_data;
 	size_t m_used = 0;
 
+	/// Whether the buffer can be resized in place by the allocation policy (e.g. RemappableAllocation),
+	/// instead of being copied into a new one
+	static constexpr bool canReallocate = std::is_trivially_copyable_v<T> && CanReallocate<Allocation>::value;
+
 public:
 
 	/// Thrown when an operation, that requires the array to have at least one element,
@@ -23,23 +27,28 @@ public:
 	/// Constructs an empty array with zero capacity
 	DynamicArray() = default;
 
+	/// Constructs an empty array with zero capacity, which obtains its memory from allocation
+	explicit DynamicArray(const Allocation& allocation)
+		: m_data(0, allocation)
+	{}
+
 	/// Constructs an array with size and capacity equal to initialSize
 	/// @exception std::bad_alloc Memory allocation failed
-	DynamicArray(size_t initialCapacity)
-		: m_data(initialCapacity), m_used(initialCapacity)
+	DynamicArray(size_t initialCapacity, const Allocation& allocation = Allocation())
+		: m_data(initialCapacity, allocation), m_used(initialCapacity)
 	{}
 
 	DynamicArray(const DynamicArray&) = default;
 	DynamicArray& operator=(const DynamicArray&) = default;
 	
-	DynamicArray(DynamicArray&& other)
+	DynamicArray(DynamicArray&& other) noexcept
 		: m_data(std::move(other.m_data))
 	{
 		m_used = other.m_used;
 		other.m_used = 0;
 	}
 
-	DynamicArray& operator=(DynamicArray&& other)
+	DynamicArray& operator=(DynamicArray&& other) noexcept
 	{
 		if (this != &other) {
 			m_data = std::move(other.m_data);
@@ -61,29 +70,45 @@ public:
 	}
 
 	/// Retrieve the element at index 
-	/// @exception std::out_of_range If the index is out of the bounds of the array 
+	/// @exception std::out_of_range If the index is not less than size()
 	T& at(size_t index)
 	{
-		return m_data.at(index);
+		if (index >= m_used)
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return m_data.data()[index];
 	}
 
 	/// Retrieve the element at index 
-	/// @exception std::out_of_range If the index is out of the bounds of the array 
+	/// @exception std::out_of_range If the index is not less than size()
 	const T& at(size_t index) const
 	{
-		return m_data.at(index);
+		if (index >= m_used)
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return m_data.data()[index];
 	}
 
-	/// Retrieve the element at index 
+	/// Retrieve the element at index.
+	/// The index is only checked if CONTAINERS_CHECKED_ACCESS is enabled (see CheckedAccess.h).
 	T& operator[](size_t index)
 	{
-		return m_data[index];
+		CONTAINERS_CHECK_INDEX(index, m_used);
+		return m_data.data()[index];
 	}
 	
-	/// Retrieve the element at index 
+	/// Retrieve the element at index.
+	/// The index is only checked if CONTAINERS_CHECKED_ACCESS is enabled (see CheckedAccess.h).
 	const T& operator[](size_t index) const
 	{
-		return m_data[index];
+		CONTAINERS_CHECK_INDEX(index, m_used);
+		return m_data.data()[index];
+	}
+
+	/// The allocation policy, which provides the memory for the elements
+	const Allocation& allocation() const noexcept
+	{
+		return m_data.allocation();
 	}
 
 	/// Retrieve the underlying buffer
@@ -105,6 +130,13 @@ public:
 		m_data[m_used++] = value;
 	}
 
+	/// Append value to the array, moving it into the buffer
+	void push_back(T&& value)
+	{
+		reserve(m_used + 1);
+		m_data[m_used++] = std::move(value);
+	}
+
 	/// Remove the last element from the array
 	void pop_back()
 	{
@@ -121,10 +153,15 @@ public:
 			return;
 
 		size_t newCapacity = std::max(desiredCapacity, capacity() * 2);
-		
-		FixedSizeArray<T> buffer(newCapacity);
-		buffer.fillFrom(m_data);
-		m_data = std::move(buffer);
+
+		if constexpr (canReallocate) {
+			m_data.reallocate(newCapacity);
+		}
+		else {
+			FixedSizeArray<T, Allocation> buffer(newCapacity, m_data.allocation());
+			transferElements(m_data.size(), buffer);
+			m_data = std::move(buffer);
+		}
 	}
 	
 	/// Set the size of the array to a specific value.
@@ -137,9 +174,14 @@ public:
 	/// If possible, reduce the memory used by the array
 	void shrink_to_fit()
 	{
-		FixedSizeArray<T> buffer(m_used);
-		buffer.fillFrom(m_data);
-		m_data = std::move(buffer);
+		if constexpr (canReallocate) {
+			m_data.reallocate(m_used);
+		}
+		else {
+			FixedSizeArray<T, Allocation> buffer(m_used, m_data.allocation());
+			transferElements(m_used, buffer);
+			m_data = std::move(buffer);
+		}
 	}
 
 	/// Quickly swaps the contents of this object with that of another
@@ -148,4 +190,29 @@ public:
 		m_data.swap(other.m_data);
 		std::swap(m_used, other.m_used);
 	}
+
+	///
+	/// @brief Checks whether two arrays have the same size and contain the same sequence of elements
+	///
+	/// The capacities of the arrays are not compared.
+	/// The elements of the array must be comparable with `==`.
+	///
+	bool operator==(const DynamicArray& other) const
+	{
+		return m_used == other.m_used && std::equal(data(), data() + m_used, other.data());
+	}
+
+private:
+	///
+	/// @brief Transfers the first count elements to buffer, which is about to replace the current one
+	///
+	/// The old buffer is discarded, so the elements are moved rather than copied.
+	/// If moving an element might throw, it is copied instead, so that the array
+	/// remains unchanged when a copy fails (strong exception safety).
+	///
+	void transferElements(size_t count, FixedSizeArray<T, Allocation>& buffer)
+	{
+		for (size_t i = 0; i < count; ++i)
+			buffer.data()[i] = std::move_if_noexcept(m_data.data()[i]);
+	}
 };
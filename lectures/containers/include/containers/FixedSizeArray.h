@@ -1,7 +1,27 @@
 #pragma once
 
-template <typename T>
-class FixedSizeArray {
+#include "Allocation.h"
+#include "CheckedAccess.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+///
+/// @brief An array, whose size is set when it is created.
+///
+/// The memory for the elements is obtained from an allocation policy
+/// (see Allocation.h). By default it is allocated with operator new,
+/// but it can also be aligned to a cache line or backed by huge pages.
+/// The elements are default-initialized, just like with `new T[size]`.
+///
+template <typename T, typename Allocation = DefaultAllocation>
+class FixedSizeArray : private Allocation {
 	T* m_data = nullptr;
 	size_t m_size = 0;
 
@@ -12,10 +32,11 @@ public:
 
 	/// Creates an array with a specified size
 	/// @exception std::bad_alloc if memory allocation fails
-	FixedSizeArray(size_t size)
+	FixedSizeArray(size_t size, const Allocation& allocation = Allocation())
+		: Allocation(allocation)
 	{
 		if (size != 0) {
-			m_data = new T[size];
+			m_data = allocateElements(size);
 			m_size = size;
 		}
 	}
@@ -25,17 +46,18 @@ public:
 	/// 
 	/// The function copies min(size(), other.size()) elements
 	/// 
-	void fillFrom(const FixedSizeArray& other)
+	template <typename OtherAllocation>
+	void fillFrom(const FixedSizeArray<T, OtherAllocation>& other)
 	{
 		size_t limit = std::min(size(), other.size());
 			
 		for (size_t i = 0; i < limit; ++i)
-			m_data[i] = other.m_data[i];
+			m_data[i] = other[i];
 	}
 
 	/// Creates a copy of another array
 	FixedSizeArray(const FixedSizeArray& other)
-		: FixedSizeArray(other.m_size)
+		: FixedSizeArray(other.m_size, other.allocation())
 	{
 		fillFrom(other);
 	}
@@ -65,7 +87,10 @@ public:
 
 	~FixedSizeArray() noexcept
 	{
-		delete [] m_data;
+		if (m_data) {
+			std::destroy_n(m_data, m_size);
+			Allocation::deallocate(m_data, m_size * sizeof(T), alignof(T));
+		}
 	}
 
 	size_t size() const noexcept
@@ -78,6 +103,12 @@ public:
 		return m_size == 0;
 	}
 
+	/// The allocation policy, which provides the memory for the elements
+	const Allocation& allocation() const noexcept
+	{
+		return *this;
+	}
+
 	T* data() noexcept
 	{
 		return m_data;
@@ -104,18 +135,58 @@ public:
 		return m_data[index];
 	}
 
+	/// Retrieve the element at index.
+	/// The index is only checked if CONTAINERS_CHECKED_ACCESS is enabled (see CheckedAccess.h).
 	T& operator[](size_t index) noexcept
 	{
+		CONTAINERS_CHECK_INDEX(index, m_size);
 		return m_data[index];
 	}
 
+	/// Retrieve the element at index.
+	/// The index is only checked if CONTAINERS_CHECKED_ACCESS is enabled (see CheckedAccess.h).
 	const T& operator[](size_t index) const noexcept
 	{
+		CONTAINERS_CHECK_INDEX(index, m_size);
 		return m_data[index];
 	}
 
+	///
+	/// @brief Changes the size of the array with the reallocate() of the allocation policy
+	///
+	/// The first min(size(), newSize) elements keep their values and any new
+	/// elements are default-initialized. Pointers to the elements are invalidated.
+	/// Only available for trivially copyable elements, which can be moved
+	/// bytewise, and policies, which provide reallocate() (see Allocation.h).
+	///
+	/// @exception std::bad_alloc The buffer cannot be resized. The array is unchanged.
+	///
+	void reallocate(size_t newSize)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "reallocate() moves the elements bytewise");
+		static_assert(CanReallocate<Allocation>::value, "The allocation policy does not provide reallocate()");
+
+		if (newSize == 0 || m_data == nullptr) {
+			FixedSizeArray buffer(newSize, allocation());
+			std::copy_n(m_data, std::min(m_size, newSize), buffer.m_data);
+			swap(buffer);
+			return;
+		}
+
+		if (newSize > std::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_array_new_length();
+
+		m_data = static_cast<T*>(Allocation::reallocate(m_data, m_size * sizeof(T), newSize * sizeof(T), alignof(T)));
+
+		if (newSize > m_size)
+			std::uninitialized_default_construct_n(m_data + m_size, newSize - m_size);
+
+		m_size = newSize;
+	}
+
 	void swap(FixedSizeArray& other) noexcept
 	{
+		std::swap(static_cast<Allocation&>(*this), static_cast<Allocation&>(other));
 		std::swap(m_data, other.m_data);
 		std::swap(m_size, other.m_size);
 	}
@@ -137,4 +208,24 @@ public:
 
 		return true;
 	}
+
+private:
+	/// Allocates memory for size elements and default-initializes them
+	T* allocateElements(size_t size)
+	{
+		if (size > std::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_array_new_length();
+
+		T* data = static_cast<T*>(Allocation::allocate(size * sizeof(T), alignof(T)));
+
+		try {
+			std::uninitialized_default_construct_n(data, size);
+		}
+		catch (...) {
+			Allocation::deallocate(data, size * sizeof(T), alignof(T));
+			throw;
+		}
+
+		return data;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,285 @@
+#pragma once
+
+#include "FixedSizeArray.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+///
+/// @brief An array with fast insertion and removal of elements near a cursor.
+///
+/// The elements are stored in a single buffer with a *gap* of unused slots at
+/// the cursor: the elements before the cursor are at the beginning of the
+/// buffer, the ones after it at the end. Inserting at the cursor fills the
+/// first slot of the gap and erasing next to it widens the gap, so both are
+/// O(1). Moving the cursor by d positions moves d elements across the gap.
+/// Edits clustered around a position, as in a text editor, are therefore
+/// amortized O(1), where DynamicArray would shift the whole tail each time.
+///
+/// When the gap is used up, the buffer doubles its capacity.
+///
+template <typename T>
+class GapBuffer {
+public:
+	/// Capacity of the buffer allocated by the first insertion
+	static constexpr size_t MinCapacity = 16;
+
+	/// Thrown when an operation, that requires the array to have at least one element,
+	/// was performed on an empty array.
+	class EmptyArrayException : public std::logic_error {
+	public:
+		EmptyArrayException()
+			: std::logic_error("Operation was performed on an empty array")
+		{}
+	};
+
+private:
+	FixedSizeArray<T> m_buffer;
+	size_t m_gapBegin = 0;
+	size_t m_gapEnd = 0;
+
+public:
+	/// Constructs an empty array with zero capacity
+	GapBuffer() = default;
+
+	GapBuffer(const GapBuffer&) = default;
+	GapBuffer& operator=(const GapBuffer&) = default;
+
+	/// Takes over the buffer of other, which is left empty with zero capacity
+	GapBuffer(GapBuffer&& other) noexcept
+		: m_buffer(std::move(other.m_buffer)),
+		  m_gapBegin(std::exchange(other.m_gapBegin, 0)),
+		  m_gapEnd(std::exchange(other.m_gapEnd, 0))
+	{}
+
+	GapBuffer& operator=(GapBuffer&& other) noexcept
+	{
+		if (this != &other) {
+			m_buffer = std::move(other.m_buffer);
+			m_gapBegin = std::exchange(other.m_gapBegin, 0);
+			m_gapEnd = std::exchange(other.m_gapEnd, 0);
+		}
+
+		return *this;
+	}
+
+	/// Number of elements in the array
+	size_t size() const noexcept
+	{
+		return m_buffer.size() - gapSize();
+	}
+
+	bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	/// Number of elements the array can hold without reallocating
+	size_t capacity() const noexcept
+	{
+		return m_buffer.size();
+	}
+
+	/// Position of the cursor: the index, at which insert() places the next element
+	size_t cursor() const noexcept
+	{
+		return m_gapBegin;
+	}
+
+	/// Moves the cursor to position, which may be equal to size()
+	/// @exception std::out_of_range If position is greater than size()
+	void moveCursor(size_t position)
+	{
+		if (position > size())
+			throw std::out_of_range("the position is out of the bounds of the array");
+
+		if (position < m_gapBegin) {
+			// The elements in [position, gapBegin) move to the end of the gap
+			size_t count = m_gapBegin - position;
+			std::move_backward(m_buffer.data() + position, m_buffer.data() + m_gapBegin, m_buffer.data() + m_gapEnd);
+			m_gapBegin -= count;
+			m_gapEnd -= count;
+		}
+		else if (position > m_gapBegin) {
+			// The elements after the gap move to its beginning
+			size_t count = position - m_gapBegin;
+			std::move(m_buffer.data() + m_gapEnd, m_buffer.data() + m_gapEnd + count, m_buffer.data() + m_gapBegin);
+			m_gapBegin += count;
+			m_gapEnd += count;
+		}
+	}
+
+	/// Retrieve the element at index
+	T& operator[](size_t index)
+	{
+		return m_buffer[physicalIndex(index)];
+	}
+
+	/// Retrieve the element at index
+	const T& operator[](size_t index) const
+	{
+		return m_buffer[physicalIndex(index)];
+	}
+
+	/// Retrieve the element at index
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	T& at(size_t index)
+	{
+		checkIndex(index);
+		return (*this)[index];
+	}
+
+	/// Retrieve the element at index
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	const T& at(size_t index) const
+	{
+		checkIndex(index);
+		return (*this)[index];
+	}
+
+	/// Insert value at the cursor and advance the cursor past it
+	/// @exception std::bad_alloc Memory allocation failed
+	void insert(const T& value)
+	{
+		ensureGap();
+		m_buffer[m_gapBegin++] = value;
+	}
+
+	/// Insert value at the cursor and advance the cursor past it
+	/// @exception std::bad_alloc Memory allocation failed
+	void insert(T&& value)
+	{
+		ensureGap();
+		m_buffer[m_gapBegin++] = std::move(value);
+	}
+
+	/// Move the cursor to index and insert value there
+	/// @exception std::out_of_range If index is greater than size()
+	/// @exception std::bad_alloc Memory allocation failed
+	void insert(size_t index, const T& value)
+	{
+		moveCursor(index);
+		insert(value);
+	}
+
+	/// Remove the element in front of the cursor, like the backspace key
+	/// @exception EmptyArrayException There is no element in front of the cursor
+	void eraseBefore()
+	{
+		if (m_gapBegin == 0)
+			throw EmptyArrayException();
+
+		release(--m_gapBegin);
+	}
+
+	/// Remove the element after the cursor, like the delete key
+	/// @exception EmptyArrayException There is no element after the cursor
+	void eraseAfter()
+	{
+		if (m_gapEnd == m_buffer.size())
+			throw EmptyArrayException();
+
+		release(m_gapEnd++);
+	}
+
+	/// Move the cursor to index and remove the element there
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	void erase(size_t index)
+	{
+		checkIndex(index);
+		moveCursor(index);
+		eraseAfter();
+	}
+
+	/// Append value to the array. The cursor moves to the end.
+	/// @exception std::bad_alloc Memory allocation failed
+	void push_back(const T& value)
+	{
+		moveCursor(size());
+		insert(value);
+	}
+
+	/// Remove the last element from the array. The cursor moves to the end.
+	/// @exception EmptyArrayException The array is empty
+	void pop_back()
+	{
+		if (empty())
+			throw EmptyArrayException();
+
+		moveCursor(size());
+		eraseBefore();
+	}
+
+	/// Ensure the array can hold at least desiredCapacity elements without reallocating
+	/// @exception std::bad_alloc Memory allocation failed
+	void reserve(size_t desiredCapacity)
+	{
+		if (desiredCapacity > capacity())
+			reallocate(desiredCapacity);
+	}
+
+	/// Calls function for each element in order, skipping the gap
+	template <typename Function>
+	void forEach(Function function) const
+	{
+		for (size_t i = 0; i < m_gapBegin; ++i)
+			function(m_buffer[i]);
+
+		for (size_t i = m_gapEnd; i < m_buffer.size(); ++i)
+			function(m_buffer[i]);
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(GapBuffer& other) noexcept
+	{
+		m_buffer.swap(other.m_buffer);
+		std::swap(m_gapBegin, other.m_gapBegin);
+		std::swap(m_gapEnd, other.m_gapEnd);
+	}
+
+private:
+	size_t gapSize() const noexcept
+	{
+		return m_gapEnd - m_gapBegin;
+	}
+
+	size_t physicalIndex(size_t index) const noexcept
+	{
+		return index < m_gapBegin ? index : index + gapSize();
+	}
+
+	void checkIndex(size_t index) const
+	{
+		if (index >= size())
+			throw std::out_of_range("index is out of the bounds of the array");
+	}
+
+	/// The slot became part of the gap, so release the resources held by its element
+	void release(size_t slot)
+	{
+		if constexpr ( ! std::is_trivially_destructible_v<T>)
+			m_buffer[slot] = T();
+	}
+
+	void ensureGap()
+	{
+		if (m_gapBegin == m_gapEnd)
+			reallocate(std::max(MinCapacity, 2 * capacity()));
+	}
+
+	/// Moves the elements to a new buffer, keeping the gap at the cursor
+	void reallocate(size_t newCapacity)
+	{
+		FixedSizeArray<T> buffer(newCapacity);
+		size_t after = m_buffer.size() - m_gapEnd;
+
+		std::move(m_buffer.data(), m_buffer.data() + m_gapBegin, buffer.data());
+		std::move(m_buffer.data() + m_gapEnd, m_buffer.data() + m_buffer.size(), buffer.data() + newCapacity - after);
+
+		m_gapEnd = newCapacity - after;
+		m_buffer = std::move(buffer);
+	}
+};
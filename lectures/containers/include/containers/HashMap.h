@@ -0,0 +1,607 @@
+#pragma once
+
+#include "FixedSizeArray.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define CONTAINERS_HASHMAP_SSE2
+	#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+///
+/// @brief A hash function for strings, which also accepts string views and C strings.
+///
+/// Use it together with std::equal_to<> to look up std::string keys
+/// without constructing a temporary string.
+///
+struct TransparentStringHash {
+	using is_transparent = void;
+
+	size_t operator()(std::string_view text) const noexcept
+	{
+		return std::hash<std::string_view>()(text);
+	}
+};
+
+///
+/// @brief A hash map with open addressing and SIMD probing, in the style of SwissTable.
+///
+/// The entries are stored in a flat FixedSizeArray of slots. A second array
+/// holds one control byte per slot: it tells whether the slot is empty,
+/// deleted, or full, and in the last case also holds 7 bits of the key's hash.
+/// A lookup loads a group of 16 control bytes and compares all of them to the
+/// hash bits at once (with SSE2 where available), so most keys are found, or
+/// found missing, after inspecting a single group and comparing a single key.
+///
+/// The capacity is a power of two and the table is grown when it is 7/8 full.
+/// reserve() sizes the table up front, so that inserting the reserved number
+/// of entries causes no rehash.
+///
+/// If both Hash and Equal define is_transparent, find(), contains(), at()
+/// and erase() accept any type that they can hash and compare with a Key.
+///
+/// Key and Value must be default-constructible, like all elements of a FixedSizeArray.
+/// Pointers returned by find() remain valid until the table is rehashed.
+///
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class HashMap {
+public:
+	/// Number of control bytes probed together
+	static constexpr size_t GroupSize = 16;
+
+private:
+	using Control = std::int8_t;
+
+	static constexpr Control Empty = -128;
+	static constexpr Control Deleted = -2;
+
+	struct Slot {
+		Key key;
+		Value value;
+	};
+
+	/// A bit set with one bit for each control byte of a group
+	class Mask {
+		std::uint32_t m_bits;
+
+	public:
+		explicit Mask(std::uint32_t bits) noexcept
+			: m_bits(bits)
+		{}
+
+		explicit operator bool() const noexcept
+		{
+			return m_bits != 0;
+		}
+
+		/// Index of the lowest set bit. The mask must not be empty.
+		size_t lowest() const noexcept
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, m_bits);
+			return index;
+#else
+			return static_cast<size_t>(__builtin_ctz(m_bits));
+#endif
+		}
+
+		/// Index of the highest set bit. The mask must not be empty.
+		size_t highest() const noexcept
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanReverse(&index, m_bits);
+			return index;
+#else
+			return static_cast<size_t>(31 - __builtin_clz(m_bits));
+#endif
+		}
+
+		void clearLowest() noexcept
+		{
+			m_bits &= m_bits - 1;
+		}
+	};
+
+	/// GroupSize consecutive control bytes
+	class Group {
+#if defined(CONTAINERS_HASHMAP_SSE2)
+		__m128i m_bytes;
+
+	public:
+		explicit Group(const Control* control) noexcept
+			: m_bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)))
+		{}
+
+		Mask match(Control h2) const noexcept
+		{
+			return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_bytes, _mm_set1_epi8(h2)))));
+		}
+
+		Mask matchEmpty() const noexcept
+		{
+			return match(Empty);
+		}
+
+		/// Empty and deleted bytes are the only negative ones
+		Mask matchEmptyOrDeleted() const noexcept
+		{
+			return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(m_bytes)));
+		}
+#else
+		Control m_bytes[GroupSize];
+
+	public:
+		explicit Group(const Control* control) noexcept
+		{
+			std::memcpy(m_bytes, control, GroupSize);
+		}
+
+		Mask match(Control h2) const noexcept
+		{
+			std::uint32_t bits = 0;
+
+			for (size_t i = 0; i < GroupSize; ++i)
+				bits |= std::uint32_t(m_bytes[i] == h2) << i;
+
+			return Mask(bits);
+		}
+
+		Mask matchEmpty() const noexcept
+		{
+			return match(Empty);
+		}
+
+		Mask matchEmptyOrDeleted() const noexcept
+		{
+			std::uint32_t bits = 0;
+
+			for (size_t i = 0; i < GroupSize; ++i)
+				bits |= std::uint32_t(m_bytes[i] < 0) << i;
+
+			return Mask(bits);
+		}
+#endif
+	};
+
+	template <typename T, typename = void>
+	struct IsTransparent : std::false_type {};
+
+	template <typename T>
+	struct IsTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+	static constexpr bool IsHeterogeneous = IsTransparent<Hash>::value && IsTransparent<Equal>::value;
+
+	/// Without transparent functors, a lookup key is converted to a Key first
+	template <typename K>
+	static constexpr bool IsLookupKey = IsHeterogeneous || std::is_convertible_v<const K&, Key>;
+
+	/// One control byte per slot, followed by copies of the first GroupSize bytes.
+	/// The copies let a group, which starts near the end, be loaded in one piece.
+	FixedSizeArray<Control> m_control;
+	FixedSizeArray<Slot> m_slots;
+	size_t m_size = 0;
+	size_t m_deleted = 0;
+	Hash m_hash;
+	Equal m_equal;
+
+public:
+	/// Constructs an empty map, which does not allocate memory
+	HashMap() = default;
+
+	HashMap(const HashMap&) = default;
+	HashMap& operator=(const HashMap&) = default;
+
+	/// Takes over the entries of other, which is left empty with zero capacity
+	HashMap(HashMap&& other) noexcept
+		: m_control(std::move(other.m_control)),
+		  m_slots(std::move(other.m_slots)),
+		  m_size(std::exchange(other.m_size, 0)),
+		  m_deleted(std::exchange(other.m_deleted, 0)),
+		  m_hash(std::move(other.m_hash)),
+		  m_equal(std::move(other.m_equal))
+	{}
+
+	HashMap& operator=(HashMap&& other) noexcept
+	{
+		if (this != &other) {
+			m_control = std::move(other.m_control);
+			m_slots = std::move(other.m_slots);
+			m_size = std::exchange(other.m_size, 0);
+			m_deleted = std::exchange(other.m_deleted, 0);
+			m_hash = std::move(other.m_hash);
+			m_equal = std::move(other.m_equal);
+		}
+
+		return *this;
+	}
+
+	/// Number of entries in the map
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/// Number of slots in the table
+	size_t capacity() const noexcept
+	{
+		return m_slots.size();
+	}
+
+	/// Ratio of the used slots to all slots
+	double loadFactor() const noexcept
+	{
+		return capacity() ? static_cast<double>(m_size) / capacity() : 0.0;
+	}
+
+	/// Maximum number of entries, which the table can hold before it is grown
+	size_t maxEntries() const noexcept
+	{
+		return capacity() - capacity() / 8;
+	}
+
+	/// Ensure that the map can hold at least count entries without a rehash
+	/// @exception std::bad_alloc Memory allocation failed. The map remains unchanged.
+	void reserve(size_t count)
+	{
+		if (count <= maxEntries() - std::min(maxEntries(), m_deleted))
+			return;
+
+		size_t newCapacity = GroupSize;
+
+		while (newCapacity - newCapacity / 8 < count)
+			newCapacity *= 2;
+
+		rehash(std::max(newCapacity, capacity()));
+	}
+
+	/// Removes all entries. The capacity does not change.
+	void clear()
+	{
+		for (size_t i = 0; i < m_control.size(); ++i)
+			m_control[i] = Empty;
+
+		for (size_t i = 0; i < m_slots.size(); ++i)
+			m_slots[i] = Slot();
+
+		m_size = 0;
+		m_deleted = 0;
+	}
+
+	///
+	/// Adds an entry, unless the key is already in the map
+	///
+	/// @return true if the entry was added, false if the key was already present
+	/// @exception std::bad_alloc Memory allocation failed
+	///
+	bool insert(const Key& key, const Value& value)
+	{
+		auto [slot, hash, inserted] = findOrPrepareInsert(key);
+
+		if (inserted) {
+			m_slots[slot].key = key;
+			m_slots[slot].value = value;
+			claimSlot(slot, hash);
+		}
+
+		return inserted;
+	}
+
+	///
+	/// Adds an entry or, if the key is already present, replaces its value
+	///
+	/// @return true if the entry was added, false if an existing value was replaced
+	/// @exception std::bad_alloc Memory allocation failed
+	///
+	bool insertOrAssign(const Key& key, const Value& value)
+	{
+		auto [slot, hash, inserted] = findOrPrepareInsert(key);
+
+		if (inserted)
+			m_slots[slot].key = key;
+
+		m_slots[slot].value = value;
+
+		if (inserted)
+			claimSlot(slot, hash);
+
+		return inserted;
+	}
+
+	/// Retrieves the value for key, adding a default-constructed one if the key is not present
+	/// @exception std::bad_alloc Memory allocation failed
+	Value& operator[](const Key& key)
+	{
+		auto [slot, hash, inserted] = findOrPrepareInsert(key);
+
+		if (inserted) {
+			m_slots[slot].key = key;
+			m_slots[slot].value = Value();
+			claimSlot(slot, hash);
+		}
+
+		return m_slots[slot].value;
+	}
+
+	/// Retrieves the value for key or nullptr if the key is not present
+	template <typename K, typename = std::enable_if_t<IsLookupKey<K>>>
+	Value* find(const K& key)
+	{
+		size_t slot = findSlot(key);
+		return slot != NotFound ? &m_slots[slot].value : nullptr;
+	}
+
+	/// Retrieves the value for key or nullptr if the key is not present
+	template <typename K, typename = std::enable_if_t<IsLookupKey<K>>>
+	const Value* find(const K& key) const
+	{
+		size_t slot = findSlot(key);
+		return slot != NotFound ? &m_slots[slot].value : nullptr;
+	}
+
+	template <typename K, typename = std::enable_if_t<IsLookupKey<K>>>
+	bool contains(const K& key) const
+	{
+		return findSlot(key) != NotFound;
+	}
+
+	/// @exception std::out_of_range If the key is not present
+	template <typename K, typename = std::enable_if_t<IsLookupKey<K>>>
+	Value& at(const K& key)
+	{
+		Value* value = find(key);
+
+		if ( ! value)
+			throw std::out_of_range("the key is not present in the map");
+
+		return *value;
+	}
+
+	/// @exception std::out_of_range If the key is not present
+	template <typename K, typename = std::enable_if_t<IsLookupKey<K>>>
+	const Value& at(const K& key) const
+	{
+		const Value* value = find(key);
+
+		if ( ! value)
+			throw std::out_of_range("the key is not present in the map");
+
+		return *value;
+	}
+
+	///
+	/// Removes the entry with the given key
+	///
+	/// @return true if an entry was removed
+	///
+	template <typename K, typename = std::enable_if_t<IsLookupKey<K>>>
+	bool erase(const K& key)
+	{
+		size_t slot = findSlot(key);
+
+		if (slot == NotFound)
+			return false;
+
+		// A probe continues past a group only if the group has no empty byte.
+		// If every group containing the slot has one, no probe has ever passed
+		// the slot, so it can become empty instead of deleted.
+		Mask emptyAfter = Group(&m_control[slot]).matchEmpty();
+		Mask emptyBefore = Group(&m_control[(slot - GroupSize) & mask()]).matchEmpty();
+		bool canBeEmpty =
+			emptyAfter && emptyBefore &&
+			emptyAfter.lowest() + (GroupSize - 1 - emptyBefore.highest()) < GroupSize;
+
+		setControl(slot, canBeEmpty ? Empty : Deleted);
+		m_slots[slot] = Slot();
+
+		--m_size;
+
+		if ( ! canBeEmpty)
+			++m_deleted;
+
+		return true;
+	}
+
+	/// Calls visit(key, value) for every entry, in no particular order
+	template <typename Visitor>
+	void forEach(Visitor&& visit) const
+	{
+		for (size_t i = 0; i < capacity(); ++i) {
+			if (m_control[i] >= 0)
+				visit(m_slots[i].key, m_slots[i].value);
+		}
+	}
+
+	void swap(HashMap& other) noexcept
+	{
+		m_control.swap(other.m_control);
+		m_slots.swap(other.m_slots);
+		std::swap(m_size, other.m_size);
+		std::swap(m_deleted, other.m_deleted);
+		std::swap(m_hash, other.m_hash);
+		std::swap(m_equal, other.m_equal);
+	}
+
+private:
+	static constexpr size_t NotFound = static_cast<size_t>(-1);
+
+	size_t mask() const noexcept
+	{
+		return capacity() - 1;
+	}
+
+	/// Hashes a key and mixes the bits, so that hash functions like std::hash<int>,
+	/// which return the key itself, also spread the keys over the whole table
+	template <typename K>
+	size_t hashOf(const K& key) const
+	{
+		std::uint64_t hash = static_cast<std::uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(hash ^ (hash >> 32));
+	}
+
+	/// The upper bits of the hash select where to start probing
+	static size_t h1(size_t hash) noexcept
+	{
+		return hash >> 7;
+	}
+
+	/// The lowest 7 bits of the hash are stored in the control byte
+	static Control h2(size_t hash) noexcept
+	{
+		return static_cast<Control>(hash & 0x7F);
+	}
+
+	void setControl(size_t slot, Control value) noexcept
+	{
+		m_control[slot] = value;
+
+		if (slot < GroupSize)
+			m_control[capacity() + slot] = value;
+	}
+
+	template <typename K>
+	size_t findSlot(const K& key) const
+	{
+		if constexpr (IsHeterogeneous || std::is_same_v<K, Key>)
+			return probe(key);
+		else
+			return probe(static_cast<Key>(key));
+	}
+
+	/// Follows the probe sequence of key until it finds the key or an empty byte
+	template <typename K>
+	size_t probe(const K& key) const
+	{
+		if (m_size == 0)
+			return NotFound;
+
+		size_t hash = hashOf(key);
+		size_t position = h1(hash) & mask();
+
+		// Triangular probing over groups visits every group of a power-of-two table
+		for (size_t step = GroupSize; ; step += GroupSize) {
+			Group group(&m_control[position]);
+
+			for (Mask match = group.match(h2(hash)); match; match.clearLowest()) {
+				size_t slot = (position + match.lowest()) & mask();
+
+				if (m_equal(m_slots[slot].key, key))
+					return slot;
+			}
+
+			if (group.matchEmpty())
+				return NotFound;
+
+			position = (position + step) & mask();
+		}
+	}
+
+	/// Finds the first empty or deleted slot in the probe sequence for hash
+	size_t findFreeSlot(size_t hash) const noexcept
+	{
+		size_t position = h1(hash) & mask();
+
+		for (size_t step = GroupSize; ; step += GroupSize) {
+			Mask free = Group(&m_control[position]).matchEmptyOrDeleted();
+
+			if (free)
+				return (position + free.lowest()) & mask();
+
+			position = (position + step) & mask();
+		}
+	}
+
+	/// The result of findOrPrepareInsert()
+	struct InsertPosition {
+		size_t slot;
+		size_t hash;
+		bool inserted;
+	};
+
+	/// Finds the slot of key or, if it is not present, a free slot for it.
+	/// The free slot is not claimed yet. The caller stores the entry in it first
+	/// and then calls claimSlot(), so an exception thrown while copying the key
+	/// or the value leaves the map unchanged.
+	InsertPosition findOrPrepareInsert(const Key& key)
+	{
+		size_t slot = findSlot(key);
+
+		if (slot != NotFound)
+			return { slot, 0, false };
+
+		if (m_size + m_deleted >= maxEntries())
+			grow();
+
+		size_t hash = hashOf(key);
+		return { findFreeSlot(hash), hash, true };
+	}
+
+	/// Marks a free slot, which already stores a new entry, as used
+	void claimSlot(size_t slot, size_t hash) noexcept
+	{
+		if (m_control[slot] == Deleted)
+			--m_deleted;
+
+		setControl(slot, h2(hash));
+		++m_size;
+	}
+
+	void grow()
+	{
+		// If most of the used slots are deleted, rehashing at the same capacity
+		// is enough to make room. Otherwise the table is doubled.
+		if (capacity() != 0 && m_size < maxEntries() / 2)
+			rehash(capacity());
+		else
+			rehash(capacity() ? capacity() * 2 : GroupSize);
+	}
+
+	/// Moves all entries to a new table with the given capacity
+	void rehash(size_t newCapacity)
+	{
+		FixedSizeArray<Control> control(newCapacity + GroupSize);
+		FixedSizeArray<Slot> slots(newCapacity);
+
+		for (size_t i = 0; i < control.size(); ++i)
+			control[i] = Empty;
+
+		HashMap table;
+		table.m_control.swap(control);
+		table.m_slots.swap(slots);
+		table.m_hash = m_hash;
+		table.m_equal = m_equal;
+
+		for (size_t i = 0; i < capacity(); ++i) {
+			if (m_control[i] < 0)
+				continue;
+
+			size_t hash = hashOf(m_slots[i].key);
+			size_t slot = table.findFreeSlot(hash);
+
+			table.setControl(slot, h2(hash));
+			table.m_slots[slot].key = std::move(m_slots[i].key);
+			table.m_slots[slot].value = std::move(m_slots[i].value);
+		}
+
+		table.m_size = m_size;
+		swap(table);
+	}
+};
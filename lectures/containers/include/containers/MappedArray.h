@@ -0,0 +1,167 @@
+#pragma once
+
+#include "CheckedAccess.h"
+#include "MappedFile.h"
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+///
+/// @brief A fixed-size array, whose elements are stored in a memory-mapped file.
+///
+/// The array has the interface of FixedSizeArray, but its storage is a file
+/// mapped into memory. Opening an existing file is nearly instant: its pages
+/// are only read from disk when they are accessed. In read-write mode any
+/// change is written back to the file, so the array persists between runs.
+/// It can also be larger than the physical memory.
+///
+/// Only trivially copyable types can be stored, because the elements are
+/// never constructed or destroyed. They are just the bytes in the file.
+///
+/// Writing to the elements of a read-only array is undefined behaviour.
+/// On most systems it terminates the program.
+///
+template <typename T>
+class MappedArray {
+	static_assert(std::is_trivially_copyable_v<T>, "MappedArray can only store trivially copyable types");
+
+	MappedFile m_file;
+	T* m_data = nullptr;
+	size_t m_size = 0;
+
+public:
+	/// Constructs an empty array, which is not backed by any file
+	MappedArray() noexcept = default;
+
+	///
+	/// Maps an existing file
+	///
+	/// The size of the array is the size of the file divided by sizeof(T).
+	/// Trailing bytes that do not form a whole element are ignored.
+	///
+	/// @exception std::system_error The file cannot be opened or mapped
+	///
+	MappedArray(const std::string& path, MappingMode mode = MappingMode::ReadOnly)
+		: m_file(path, mode)
+	{
+		attach();
+	}
+
+	///
+	/// Opens a file in read-write mode, creating it if necessary,
+	/// and sets its size so that it holds exactly size elements
+	///
+	/// If the file already exists, the elements that fit in the new size keep
+	/// their values. All new elements are zero.
+	///
+	/// @exception std::system_error The file cannot be created, resized or mapped
+	///
+	MappedArray(const std::string& path, size_t size)
+		: m_file(path, size * sizeof(T))
+	{
+		attach();
+	}
+
+	MappedArray(MappedArray&& other) noexcept
+	{
+		swap(other);
+	}
+
+	MappedArray& operator=(MappedArray&& other) noexcept
+	{
+		MappedArray temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	MappingMode mode() const noexcept
+	{
+		return m_file.mode();
+	}
+
+	T* data() noexcept
+	{
+		return m_data;
+	}
+
+	const T* data() const noexcept
+	{
+		return m_data;
+	}
+
+	T& at(size_t index)
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return m_data[index];
+	}
+
+	const T& at(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return m_data[index];
+	}
+
+	/// Retrieve the element at index.
+	/// The index is only checked if CONTAINERS_CHECKED_ACCESS is enabled (see CheckedAccess.h).
+	T& operator[](size_t index) noexcept
+	{
+		CONTAINERS_CHECK_INDEX(index, m_size);
+		return m_data[index];
+	}
+
+	/// Retrieve the element at index.
+	/// The index is only checked if CONTAINERS_CHECKED_ACCESS is enabled (see CheckedAccess.h).
+	const T& operator[](size_t index) const noexcept
+	{
+		CONTAINERS_CHECK_INDEX(index, m_size);
+		return m_data[index];
+	}
+
+	///
+	/// Writes the modified elements back to the file and waits for the write to complete
+	///
+	/// The changes are written back eventually even without calling flush().
+	/// It only guarantees that they have reached the disk.
+	///
+	/// @exception std::system_error The write failed
+	///
+	void flush()
+	{
+		m_file.flush();
+	}
+
+	/// Tells the operating system how the elements will be accessed
+	void advise(AccessPattern pattern) noexcept
+	{
+		m_file.advise(pattern);
+	}
+
+	void swap(MappedArray& other) noexcept
+	{
+		m_file.swap(other.m_file);
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+	}
+
+private:
+	void attach() noexcept
+	{
+		m_data = static_cast<T*>(m_file.data());
+		m_size = m_file.size() / sizeof(T);
+	}
+};
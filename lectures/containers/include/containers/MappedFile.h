@@ -0,0 +1,316 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/// How a file is mapped into memory
+enum class MappingMode {
+	/// The mapped memory can only be read
+	ReadOnly,
+
+	/// Changes to the mapped memory are written back to the file
+	ReadWrite
+};
+
+/// Hints about how the mapped memory will be accessed
+enum class AccessPattern {
+	/// No particular pattern (the default)
+	Normal,
+
+	/// The memory will be read from start to end, so pages can be read ahead aggressively
+	Sequential,
+
+	/// The memory will be accessed in random order, so reading ahead is wasteful
+	Random,
+
+	/// The memory will be needed soon, so its pages should be loaded in advance
+	WillNeed
+};
+
+///
+/// @brief Maps the contents of a file into memory.
+///
+/// This is the platform-specific part of MappedArray. It uses mmap on POSIX
+/// systems and file mappings on Windows. All errors are reported with
+/// std::system_error.
+///
+class MappedFile {
+	void* m_data = nullptr;
+	size_t m_size = 0;
+	MappingMode m_mode = MappingMode::ReadOnly;
+
+#if defined(_WIN32)
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#else
+	int m_file = -1;
+#endif
+
+public:
+	/// Constructs an object, which does not map any file
+	MappedFile() noexcept = default;
+
+	///
+	/// Maps an existing file in its entirety
+	///
+	/// @exception std::system_error The file cannot be opened or mapped
+	///
+	MappedFile(const std::string& path, MappingMode mode)
+		: m_mode(mode)
+	{
+		openFile(path, mode, false);
+		m_size = fileSize();
+		mapFile();
+	}
+
+	///
+	/// Opens a file for reading and writing, creating it if it does not exist,
+	/// sets its size to exactly size bytes and maps it
+	///
+	/// The part of the file, which is kept, preserves its contents.
+	/// Any part that is added is filled with zeros.
+	///
+	/// @exception std::system_error The file cannot be created, resized or mapped
+	///
+	MappedFile(const std::string& path, size_t size)
+		: m_mode(MappingMode::ReadWrite)
+	{
+		openFile(path, MappingMode::ReadWrite, true);
+		resizeFile(size);
+		m_size = size;
+		mapFile();
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept
+	{
+		swap(other);
+	}
+
+	MappedFile& operator=(MappedFile&& other) noexcept
+	{
+		MappedFile temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	~MappedFile() noexcept
+	{
+		close();
+	}
+
+	/// Size of the mapped file in bytes
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	/// Address of the mapped memory or nullptr if the file is empty
+	void* data() noexcept
+	{
+		return m_data;
+	}
+
+	/// Address of the mapped memory or nullptr if the file is empty
+	const void* data() const noexcept
+	{
+		return m_data;
+	}
+
+	MappingMode mode() const noexcept
+	{
+		return m_mode;
+	}
+
+	///
+	/// Writes the modified pages back to the file and waits for the write to complete
+	///
+	/// @exception std::system_error The write failed
+	///
+	void flush()
+	{
+		if ( ! m_data || m_mode == MappingMode::ReadOnly)
+			return;
+
+#if defined(_WIN32)
+		if ( ! FlushViewOfFile(m_data, m_size) || ! FlushFileBuffers(m_file))
+			throw std::system_error(lastError(), "cannot flush the mapped file");
+#else
+		if (msync(m_data, m_size, MS_SYNC) != 0)
+			throw std::system_error(lastError(), "cannot flush the mapped file");
+#endif
+	}
+
+	///
+	/// Tells the operating system how the memory will be accessed
+	///
+	/// The hint only affects performance. It is ignored where it is not supported.
+	///
+	void advise(AccessPattern pattern) noexcept
+	{
+		if ( ! m_data)
+			return;
+
+#if defined(_WIN32)
+		if (pattern == AccessPattern::WillNeed) {
+			WIN32_MEMORY_RANGE_ENTRY range{ m_data, m_size };
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+#else
+		static const int advice[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED };
+		madvise(m_data, m_size, advice[static_cast<int>(pattern)]);
+#endif
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(MappedFile& other) noexcept
+	{
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+		std::swap(m_mode, other.m_mode);
+		std::swap(m_file, other.m_file);
+#if defined(_WIN32)
+		std::swap(m_mapping, other.m_mapping);
+#endif
+	}
+
+private:
+	/// Error reported by the last failed system call
+	static std::error_code lastError() noexcept
+	{
+#if defined(_WIN32)
+		return std::error_code(static_cast<int>(GetLastError()), std::system_category());
+#else
+		return std::error_code(errno, std::generic_category());
+#endif
+	}
+
+	/// Releases everything acquired so far and throws the error reported by the last failed system call
+	[[noreturn]] void fail(const char* message)
+	{
+		std::error_code error = lastError();
+		close();
+		throw std::system_error(error, message);
+	}
+
+	/// Unmaps the memory and closes the file
+	void close() noexcept
+	{
+#if defined(_WIN32)
+		if (m_data)
+			UnmapViewOfFile(m_data);
+		if (m_mapping)
+			CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE)
+			CloseHandle(m_file);
+
+		m_mapping = nullptr;
+		m_file = INVALID_HANDLE_VALUE;
+#else
+		if (m_data)
+			munmap(m_data, m_size);
+		if (m_file != -1)
+			::close(m_file);
+
+		m_file = -1;
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	void openFile(const std::string& path, MappingMode mode, bool create)
+	{
+#if defined(_WIN32)
+		DWORD access = (mode == MappingMode::ReadOnly) ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+		m_file = CreateFileA(path.c_str(), access, FILE_SHARE_READ, nullptr, create ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (m_file == INVALID_HANDLE_VALUE)
+			fail("cannot open the file");
+#else
+		int flags = (mode == MappingMode::ReadOnly) ? O_RDONLY : O_RDWR;
+		m_file = ::open(path.c_str(), create ? flags | O_CREAT : flags, 0644);
+
+		if (m_file == -1)
+			fail("cannot open the file");
+#endif
+	}
+
+	size_t fileSize()
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER size;
+
+		if ( ! GetFileSizeEx(m_file, &size))
+			fail("cannot determine the size of the file");
+
+		return static_cast<size_t>(size.QuadPart);
+#else
+		struct stat info;
+
+		if (fstat(m_file, &info) != 0)
+			fail("cannot determine the size of the file");
+
+		return static_cast<size_t>(info.st_size);
+#endif
+	}
+
+	void resizeFile(size_t size)
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER distance;
+		distance.QuadPart = static_cast<LONGLONG>(size);
+
+		if ( ! SetFilePointerEx(m_file, distance, nullptr, FILE_BEGIN) || ! SetEndOfFile(m_file))
+			fail("cannot resize the file");
+#else
+		if (ftruncate(m_file, static_cast<off_t>(size)) != 0)
+			fail("cannot resize the file");
+#endif
+	}
+
+	void mapFile()
+	{
+		// Empty files cannot be mapped
+		if (m_size == 0)
+			return;
+
+#if defined(_WIN32)
+		bool readOnly = (m_mode == MappingMode::ReadOnly);
+		m_mapping = CreateFileMappingA(m_file, nullptr, readOnly ? PAGE_READONLY : PAGE_READWRITE, 0, 0, nullptr);
+
+		if (m_mapping)
+			m_data = MapViewOfFile(m_mapping, readOnly ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, m_size);
+
+		if ( ! m_data)
+			fail("cannot map the file");
+#else
+		int protection = (m_mode == MappingMode::ReadOnly) ? PROT_READ : PROT_READ | PROT_WRITE;
+		void* data = mmap(nullptr, m_size, protection, MAP_SHARED, m_file, 0);
+
+		if (data == MAP_FAILED)
+			fail("cannot map the file");
+
+		m_data = data;
+#endif
+	}
+};
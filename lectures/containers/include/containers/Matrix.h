@@ -0,0 +1,399 @@
+#pragma once
+
+#include "FixedSizeArray.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+///
+/// @brief Stores the elements of a matrix row by row.
+///
+/// A layout policy maps the (row, col) coordinates of an element to its
+/// index in the underlying array. It also knows in which order to visit the
+/// elements, so that whole-matrix operations walk the memory sequentially,
+/// and passes them the index of each element, so they need not compute it.
+///
+struct RowMajorLayout {
+	/// Number of elements in the underlying array
+	static size_t storageSize(size_t rows, size_t cols) noexcept
+	{
+		return rows * cols;
+	}
+
+	static size_t index(size_t row, size_t col, size_t /* rows */, size_t cols) noexcept
+	{
+		return row * cols + col;
+	}
+
+	/// Calls visit(row, col, index) for all elements in the order in which they are stored
+	template <typename Visitor>
+	static void traverse(size_t rows, size_t cols, Visitor&& visit)
+	{
+		size_t index = 0;
+
+		for (size_t row = 0; row < rows; ++row)
+			for (size_t col = 0; col < cols; ++col)
+				visit(row, col, index++);
+	}
+};
+
+/// Stores the elements of a matrix column by column
+struct ColumnMajorLayout {
+	/// Number of elements in the underlying array
+	static size_t storageSize(size_t rows, size_t cols) noexcept
+	{
+		return rows * cols;
+	}
+
+	static size_t index(size_t row, size_t col, size_t rows, size_t /* cols */) noexcept
+	{
+		return col * rows + row;
+	}
+
+	/// Calls visit(row, col, index) for all elements in the order in which they are stored
+	template <typename Visitor>
+	static void traverse(size_t rows, size_t cols, Visitor&& visit)
+	{
+		size_t index = 0;
+
+		for (size_t col = 0; col < cols; ++col)
+			for (size_t row = 0; row < rows; ++row)
+				visit(row, col, index++);
+	}
+};
+
+///
+/// @brief Stores a matrix as square tiles of TileSize x TileSize elements.
+///
+/// The tiles are stored row by row and so are the elements inside each tile.
+/// Neighbouring elements in both directions are then usually in the same tile.
+/// This keeps both row and column walks local: a 32 x 32 tile of ints takes
+/// exactly one 4 KiB page. The matrix is padded up to a whole number of tiles.
+///
+template <size_t TileSize = 32>
+struct TiledLayout {
+	static_assert(TileSize != 0 && (TileSize & (TileSize - 1)) == 0, "the tile size must be a power of two");
+
+	/// Number of elements in the underlying array
+	static size_t storageSize(size_t rows, size_t cols) noexcept
+	{
+		return roundUp(rows) * roundUp(cols);
+	}
+
+	static size_t index(size_t row, size_t col, size_t /* rows */, size_t cols) noexcept
+	{
+		size_t tilesPerRow = roundUp(cols) / TileSize;
+		size_t tile = (row / TileSize) * tilesPerRow + col / TileSize;
+
+		return (tile * TileSize + row % TileSize) * TileSize + col % TileSize;
+	}
+
+	/// Calls visit(row, col, index) for all elements in the order in which they are stored
+	template <typename Visitor>
+	static void traverse(size_t rows, size_t cols, Visitor&& visit)
+	{
+		// The padding at the end of the partial tiles is skipped
+		size_t tileIndex = 0;
+
+		for (size_t tileRow = 0; tileRow < rows; tileRow += TileSize) {
+			for (size_t tileCol = 0; tileCol < cols; tileCol += TileSize, tileIndex += TileSize * TileSize) {
+				size_t rowsEnd = std::min(tileRow + TileSize, rows);
+				size_t colsEnd = std::min(tileCol + TileSize, cols);
+
+				for (size_t row = tileRow; row < rowsEnd; ++row) {
+					size_t index = tileIndex + (row - tileRow) * TileSize;
+
+					for (size_t col = tileCol; col < colsEnd; ++col)
+						visit(row, col, index++);
+				}
+			}
+		}
+	}
+
+private:
+	static size_t roundUp(size_t count) noexcept
+	{
+		return (count + TileSize - 1) & ~(TileSize - 1);
+	}
+};
+
+///
+/// @brief A two-dimensional matrix with a fixed number of rows and columns.
+///
+/// The elements are stored in a FixedSizeArray. The Layout policy decides
+/// where each element goes (row-major, column-major or tiled), and the
+/// Allocation policy decides where the array gets its memory (see Allocation.h).
+///
+/// Operations on the whole matrix, like forEach() and fill(), visit the
+/// elements in the order in which they are stored, whatever the layout is.
+///
+template <typename T, typename Layout = RowMajorLayout, typename Allocation = DefaultAllocation>
+class Matrix {
+	FixedSizeArray<T, Allocation> m_data;
+	size_t m_rows = 0;
+	size_t m_cols = 0;
+
+public:
+	///
+	/// @brief A view of a single row or column of a matrix.
+	///
+	/// The view is only valid while the matrix exists.
+	///
+	template <typename MatrixType, bool IsRow>
+	class LineView {
+		MatrixType* m_matrix;
+		size_t m_line;
+
+		using Reference = std::conditional_t<std::is_const_v<MatrixType>, const T&, T&>;
+
+	public:
+		LineView(MatrixType& matrix, size_t line) noexcept
+			: m_matrix(&matrix), m_line(line)
+		{}
+
+		/// Number of elements in the row or column
+		size_t size() const noexcept
+		{
+			return IsRow ? m_matrix->cols() : m_matrix->rows();
+		}
+
+		/// @exception std::out_of_range If the index is out of the bounds of the line
+		Reference at(size_t index) const
+		{
+			if (index >= size())
+				throw std::out_of_range("index is out of the bounds of the line");
+
+			return (*this)[index];
+		}
+
+		Reference operator[](size_t index) const noexcept
+		{
+			return IsRow ? (*m_matrix)(m_line, index) : (*m_matrix)(index, m_line);
+		}
+	};
+
+	using RowView = LineView<Matrix, true>;
+	using ConstRowView = LineView<const Matrix, true>;
+	using ColumnView = LineView<Matrix, false>;
+	using ConstColumnView = LineView<const Matrix, false>;
+
+public:
+	/// Constructs an empty matrix
+	Matrix() noexcept = default;
+
+	/// Creates a matrix with the given dimensions. The elements are default-initialized.
+	/// @exception std::bad_alloc Memory allocation failed
+	Matrix(size_t rows, size_t cols, const Allocation& allocation = Allocation())
+		: m_data(Layout::storageSize(rows, cols), allocation), m_rows(rows), m_cols(cols)
+	{}
+
+	Matrix(const Matrix&) = default;
+	Matrix& operator=(const Matrix&) = default;
+
+	/// Takes over the elements of other, which is left as an empty 0x0 matrix
+	Matrix(Matrix&& other) noexcept
+		: m_data(std::move(other.m_data)),
+		  m_rows(std::exchange(other.m_rows, 0)),
+		  m_cols(std::exchange(other.m_cols, 0))
+	{}
+
+	Matrix& operator=(Matrix&& other) noexcept
+	{
+		if (this != &other) {
+			m_data = std::move(other.m_data);
+			m_rows = std::exchange(other.m_rows, 0);
+			m_cols = std::exchange(other.m_cols, 0);
+		}
+
+		return *this;
+	}
+
+	size_t rows() const noexcept
+	{
+		return m_rows;
+	}
+
+	size_t cols() const noexcept
+	{
+		return m_cols;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_rows == 0 || m_cols == 0;
+	}
+
+	/// The underlying array, which stores the elements in the order given by the layout
+	T* data() noexcept
+	{
+		return m_data.data();
+	}
+
+	/// The underlying array, which stores the elements in the order given by the layout
+	const T* data() const noexcept
+	{
+		return m_data.data();
+	}
+
+	T& operator()(size_t row, size_t col) noexcept
+	{
+		return m_data[Layout::index(row, col, m_rows, m_cols)];
+	}
+
+	const T& operator()(size_t row, size_t col) const noexcept
+	{
+		return m_data[Layout::index(row, col, m_rows, m_cols)];
+	}
+
+	/// @exception std::out_of_range If the coordinates are out of the bounds of the matrix
+	T& at(size_t row, size_t col)
+	{
+		checkBounds(row, col);
+		return (*this)(row, col);
+	}
+
+	/// @exception std::out_of_range If the coordinates are out of the bounds of the matrix
+	const T& at(size_t row, size_t col) const
+	{
+		checkBounds(row, col);
+		return (*this)(row, col);
+	}
+
+	/// @exception std::out_of_range If the row does not exist
+	RowView row(size_t index)
+	{
+		if (index >= m_rows)
+			throw std::out_of_range("the row does not exist");
+
+		return RowView(*this, index);
+	}
+
+	/// @exception std::out_of_range If the row does not exist
+	ConstRowView row(size_t index) const
+	{
+		if (index >= m_rows)
+			throw std::out_of_range("the row does not exist");
+
+		return ConstRowView(*this, index);
+	}
+
+	/// @exception std::out_of_range If the column does not exist
+	ColumnView column(size_t index)
+	{
+		if (index >= m_cols)
+			throw std::out_of_range("the column does not exist");
+
+		return ColumnView(*this, index);
+	}
+
+	/// @exception std::out_of_range If the column does not exist
+	ConstColumnView column(size_t index) const
+	{
+		if (index >= m_cols)
+			throw std::out_of_range("the column does not exist");
+
+		return ConstColumnView(*this, index);
+	}
+
+	/// Calls visit(row, col, value) for all elements, in the order in which they are stored
+	template <typename Visitor>
+	void forEach(Visitor&& visit)
+	{
+		T* data = m_data.data();
+
+		Layout::traverse(m_rows, m_cols, [data, &visit](size_t row, size_t col, size_t index) {
+			visit(row, col, data[index]);
+		});
+	}
+
+	/// Calls visit(row, col, value) for all elements, in the order in which they are stored
+	template <typename Visitor>
+	void forEach(Visitor&& visit) const
+	{
+		const T* data = m_data.data();
+
+		Layout::traverse(m_rows, m_cols, [data, &visit](size_t row, size_t col, size_t index) {
+			visit(row, col, data[index]);
+		});
+	}
+
+	/// Sets all elements to value
+	void fill(const T& value)
+	{
+		forEach([&value](size_t, size_t, T& element) { element = value; });
+	}
+
+	///
+	/// Creates the transpose of the matrix
+	///
+	/// The matrix is split recursively into halves until the blocks fit in
+	/// the cache, whatever its size is. So the transpose reads and writes
+	/// memory efficiently without being tuned for a specific cache.
+	///
+	/// @exception std::bad_alloc Memory allocation failed
+	///
+	Matrix transposed() const
+	{
+		Matrix result(m_cols, m_rows, m_data.allocation());
+		transposeBlock(result, 0, m_rows, 0, m_cols);
+		return result;
+	}
+
+	/// Checks whether two matrices have the same dimensions and elements
+	bool operator==(const Matrix& other) const
+	{
+		if (m_rows != other.m_rows || m_cols != other.m_cols)
+			return false;
+
+		for (size_t row = 0; row < m_rows; ++row) {
+			for (size_t col = 0; col < m_cols; ++col) {
+				if ((*this)(row, col) != other(row, col))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	void swap(Matrix& other) noexcept
+	{
+		m_data.swap(other.m_data);
+		std::swap(m_rows, other.m_rows);
+		std::swap(m_cols, other.m_cols);
+	}
+
+private:
+	/// Blocks with at most this many elements are transposed directly
+	static constexpr size_t TransposeBlockSize = 256;
+
+	void checkBounds(size_t row, size_t col) const
+	{
+		if (row >= m_rows || col >= m_cols)
+			throw std::out_of_range("the coordinates are out of the bounds of the matrix");
+	}
+
+	/// Transposes the block [rowsBegin, rowsEnd) x [colsBegin, colsEnd) into result
+	void transposeBlock(Matrix& result, size_t rowsBegin, size_t rowsEnd, size_t colsBegin, size_t colsEnd) const
+	{
+		size_t rowsCount = rowsEnd - rowsBegin;
+		size_t colsCount = colsEnd - colsBegin;
+
+		if (rowsCount * colsCount <= TransposeBlockSize) {
+			for (size_t row = rowsBegin; row < rowsEnd; ++row)
+				for (size_t col = colsBegin; col < colsEnd; ++col)
+					result(col, row) = (*this)(row, col);
+		}
+		else if (rowsCount >= colsCount) {
+			size_t middle = rowsBegin + rowsCount / 2;
+			transposeBlock(result, rowsBegin, middle, colsBegin, colsEnd);
+			transposeBlock(result, middle, rowsEnd, colsBegin, colsEnd);
+		}
+		else {
+			size_t middle = colsBegin + colsCount / 2;
+			transposeBlock(result, rowsBegin, rowsEnd, colsBegin, middle);
+			transposeBlock(result, rowsBegin, rowsEnd, middle, colsEnd);
+		}
+	}
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CacheLine.h"
+#include "FixedSizeArray.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+
+///
+/// @brief A bounded lock-free queue for any number of producer and consumer threads.
+///
+/// This is Dmitry Vyukov's bounded MPMC queue. Each slot of the ring has a
+/// sequence number, which tells whether the slot is ready to be written to or
+/// read from in the current round. A producer claims a slot by advancing the
+/// enqueue position with a CAS, stores the element and then publishes it by
+/// updating the slot's sequence. Consumers do the same with the dequeue
+/// position. The two positions are kept on separate cache lines, so
+/// producers and consumers do not invalidate each other's line.
+///
+template <typename T>
+class MpmcQueue {
+	struct Slot {
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	FixedSizeArray<Slot> m_slots;
+	size_t m_mask;
+
+	alignas(CacheLineSize) std::atomic<size_t> m_enqueuePosition{0};
+	alignas(CacheLineSize) std::atomic<size_t> m_dequeuePosition{0};
+
+public:
+	/// Constructs a queue, which can hold at least capacity elements.
+	/// The capacity is rounded up to a power of two, which is at least 2.
+	/// @exception std::bad_alloc Memory allocation failed
+	explicit MpmcQueue(size_t capacity)
+		: m_slots(roundCapacity(capacity)), m_mask(m_slots.size() - 1)
+	{
+		for (size_t i = 0; i < m_slots.size(); ++i)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	MpmcQueue(const MpmcQueue&) = delete;
+	MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+	/// Maximum number of elements in the queue
+	size_t capacity() const noexcept
+	{
+		return m_slots.size();
+	}
+
+	/// Appends a copy of value, unless the queue is full
+	/// @return false if the queue is full
+	bool tryPush(const T& value)
+	{
+		return emplace(value);
+	}
+
+	/// Appends value, unless the queue is full
+	/// @return false if the queue is full
+	bool tryPush(T&& value)
+	{
+		return emplace(std::move(value));
+	}
+
+	/// Moves the first element into result, unless the queue is empty
+	/// @return false if the queue is empty
+	bool tryPop(T& result)
+	{
+		size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+
+		for (;;) {
+			Slot& slot = m_slots[position & m_mask];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+			if (difference == 0) {
+				// The slot holds an element of the current round: try to claim it
+				if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					result = std::move(slot.value);
+					// Make the slot available to producers in the next round
+					slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0) {
+				// The slot has not been filled yet
+				return false;
+			}
+			else {
+				// Another consumer took the element, retry with the new position
+				position = m_dequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/// Appends value, waiting while the queue is full
+	void push(T value)
+	{
+		while ( ! tryPush(std::move(value)))
+			std::this_thread::yield();
+	}
+
+	/// Removes and returns the first element, waiting while the queue is empty
+	T pop()
+	{
+		T result;
+
+		while ( ! tryPop(result))
+			std::this_thread::yield();
+
+		return result;
+	}
+
+private:
+	template <typename U>
+	bool emplace(U&& value)
+	{
+		size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+		for (;;) {
+			Slot& slot = m_slots[position & m_mask];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+			if (difference == 0) {
+				// The slot is free in the current round: try to claim it
+				if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					slot.value = std::forward<U>(value);
+					slot.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0) {
+				// The slot still holds an element from the previous round
+				return false;
+			}
+			else {
+				// Another producer took the slot, retry with the new position
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	static size_t roundCapacity(size_t capacity) noexcept
+	{
+		size_t rounded = 2;
+
+		while (rounded < capacity)
+			rounded *= 2;
+
+		return rounded;
+	}
+};
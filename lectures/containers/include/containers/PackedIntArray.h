@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Bits.h"
+#include "FixedSizeArray.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+///
+/// @brief An array of unsigned integers, each stored in exactly Bits bits.
+///
+/// The values are packed back to back into 64-bit words, so a value may
+/// span two words. Both get() and set() always access two consecutive words
+/// and combine them with shifts and masks, which avoids a branch on whether
+/// the value crosses a word boundary. One extra word at the end keeps the
+/// second access in bounds.
+///
+/// Values assigned to the array are truncated to their lowest Bits bits.
+///
+template <unsigned Bits>
+class PackedIntArray {
+	static_assert(Bits >= 1 && Bits <= 32, "PackedIntArray supports 1 to 32 bits per value");
+
+public:
+	/// The smallest unsigned type, which can hold a value
+	using Value = std::conditional_t<Bits <= 8, std::uint8_t,
+		std::conditional_t<Bits <= 16, std::uint16_t, std::uint32_t>>;
+
+	/// The largest value, which can be stored in the array
+	static constexpr Value MaxValue = static_cast<Value>(bits::lowMask(Bits));
+
+	/// A reference to a single value, returned by the non-const operator[] and at()
+	class Reference {
+		PackedIntArray& m_array;
+		size_t m_index;
+
+	public:
+		Reference(PackedIntArray& array, size_t index) noexcept
+			: m_array(array), m_index(index)
+		{}
+
+		Reference(const Reference&) = default;
+
+		operator Value() const noexcept
+		{
+			return m_array.get(m_index);
+		}
+
+		Reference& operator=(Value value) noexcept
+		{
+			m_array.set(m_index, value);
+			return *this;
+		}
+
+		Reference& operator=(const Reference& other) noexcept
+		{
+			return *this = Value(other);
+		}
+	};
+
+private:
+	FixedSizeArray<std::uint64_t> m_words;
+	size_t m_size = 0;
+
+public:
+	/// Constructs an empty array
+	PackedIntArray() noexcept = default;
+
+	PackedIntArray(const PackedIntArray&) = default;
+	PackedIntArray& operator=(const PackedIntArray&) = default;
+
+	/// Takes over the values of other, which is left empty
+	PackedIntArray(PackedIntArray&& other) noexcept
+		: m_words(std::move(other.m_words)), m_size(std::exchange(other.m_size, 0))
+	{}
+
+	PackedIntArray& operator=(PackedIntArray&& other) noexcept
+	{
+		if (this != &other) {
+			m_words = std::move(other.m_words);
+			m_size = std::exchange(other.m_size, 0);
+		}
+
+		return *this;
+	}
+
+	/// Creates an array with a specified size, with all values set to zero
+	/// @exception std::bad_alloc if memory allocation fails
+	explicit PackedIntArray(size_t size)
+		: m_words(size ? bits::wordsFor(size * Bits) + 1 : 0), m_size(size)
+	{
+		std::fill_n(m_words.data(), m_words.size(), 0);
+	}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/// Number of words, which store the values
+	size_t wordCount() const noexcept
+	{
+		return m_words.size();
+	}
+
+	/// The words, which store the values. Value i starts at bit i * Bits.
+	const std::uint64_t* data() const noexcept
+	{
+		return m_words.data();
+	}
+
+	/// Retrieve the value at index
+	Value get(size_t index) const noexcept
+	{
+		size_t bit = index * Bits;
+		size_t word = bit / bits::WordBits;
+		unsigned offset = bit % bits::WordBits;
+
+		// The second shift is split in two, so it is at most 63 bits even when offset is zero
+		std::uint64_t low = m_words[word] >> offset;
+		std::uint64_t high = (m_words[word + 1] << 1) << (bits::WordBits - 1 - offset);
+
+		return static_cast<Value>((low | high) & MaxValue);
+	}
+
+	/// Store the lowest Bits bits of value at index
+	void set(size_t index, Value value) noexcept
+	{
+		size_t bit = index * Bits;
+		size_t word = bit / bits::WordBits;
+		unsigned offset = bit % bits::WordBits;
+		std::uint64_t masked = value & MaxValue;
+
+		// The high parts are zero unless the value crosses into the next word
+		m_words[word] = (m_words[word] & ~(std::uint64_t(MaxValue) << offset)) | (masked << offset);
+		m_words[word + 1] =
+			(m_words[word + 1] & ~((std::uint64_t(MaxValue) >> 1) >> (bits::WordBits - 1 - offset))) |
+			((masked >> 1) >> (bits::WordBits - 1 - offset));
+	}
+
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	Reference at(size_t index)
+	{
+		checkIndex(index);
+		return Reference(*this, index);
+	}
+
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	Value at(size_t index) const
+	{
+		checkIndex(index);
+		return get(index);
+	}
+
+	Reference operator[](size_t index) noexcept
+	{
+		return Reference(*this, index);
+	}
+
+	Value operator[](size_t index) const noexcept
+	{
+		return get(index);
+	}
+
+	/// Calls visit(value) for every value in order.
+	/// Decoding the values one after another is faster than calling get() for each index.
+	template <typename Visitor>
+	void forEach(Visitor&& visit) const
+	{
+		const std::uint64_t* words = m_words.data();
+
+		if constexpr (bits::WordBits % Bits == 0) {
+			// No value crosses a word boundary, so each word is unpacked with constant shifts
+			constexpr size_t PerWord = bits::WordBits / Bits;
+			size_t fullWords = m_size / PerWord;
+
+			for (size_t word = 0; word < fullWords; ++word) {
+				std::uint64_t packed = words[word];
+
+				for (size_t j = 0; j < PerWord; ++j)
+					visit(static_cast<Value>((packed >> (j * Bits)) & MaxValue));
+			}
+
+			for (size_t i = fullWords * PerWord; i < m_size; ++i)
+				visit(get(i));
+
+			return;
+		}
+
+		size_t word = 0;
+		unsigned offset = 0;
+
+		for (size_t i = 0; i < m_size; ++i) {
+			std::uint64_t low = words[word] >> offset;
+			std::uint64_t high = (words[word + 1] << 1) << (bits::WordBits - 1 - offset);
+			visit(static_cast<Value>((low | high) & MaxValue));
+
+			offset += Bits;
+			word += offset / bits::WordBits;
+			offset %= bits::WordBits;
+		}
+	}
+
+	/// Sets all elements to value
+	void fill(Value value) noexcept
+	{
+		for (size_t i = 0; i < m_size; ++i)
+			set(i, value);
+	}
+
+	void swap(PackedIntArray& other) noexcept
+	{
+		m_words.swap(other.m_words);
+		std::swap(m_size, other.m_size);
+	}
+
+	/// Checks whether two arrays have the same size and contain the same values
+	bool operator==(const PackedIntArray& other) const noexcept
+	{
+		return m_size == other.m_size && m_words == other.m_words;
+	}
+
+	bool operator!=(const PackedIntArray& other) const noexcept
+	{
+		return ! (*this == other);
+	}
+
+private:
+	void checkIndex(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the array");
+	}
+};
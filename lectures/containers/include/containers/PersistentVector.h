@@ -0,0 +1,533 @@
+#pragma once
+
+#include "FixedSizeArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+///
+/// @brief An immutable array, whose versions share their unchanged parts.
+///
+/// The elements are stored in a tree with a branching factor of Width (32).
+/// The leaves and the branches are FixedSizeArray chunks of Width elements or
+/// children. set(), push_back() and pop_back() do not modify the vector:
+/// they return a new version, which copies only the O(log32 n) nodes on the
+/// path to the changed element and shares all other nodes with the original.
+/// Copying a vector is O(1).
+///
+/// The last, possibly incomplete, leaf (the *tail*) is kept outside of the
+/// tree, so push_back() usually copies only the tail and enters the tree
+/// once every Width elements.
+///
+/// The nodes are reference-counted with atomic counters, so different
+/// versions may be used from different threads.
+///
+/// Building a large vector element by element would copy the tail on every
+/// push_back(). A Transient performs a batch of modifications in place on
+/// the nodes it has created itself, and then returns a new version with
+/// persistent().
+///
+template <typename T>
+class PersistentVector {
+public:
+	static constexpr size_t BranchBits = 5;
+
+	/// Number of elements of a leaf and of children of a branch
+	static constexpr size_t Width = size_t(1) << BranchBits;
+
+	/// Thrown by pop_back() when the vector is empty
+	class EmptyVectorException : public std::logic_error {
+	public:
+		EmptyVectorException()
+			: std::logic_error("Operation was performed on an empty vector")
+		{}
+	};
+
+	class Transient;
+
+private:
+	///
+	/// The nodes, which have the same edit as the operation that modifies
+	/// the vector, were created by that operation (or transient) and may be
+	/// changed in place. All other nodes are copied first.
+	///
+	struct Node {
+		std::atomic<size_t> references{1};
+		std::uint64_t edit;
+
+		explicit Node(std::uint64_t edit) noexcept
+			: edit(edit)
+		{}
+	};
+
+	struct Leaf : Node {
+		FixedSizeArray<T> values = FixedSizeArray<T>(Width);
+
+		using Node::Node;
+	};
+
+	struct Branch : Node {
+		FixedSizeArray<Node*> children = FixedSizeArray<Node*>(Width);
+
+		explicit Branch(std::uint64_t edit)
+			: Node(edit)
+		{
+			std::fill_n(children.data(), Width, nullptr);
+		}
+	};
+
+	size_t m_size = 0;
+
+	/// Number of index bits below the root, i.e. BranchBits times the height of the tree
+	size_t m_shift = BranchBits;
+
+	/// A Branch, which holds the elements in front of the tail. Null while they all fit into the tail.
+	Node* m_root = nullptr;
+
+	/// Holds the elements at indices [tailOffset(), size())
+	Leaf* m_tail = nullptr;
+
+public:
+	/// Constructs an empty vector
+	PersistentVector() noexcept = default;
+
+	/// Shares all nodes with other. O(1).
+	PersistentVector(const PersistentVector& other) noexcept
+		: m_size(other.m_size), m_shift(other.m_shift), m_root(other.m_root), m_tail(other.m_tail)
+	{
+		retain(m_root);
+		retain(m_tail);
+	}
+
+	PersistentVector& operator=(const PersistentVector& other) noexcept
+	{
+		PersistentVector copy(other);
+		swap(copy);
+		return *this;
+	}
+
+	PersistentVector(PersistentVector&& other) noexcept
+	{
+		swap(other);
+	}
+
+	PersistentVector& operator=(PersistentVector&& other) noexcept
+	{
+		PersistentVector temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	~PersistentVector() noexcept
+	{
+		releaseBranch(m_root, m_shift);
+		releaseLeaf(m_tail);
+	}
+
+	/// Number of elements in the vector
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/// Retrieve the element at index
+	const T& operator[](size_t index) const noexcept
+	{
+		return leafFor(index)->values[index & (Width - 1)];
+	}
+
+	/// Retrieve the element at index
+	/// @exception std::out_of_range If the index is out of the bounds of the vector
+	const T& at(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the vector");
+
+		return (*this)[index];
+	}
+
+	/// Returns a new version, in which the element at index is replaced by value
+	/// @exception std::out_of_range If the index is out of the bounds of the vector
+	/// @exception std::bad_alloc Memory allocation failed
+	PersistentVector set(size_t index, const T& value) const
+	{
+		PersistentVector result(*this);
+		result.setInPlace(index, value, nextEdit());
+		return result;
+	}
+
+	/// Returns a new version with value appended
+	/// @exception std::bad_alloc Memory allocation failed
+	PersistentVector push_back(const T& value) const
+	{
+		PersistentVector result(*this);
+		result.pushBackInPlace(value, nextEdit());
+		return result;
+	}
+
+	/// Returns a new version without the last element
+	/// @exception EmptyVectorException The vector is empty
+	/// @exception std::bad_alloc Memory allocation failed
+	PersistentVector pop_back() const
+	{
+		PersistentVector result(*this);
+		result.popBackInPlace(nextEdit());
+		return result;
+	}
+
+	/// Returns a Transient, which starts with the contents of this vector
+	Transient transient() const
+	{
+		return Transient(*this);
+	}
+
+	/// Calls function for each element in order. Faster than indexing, because each leaf is looked up once.
+	template <typename Function>
+	void forEach(Function function) const
+	{
+		for (size_t first = 0; first < m_size; first += Width) {
+			const Leaf* leaf = leafFor(first);
+			size_t count = std::min(Width, m_size - first);
+
+			for (size_t i = 0; i < count; ++i)
+				function(leaf->values[i]);
+		}
+	}
+
+	/// Checks whether both vectors share their storage, i.e. one is an unmodified copy of the other
+	bool sharesStorageWith(const PersistentVector& other) const noexcept
+	{
+		return m_size == other.m_size && m_root == other.m_root && m_tail == other.m_tail;
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(PersistentVector& other) noexcept
+	{
+		std::swap(m_size, other.m_size);
+		std::swap(m_shift, other.m_shift);
+		std::swap(m_root, other.m_root);
+		std::swap(m_tail, other.m_tail);
+	}
+
+private:
+	/// A number, which no other operation or transient uses as its edit
+	static std::uint64_t nextEdit() noexcept
+	{
+		static std::atomic<std::uint64_t> counter{0};
+		return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	/// Index of the first element of the tail
+	size_t tailOffset() const noexcept
+	{
+		return m_size < Width ? 0 : ((m_size - 1) >> BranchBits) << BranchBits;
+	}
+
+	const Leaf* leafFor(size_t index) const noexcept
+	{
+		if (index >= tailOffset())
+			return m_tail;
+
+		const Node* node = m_root;
+
+		for (size_t level = m_shift; level > 0; level -= BranchBits)
+			node = static_cast<const Branch*>(node)->children[(index >> level) & (Width - 1)];
+
+		return static_cast<const Leaf*>(node);
+	}
+
+	void setInPlace(size_t index, const T& value, std::uint64_t edit)
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the vector");
+
+		if (index >= tailOffset()) {
+			editableLeaf(m_tail, edit)->values[index & (Width - 1)] = value;
+			return;
+		}
+
+		Node** slot = &m_root;
+
+		for (size_t level = m_shift; level > 0; level -= BranchBits)
+			slot = &editableBranch(*slot, level, edit)->children[(index >> level) & (Width - 1)];
+
+		editableLeaf(*slot, edit)->values[index & (Width - 1)] = value;
+	}
+
+	void pushBackInPlace(const T& value, std::uint64_t edit)
+	{
+		if ( ! m_tail) {
+			m_tail = new Leaf(edit);
+		}
+		else if (m_size - tailOffset() == Width) {
+			pushTailIntoTree(edit);
+			m_tail = new Leaf(edit);
+		}
+		else {
+			editableLeaf(m_tail, edit);
+		}
+
+		m_tail->values[m_size & (Width - 1)] = value;
+		++m_size;
+	}
+
+	void popBackInPlace(std::uint64_t edit)
+	{
+		if (m_size == 0)
+			throw EmptyVectorException();
+
+		if (m_size == 1) {
+			PersistentVector().swap(*this);
+			return;
+		}
+
+		if (m_size - tailOffset() > 1) {
+			// Release the resources held by the removed element
+			editableLeaf(m_tail, edit)->values[(m_size - 1) & (Width - 1)] = T();
+			--m_size;
+			return;
+		}
+
+		// The tail becomes empty, so the last leaf of the tree becomes the new tail
+		Leaf* newTail = const_cast<Leaf*>(leafFor(m_size - 2));
+		retain(newTail);
+		releaseLeaf(m_tail);
+		m_tail = newTail;
+
+		popTail(m_root, m_shift, edit);
+
+		if (m_shift > BranchBits && ! static_cast<Branch*>(m_root)->children[1]) {
+			// The root has a single child, so the tree loses a level
+			Node* child = static_cast<Branch*>(m_root)->children[0];
+			retain(child);
+			releaseBranch(m_root, m_shift);
+			m_root = child;
+			m_shift -= BranchBits;
+		}
+
+		--m_size;
+	}
+
+	/// Moves the full tail into the tree, adding a level if the tree is full
+	void pushTailIntoTree(std::uint64_t edit)
+	{
+		size_t leaves = m_size >> BranchBits;
+
+		if (m_root && leaves > (size_t(1) << m_shift)) {
+			Branch* root = new Branch(edit);
+			root->children[0] = m_root;
+			root->children[1] = newPath(m_shift, m_tail, edit);
+			m_root = root;
+			m_shift += BranchBits;
+		}
+		else {
+			if ( ! m_root)
+				m_root = new Branch(edit);
+
+			size_t index = m_size - 1;
+			Node** slot = &m_root;
+			size_t level = m_shift;
+
+			// Descend until the slot for the tail, or for a new path to it, is found
+			for (; level > 0 && *slot; level -= BranchBits)
+				slot = &editableBranch(*slot, level, edit)->children[(index >> level) & (Width - 1)];
+
+			*slot = newPath(level, m_tail, edit);
+		}
+
+		// The tree has taken over the reference to the tail
+		m_tail = nullptr;
+	}
+
+	/// Creates the branches above a leaf, so that the result can be placed at the given level
+	static Node* newPath(size_t level, Leaf* leaf, std::uint64_t edit)
+	{
+		if (level == 0)
+			return leaf;
+
+		Branch* branch = new Branch(edit);
+		branch->children[0] = newPath(level - BranchBits, leaf, edit);
+		return branch;
+	}
+
+	/// Removes the leaf, which holds the element at m_size - 2, from the subtree in slot
+	void popTail(Node*& slot, size_t level, std::uint64_t edit)
+	{
+		// If it is the first leaf of the subtree, the whole subtree becomes empty
+		if (((m_size - 2) & ((size_t(1) << (level + BranchBits)) - 1)) < Width) {
+			releaseBranch(slot, level);
+			slot = nullptr;
+			return;
+		}
+
+		Node*& child = editableBranch(slot, level, edit)->children[((m_size - 2) >> level) & (Width - 1)];
+
+		if (level > BranchBits) {
+			popTail(child, level - BranchBits, edit);
+		}
+		else {
+			releaseLeaf(static_cast<Leaf*>(child));
+			child = nullptr;
+		}
+	}
+
+	/// Makes sure the leaf in slot was created with edit, copying it if necessary, and returns it
+	template <typename Slot>
+	static Leaf* editableLeaf(Slot& slot, std::uint64_t edit)
+	{
+		Leaf* leaf = static_cast<Leaf*>(slot);
+
+		if (leaf->edit != edit) {
+			Leaf* copy = new Leaf(edit);
+			copy->values = leaf->values;
+			releaseLeaf(leaf);
+			slot = leaf = copy;
+		}
+
+		return leaf;
+	}
+
+	/// Makes sure the branch in slot was created with edit, copying it if necessary, and returns it
+	static Branch* editableBranch(Node*& slot, size_t level, std::uint64_t edit)
+	{
+		Branch* branch = static_cast<Branch*>(slot);
+
+		if (branch->edit != edit) {
+			Branch* copy = new Branch(edit);
+
+			for (size_t i = 0; i < Width; ++i) {
+				copy->children[i] = branch->children[i];
+				retain(copy->children[i]);
+			}
+
+			releaseBranch(branch, level);
+			slot = branch = copy;
+		}
+
+		return branch;
+	}
+
+	static void retain(Node* node) noexcept
+	{
+		if (node)
+			node->references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void releaseLeaf(Leaf* leaf) noexcept
+	{
+		if (leaf && leaf->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete leaf;
+	}
+
+	static void releaseBranch(Node* node, size_t level) noexcept
+	{
+		Branch* branch = static_cast<Branch*>(node);
+
+		if ( ! branch || branch->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		for (size_t i = 0; i < Width; ++i) {
+			if (level == BranchBits)
+				releaseLeaf(static_cast<Leaf*>(branch->children[i]));
+			else
+				releaseBranch(branch->children[i], level - BranchBits);
+		}
+
+		delete branch;
+	}
+};
+
+///
+/// @brief Modifies a PersistentVector in place, for building or changing it in bulk.
+///
+/// The transient starts with the nodes of a vector and copies each of them
+/// on the first modification, exactly like the operations of
+/// PersistentVector. The copies belong to the transient, so the following
+/// modifications of the same nodes do not copy them again. push_back()
+/// therefore costs amortized O(1), instead of copying the tail each time.
+///
+/// persistent() returns the current contents as a new version. The transient
+/// may still be used afterwards, without affecting the returned version.
+/// A transient must not be used by several threads at the same time.
+///
+template <typename T>
+class PersistentVector<T>::Transient {
+	PersistentVector m_vector;
+	std::uint64_t m_edit;
+
+public:
+	/// Starts with the contents of vector (or empty)
+	explicit Transient(const PersistentVector& vector = PersistentVector())
+		: m_vector(vector), m_edit(nextEdit())
+	{}
+
+	Transient(const Transient&) = delete;
+	Transient& operator=(const Transient&) = delete;
+
+	Transient(Transient&&) noexcept = default;
+	Transient& operator=(Transient&&) noexcept = default;
+
+	/// Number of elements in the vector
+	size_t size() const noexcept
+	{
+		return m_vector.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return m_vector.empty();
+	}
+
+	/// Retrieve the element at index
+	const T& operator[](size_t index) const noexcept
+	{
+		return m_vector[index];
+	}
+
+	/// Retrieve the element at index
+	/// @exception std::out_of_range If the index is out of the bounds of the vector
+	const T& at(size_t index) const
+	{
+		return m_vector.at(index);
+	}
+
+	/// Replace the element at index by value
+	/// @exception std::out_of_range If the index is out of the bounds of the vector
+	/// @exception std::bad_alloc Memory allocation failed
+	void set(size_t index, const T& value)
+	{
+		m_vector.setInPlace(index, value, m_edit);
+	}
+
+	/// Append value to the vector
+	/// @exception std::bad_alloc Memory allocation failed
+	void push_back(const T& value)
+	{
+		m_vector.pushBackInPlace(value, m_edit);
+	}
+
+	/// Remove the last element from the vector
+	/// @exception EmptyVectorException The vector is empty
+	/// @exception std::bad_alloc Memory allocation failed
+	void pop_back()
+	{
+		m_vector.popBackInPlace(m_edit);
+	}
+
+	/// Returns the current contents as a new version of the vector
+	PersistentVector persistent()
+	{
+		// The version shares the nodes, so the transient must not modify them in place any more
+		m_edit = nextEdit();
+		return m_vector;
+	}
+};
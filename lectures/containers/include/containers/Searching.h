@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Bits.h"
+#include "DynamicArray.h"
+#include "FixedSizeArray.h"
+
+#include <cstdint>
+#include <functional>
+
+///
+/// Index of the first element in the sorted range [first, first + size),
+/// which is not less than value, or size if there is no such element.
+///
+/// Unlike std::lower_bound, the loop has no data-dependent branch: each step
+/// halves the range with a conditional move, so the number of iterations
+/// depends only on the size and the CPU never mispredicts the direction.
+///
+template <typename T, typename Compare = std::less<>>
+size_t branchlessLowerBound(const T* first, size_t size, const T& value, Compare comp = Compare())
+{
+	if (size == 0)
+		return 0;
+
+	const T* base = first;
+
+	while (size > 1) {
+		size_t half = size / 2;
+		base = comp(base[half], value) ? base + half : base;
+		size -= half;
+	}
+
+	return static_cast<size_t>(base - first) + comp(*base, value);
+}
+
+template <typename T, typename Allocation, typename Compare = std::less<>>
+size_t branchlessLowerBound(const FixedSizeArray<T, Allocation>& arr, const T& value, Compare comp = Compare())
+{
+	return branchlessLowerBound(arr.data(), arr.size(), value, comp);
+}
+
+template <typename T, typename Allocation, typename Compare = std::less<>>
+size_t branchlessLowerBound(const DynamicArray<T, Allocation>& arr, const T& value, Compare comp = Compare())
+{
+	return branchlessLowerBound(arr.data(), arr.size(), value, comp);
+}
+
+///
+/// @brief A sorted lookup table stored in the Eytzinger (BFS) order of a binary search tree.
+///
+/// The root is at index 1 and the children of node k are at 2k and 2k + 1,
+/// so a search walks down the array with a simple, branch-free index update.
+/// The first levels of the tree, which every search visits, share a few cache
+/// lines, and the nodes four levels below the current one are contiguous, so
+/// they are prefetched while the search compares the levels in between.
+/// This makes searches in large tables several times faster than a binary
+/// search over a sorted array.
+///
+/// The table is built once from a sorted range and does not change afterwards.
+/// T must be default-constructible.
+///
+template <typename T, typename Compare = std::less<>>
+class EytzingerArray {
+	/// Index 0 is unused, the tree occupies [1, size]
+	FixedSizeArray<T> m_tree;
+	size_t m_size = 0;
+	Compare m_comp;
+
+public:
+	/// Constructs an empty table
+	EytzingerArray() = default;
+
+	/// Builds a table from the sorted range [first, first + size)
+	/// @exception std::bad_alloc Memory allocation failed
+	EytzingerArray(const T* sorted, size_t size, Compare comp = Compare())
+		: m_tree(size + 1), m_size(size), m_comp(comp)
+	{
+		const T* next = sorted;
+		fill(next, 1);
+	}
+
+	/// Builds a table from a sorted array
+	/// @exception std::bad_alloc Memory allocation failed
+	template <typename Allocation>
+	explicit EytzingerArray(const FixedSizeArray<T, Allocation>& sorted, Compare comp = Compare())
+		: EytzingerArray(sorted.data(), sorted.size(), comp)
+	{}
+
+	/// Builds a table from a sorted array
+	/// @exception std::bad_alloc Memory allocation failed
+	template <typename Allocation>
+	explicit EytzingerArray(const DynamicArray<T, Allocation>& sorted, Compare comp = Compare())
+		: EytzingerArray(sorted.data(), sorted.size(), comp)
+	{}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/// The smallest element, which is not less than value, or nullptr if there is none
+	const T* lowerBound(const T& value) const
+	{
+		const T* tree = m_tree.data();
+		size_t k = 1;
+
+		while (k <= m_size) {
+#if defined(__GNUC__)
+			// 16 * k is the leftmost node four levels below k
+			__builtin_prefetch(tree + 16 * k);
+#endif
+			k = 2 * k + m_comp(tree[k], value);
+		}
+
+		// The path went right after the last node not less than value and left ever since.
+		// Removing the trailing ones and the zero before them returns to that node.
+		k >>= bits::countTrailingZeros(~std::uint64_t(k)) + 1;
+
+		return k ? tree + k : nullptr;
+	}
+
+	/// Checks whether the table contains an element equivalent to value
+	bool contains(const T& value) const
+	{
+		const T* found = lowerBound(value);
+		return found && ! m_comp(value, *found);
+	}
+
+private:
+	/// Places the sorted elements into the subtree rooted at k with an in-order traversal
+	void fill(const T*& next, size_t k)
+	{
+		if (k > m_size)
+			return;
+
+		fill(next, 2 * k);
+		m_tree[k] = *next++;
+		fill(next, 2 * k + 1);
+	}
+};
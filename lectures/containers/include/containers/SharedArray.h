@@ -0,0 +1,242 @@
+#pragma once
+
+#include "DynamicArray.h"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+///
+/// @brief A dynamic array with reference-counted storage, which is copied on the first mutation.
+///
+/// Copying a SharedArray is O(1): the copy shares the storage of the original
+/// and increments an atomic reference count. Every member function, which can
+/// modify the elements, first *detaches* the array: if the storage is shared,
+/// the array makes a private copy of it. Readers therefore always see an
+/// immutable snapshot, taken when they copied the array.
+///
+/// The non-const operator[], at() and data() count as mutations, because the
+/// caller may write through the returned reference. Reading a shared array
+/// through them copies the storage, so read through a const reference
+/// (or get()) instead.
+///
+/// Different SharedArray objects may be used from different threads, even if
+/// they share their storage. As with other containers, a single object must
+/// not be modified by one thread while another one uses it.
+///
+template <typename T, typename Allocation = DefaultAllocation>
+class SharedArray {
+	struct Storage {
+		std::atomic<size_t> references{1};
+		DynamicArray<T, Allocation> elements;
+
+		explicit Storage(DynamicArray<T, Allocation>&& array)
+			: elements(std::move(array))
+		{}
+	};
+
+	Storage* m_storage = nullptr;
+
+public:
+	/// Thrown by pop_back() when the array is empty
+	using EmptyArrayException = typename DynamicArray<T, Allocation>::EmptyArrayException;
+
+public:
+	/// Constructs an empty array with zero capacity
+	SharedArray() noexcept = default;
+
+	/// Constructs an array with size and capacity equal to initialSize
+	/// @exception std::bad_alloc Memory allocation failed
+	explicit SharedArray(size_t initialSize, const Allocation& allocation = Allocation())
+		: m_storage(new Storage(DynamicArray<T, Allocation>(initialSize, allocation)))
+	{}
+
+	/// Takes over the elements of a DynamicArray without copying them
+	/// @exception std::bad_alloc Memory allocation failed
+	explicit SharedArray(DynamicArray<T, Allocation>&& array)
+		: m_storage(new Storage(std::move(array)))
+	{}
+
+	/// Shares the storage of other. O(1).
+	SharedArray(const SharedArray& other) noexcept
+		: m_storage(other.m_storage)
+	{
+		if (m_storage)
+			m_storage->references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	SharedArray& operator=(const SharedArray& other) noexcept
+	{
+		SharedArray copy(other);
+		swap(copy);
+		return *this;
+	}
+
+	SharedArray(SharedArray&& other) noexcept
+		: m_storage(std::exchange(other.m_storage, nullptr))
+	{}
+
+	SharedArray& operator=(SharedArray&& other) noexcept
+	{
+		SharedArray temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	~SharedArray() noexcept
+	{
+		release();
+	}
+
+	/// Number of elements stored in the array
+	size_t size() const noexcept
+	{
+		return m_storage ? m_storage->elements.size() : 0;
+	}
+
+	bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	/// Size of the underlying buffer
+	size_t capacity() const noexcept
+	{
+		return m_storage ? m_storage->elements.capacity() : 0;
+	}
+
+	/// Number of SharedArray objects, which use the same storage (0 if there is no storage)
+	size_t useCount() const noexcept
+	{
+		return m_storage ? m_storage->references.load(std::memory_order_acquire) : 0;
+	}
+
+	/// Checks whether the storage is used by other arrays as well, i.e. whether the next mutation copies it
+	bool isShared() const noexcept
+	{
+		return useCount() > 1;
+	}
+
+	/// Checks whether both arrays use the same storage
+	bool sharesStorageWith(const SharedArray& other) const noexcept
+	{
+		return m_storage && m_storage == other.m_storage;
+	}
+
+	/// Retrieve the element at index for reading. Never copies the storage.
+	const T& get(size_t index) const
+	{
+		return m_storage->elements[index];
+	}
+
+	/// Retrieve the element at index for reading
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	const T& at(size_t index) const
+	{
+		if (index >= size())
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return m_storage->elements[index];
+	}
+
+	/// Retrieve the element at index for writing. Copies the storage if it is shared.
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	T& at(size_t index)
+	{
+		if (index >= size())
+			throw std::out_of_range("index is out of the bounds of the array");
+
+		return detach()[index];
+	}
+
+	/// Retrieve the element at index for reading
+	const T& operator[](size_t index) const
+	{
+		return m_storage->elements[index];
+	}
+
+	/// Retrieve the element at index for writing. Copies the storage if it is shared.
+	T& operator[](size_t index)
+	{
+		return detach()[index];
+	}
+
+	/// Retrieve the underlying buffer for reading
+	const T* data() const noexcept
+	{
+		return m_storage ? m_storage->elements.data() : nullptr;
+	}
+
+	/// Retrieve the underlying buffer for writing. Copies the storage if it is shared.
+	T* data()
+	{
+		return m_storage ? detach().data() : nullptr;
+	}
+
+	/// Append value to the array
+	void push_back(const T& value)
+	{
+		detach().push_back(value);
+	}
+
+	/// Append value to the array, moving it into the buffer
+	void push_back(T&& value)
+	{
+		detach().push_back(std::move(value));
+	}
+
+	/// Remove the last element from the array
+	/// @exception EmptyArrayException The array is empty
+	void pop_back()
+	{
+		if (empty())
+			throw EmptyArrayException();
+
+		detach().pop_back();
+	}
+
+	/// Ensure the underlying buffer has at least a minimal capacity
+	void reserve(size_t desiredCapacity)
+	{
+		if (desiredCapacity > capacity())
+			detach().reserve(desiredCapacity);
+	}
+
+	/// Set the size of the array to a specific value
+	void resize(size_t desiredSize)
+	{
+		if (desiredSize != size())
+			detach().resize(desiredSize);
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(SharedArray& other) noexcept
+	{
+		std::swap(m_storage, other.m_storage);
+	}
+
+private:
+	/// Makes sure this object is the only user of its storage and returns the elements
+	DynamicArray<T, Allocation>& detach()
+	{
+		if ( ! m_storage) {
+			m_storage = new Storage(DynamicArray<T, Allocation>());
+		}
+		else if (m_storage->references.load(std::memory_order_acquire) != 1) {
+			// The copy is made before the reference is released, so the original stays valid if it throws
+			Storage* copy = new Storage(DynamicArray<T, Allocation>(m_storage->elements));
+			release();
+			m_storage = copy;
+		}
+
+		return m_storage->elements;
+	}
+
+	void release() noexcept
+	{
+		if (m_storage && m_storage->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete m_storage;
+
+		m_storage = nullptr;
+	}
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "ArraySpan.h"
+#include "FixedSizeArray.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+///
+/// @brief A dynamic array of records, which stores each field in a separate contiguous column.
+///
+/// SoAArray<int, double> holds the same data as DynamicArray<std::tuple<int, double>>,
+/// but as a structure of arrays: all ints are stored next to each other, and
+/// so are all doubles. A scan, which reads only one field, then reads only the
+/// memory of that field, instead of pulling whole records into the cache.
+/// Its loop also works on a plain array, which the compiler can vectorize.
+///
+/// All columns have the same capacity and grow together.
+///
+template <typename... Fields>
+class SoAArray {
+	static_assert(sizeof...(Fields) > 0, "SoAArray needs at least one field");
+
+	using Columns = std::tuple<FixedSizeArray<Fields>...>;
+	using Indices = std::index_sequence_for<Fields...>;
+
+	Columns m_columns;
+	size_t m_used = 0;
+	size_t m_capacity = 0;
+
+public:
+	/// A copy of a single record
+	using Record = std::tuple<Fields...>;
+
+	/// References to the fields of a single record
+	using Reference = std::tuple<Fields&...>;
+
+	/// Const references to the fields of a single record
+	using ConstReference = std::tuple<const Fields&...>;
+
+	/// Type of the field with index I
+	template <size_t I>
+	using FieldType = std::tuple_element_t<I, Record>;
+
+	/// Thrown when an operation, that requires the array to have at least one element,
+	/// was performed on an empty array.
+	class EmptyArrayException : public std::logic_error {
+	public:
+		EmptyArrayException()
+			: std::logic_error("Operation was performed on an empty array")
+		{}
+	};
+
+public:
+	/// Constructs an empty array with zero capacity
+	SoAArray() = default;
+
+	SoAArray(const SoAArray&) = default;
+	SoAArray& operator=(const SoAArray&) = default;
+
+	/// Takes over the columns of other, which is left empty with zero capacity
+	SoAArray(SoAArray&& other) noexcept
+		: m_columns(std::move(other.m_columns)),
+		  m_used(std::exchange(other.m_used, 0)),
+		  m_capacity(std::exchange(other.m_capacity, 0))
+	{}
+
+	SoAArray& operator=(SoAArray&& other) noexcept
+	{
+		if (this != &other) {
+			m_columns = std::move(other.m_columns);
+			m_used = std::exchange(other.m_used, 0);
+			m_capacity = std::exchange(other.m_capacity, 0);
+		}
+
+		return *this;
+	}
+
+	/// Number of records stored in the array
+	size_t size() const noexcept
+	{
+		return m_used;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_used == 0;
+	}
+
+	/// Number of records the columns can hold without reallocating
+	size_t capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	/// Retrieve the fields of the record at index
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	Reference at(size_t index)
+	{
+		checkIndex(index);
+		return (*this)[index];
+	}
+
+	/// Retrieve the fields of the record at index
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	ConstReference at(size_t index) const
+	{
+		checkIndex(index);
+		return (*this)[index];
+	}
+
+	/// Retrieve the fields of the record at index
+	Reference operator[](size_t index) noexcept
+	{
+		return referenceAt(index, Indices());
+	}
+
+	/// Retrieve the fields of the record at index
+	ConstReference operator[](size_t index) const noexcept
+	{
+		return referenceAt(index, Indices());
+	}
+
+	/// Retrieve a single field of the record at index
+	template <size_t I>
+	FieldType<I>& get(size_t index) noexcept
+	{
+		return std::get<I>(m_columns)[index];
+	}
+
+	/// Retrieve a single field of the record at index
+	template <size_t I>
+	const FieldType<I>& get(size_t index) const noexcept
+	{
+		return std::get<I>(m_columns)[index];
+	}
+
+	/// All values of the field with index I, one for each record
+	template <size_t I>
+	ArraySpan<FieldType<I>> column() noexcept
+	{
+		return ArraySpan<FieldType<I>>(std::get<I>(m_columns).data(), m_used);
+	}
+
+	/// All values of the field with index I, one for each record
+	template <size_t I>
+	ArraySpan<const FieldType<I>> column() const noexcept
+	{
+		return ArraySpan<const FieldType<I>>(std::get<I>(m_columns).data(), m_used);
+	}
+
+	/// Append a record to the array
+	/// @exception std::bad_alloc Memory allocation failed
+	void push_back(const Record& record)
+	{
+		reserve(m_used + 1);
+		assign(m_used, record, Indices());
+		++m_used;
+	}
+
+	/// Append a record to the array, moving its fields into the columns
+	/// @exception std::bad_alloc Memory allocation failed
+	void push_back(Record&& record)
+	{
+		reserve(m_used + 1);
+		assign(m_used, std::move(record), Indices());
+		++m_used;
+	}
+
+	/// Remove the last record from the array
+	void pop_back()
+	{
+		if (m_used == 0)
+			throw EmptyArrayException();
+
+		--m_used;
+	}
+
+	/// Ensure the columns have at least a minimal capacity
+	/// @exception std::bad_alloc Memory allocation failed. The array remains unchanged.
+	void reserve(size_t desiredCapacity)
+	{
+		if (desiredCapacity <= m_capacity)
+			return;
+
+		reallocate(std::max(desiredCapacity, m_capacity * 2), Indices());
+	}
+
+	/// Set the number of records in the array to a specific value
+	/// @exception std::bad_alloc Memory allocation failed
+	void resize(size_t desiredSize)
+	{
+		reserve(desiredSize);
+		m_used = desiredSize;
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(SoAArray& other) noexcept
+	{
+		swapColumns(other, Indices());
+		std::swap(m_used, other.m_used);
+		std::swap(m_capacity, other.m_capacity);
+	}
+
+private:
+	void checkIndex(size_t index) const
+	{
+		if (index >= m_used)
+			throw std::out_of_range("index is out of the bounds of the array");
+	}
+
+	template <size_t... I>
+	Reference referenceAt(size_t index, std::index_sequence<I...>) noexcept
+	{
+		return Reference(std::get<I>(m_columns)[index]...);
+	}
+
+	template <size_t... I>
+	ConstReference referenceAt(size_t index, std::index_sequence<I...>) const noexcept
+	{
+		return ConstReference(std::get<I>(m_columns)[index]...);
+	}
+
+	template <typename RecordType, size_t... I>
+	void assign(size_t index, RecordType&& record, std::index_sequence<I...>)
+	{
+		((std::get<I>(m_columns)[index] = std::get<I>(std::forward<RecordType>(record))), ...);
+	}
+
+	/// Moves all columns to new buffers. All buffers are allocated before any element is moved.
+	template <size_t... I>
+	void reallocate(size_t newCapacity, std::index_sequence<I...>)
+	{
+		Columns columns{ FixedSizeArray<Fields>(newCapacity)... };
+
+		(std::move(std::get<I>(m_columns).data(), std::get<I>(m_columns).data() + m_used, std::get<I>(columns).data()), ...);
+
+		m_columns = std::move(columns);
+		m_capacity = newCapacity;
+	}
+
+	template <size_t... I>
+	void swapColumns(SoAArray& other, std::index_sequence<I...>) noexcept
+	{
+		(std::get<I>(m_columns).swap(std::get<I>(other.m_columns)), ...);
+	}
+};
@@ -0,0 +1,373 @@
+#pragma once
+
+#include "DynamicArray.h"
+#include "FixedSizeArray.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+///
+/// Sorting algorithms for contiguous arrays.
+///
+/// Each algorithm works on a range of pointers [first, last) and has overloads
+/// for FixedSizeArray and DynamicArray, which sort all their elements.
+///
+/// - introSort() is an unstable comparison sort, like std::sort.
+/// - radixSort() sorts integers and floating-point numbers by their bits in O(n).
+/// - parallelMergeSort() is a stable comparison sort, which runs on a ThreadPool.
+///
+
+namespace sorting_detail {
+
+/// Ranges shorter than this are sorted with insertion sort
+constexpr ptrdiff_t InsertionSortThreshold = 16;
+
+/// Ranges shorter than this are not split into tasks
+constexpr ptrdiff_t ParallelThreshold = 1 << 14;
+
+template <typename T, typename Compare>
+void insertionSort(T* first, T* last, Compare& comp)
+{
+	if (first == last)
+		return;
+
+	for (T* i = first + 1; i != last; ++i) {
+		T value = std::move(*i);
+		T* j = i;
+
+		for (; j != first && comp(value, *(j - 1)); --j)
+			*j = std::move(*(j - 1));
+
+		*j = std::move(value);
+	}
+}
+
+/// Moves the median of *a, *b and *c to *result
+template <typename T, typename Compare>
+void moveMedianToFirst(T* result, T* a, T* b, T* c, Compare& comp)
+{
+	if (comp(*a, *b)) {
+		if (comp(*b, *c))
+			std::iter_swap(result, b);
+		else if (comp(*a, *c))
+			std::iter_swap(result, c);
+		else
+			std::iter_swap(result, a);
+	}
+	else if (comp(*a, *c))
+		std::iter_swap(result, a);
+	else if (comp(*b, *c))
+		std::iter_swap(result, c);
+	else
+		std::iter_swap(result, b);
+}
+
+/// Hoare partition around *pivot. The median-of-three selection guarantees that
+/// both scans stop inside the range, so they need no bounds checks.
+template <typename T, typename Compare>
+T* partition(T* first, T* last, T* pivot, Compare& comp)
+{
+	while (true) {
+		while (comp(*first, *pivot))
+			++first;
+
+		--last;
+
+		while (comp(*pivot, *last))
+			--last;
+
+		if ( ! (first < last))
+			return first;
+
+		std::iter_swap(first, last);
+		++first;
+	}
+}
+
+template <typename T, typename Compare>
+void introSortLoop(T* first, T* last, size_t depthLimit, Compare& comp)
+{
+	while (last - first > InsertionSortThreshold) {
+		if (depthLimit == 0) {
+			// Quicksort is degrading to O(n^2), fall back to heapsort
+			std::make_heap(first, last, comp);
+			std::sort_heap(first, last, comp);
+			return;
+		}
+
+		--depthLimit;
+
+		T* middle = first + (last - first) / 2;
+		moveMedianToFirst(first, first + 1, middle, last - 1, comp);
+		T* cut = partition(first + 1, last, first, comp);
+
+		// Recurse into the right part and loop on the left one
+		introSortLoop(cut, last, depthLimit, comp);
+		last = cut;
+	}
+}
+
+/// Maps a number to an unsigned integer with the same order
+template <typename T>
+auto toRadixKey(T value) noexcept
+{
+	using Key = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+		std::conditional_t<sizeof(T) == 2, std::uint16_t,
+		std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+	constexpr Key SignBit = Key(1) << (sizeof(T) * 8 - 1);
+
+	Key key;
+	std::memcpy(&key, &value, sizeof(T));
+
+	if constexpr (std::is_floating_point_v<T>) {
+		// Negative numbers have all bits flipped, so larger magnitudes come first.
+		// Positive numbers only have the sign bit flipped, so they come after them.
+		Key mask = (key & SignBit) ? Key(~Key(0)) : SignBit;
+		return Key(key ^ mask);
+	}
+	else if constexpr (std::is_signed_v<T>) {
+		return Key(key ^ SignBit);
+	}
+	else {
+		return key;
+	}
+}
+
+template <typename T, typename Compare>
+void merge(T* first1, T* last1, T* first2, T* last2, T* output, Compare& comp, ThreadPool& pool);
+
+///
+/// Sorts [first, last) stably. The result is placed in [first, last) or, if intoBuffer
+/// is true, in the buffer (of the same size). Each level of the recursion sorts the
+/// halves into the other array, so the merges never have to copy their output back.
+///
+template <typename T, typename Compare>
+void mergeSort(T* first, T* last, T* buffer, bool intoBuffer, Compare& comp, ThreadPool& pool)
+{
+	ptrdiff_t size = last - first;
+
+	if (size < ParallelThreshold) {
+		std::stable_sort(first, last, comp);
+
+		if (intoBuffer)
+			std::move(first, last, buffer);
+
+		return;
+	}
+
+	ptrdiff_t half = size / 2;
+
+	{
+		TaskGroup group(pool);
+		group.run([&]() { mergeSort(first, first + half, buffer, ! intoBuffer, comp, pool); });
+		mergeSort(first + half, last, buffer + half, ! intoBuffer, comp, pool);
+		group.wait();
+	}
+
+	if (intoBuffer)
+		merge(first, first + half, first + half, last, buffer, comp, pool);
+	else
+		merge(buffer, buffer + half, buffer + half, buffer + size, first, comp, pool);
+}
+
+///
+/// Moves two sorted runs into output, keeping the elements of the first run
+/// before equal elements of the second one.
+///
+/// The larger run is split at its middle element and the other one at the
+/// matching position, which divides the merge into two independent halves.
+///
+template <typename T, typename Compare>
+void merge(T* first1, T* last1, T* first2, T* last2, T* output, Compare& comp, ThreadPool& pool)
+{
+	ptrdiff_t size1 = last1 - first1;
+	ptrdiff_t size2 = last2 - first2;
+
+	if (size1 + size2 < ParallelThreshold) {
+		std::merge(
+			std::make_move_iterator(first1), std::make_move_iterator(last1),
+			std::make_move_iterator(first2), std::make_move_iterator(last2),
+			output, comp);
+		return;
+	}
+
+	T* split1;
+	T* split2;
+
+	if (size1 >= size2) {
+		split1 = first1 + size1 / 2;
+		split2 = std::lower_bound(first2, last2, *split1, comp);
+	}
+	else {
+		split2 = first2 + size2 / 2;
+		split1 = std::upper_bound(first1, last1, *split2, comp);
+	}
+
+	T* splitOutput = output + (split1 - first1) + (split2 - first2);
+
+	TaskGroup group(pool);
+	group.run([&]() { merge(first1, split1, first2, split2, output, comp, pool); });
+	merge(split1, last1, split2, last2, splitOutput, comp, pool);
+	group.wait();
+}
+
+} // namespace sorting_detail
+
+///
+/// Sorts [first, last) with introsort: quicksort with a median-of-three pivot,
+/// which switches to heapsort if the recursion gets too deep and to insertion
+/// sort for short ranges. O(n log n) in the worst case. Not stable.
+///
+template <typename T, typename Compare = std::less<>>
+void introSort(T* first, T* last, Compare comp = Compare())
+{
+	size_t size = static_cast<size_t>(last - first);
+	size_t depthLimit = 0;
+
+	for (size_t n = size; n > 1; n /= 2)
+		depthLimit += 2;
+
+	sorting_detail::introSortLoop(first, last, depthLimit, comp);
+	sorting_detail::insertionSort(first, last, comp);
+}
+
+///
+/// Sorts integers, floats or doubles in ascending order with an LSD radix sort.
+///
+/// The elements are distributed by one byte at a time, starting with the least
+/// significant one, so the sort takes O(n * sizeof(T)) time regardless of the
+/// order of the input. The counts for all bytes are gathered in a single pass and
+/// bytes, which are the same in all elements, are skipped.
+///
+/// Negative zero is placed before positive zero. NaNs are placed at the ends,
+/// depending on their sign bit.
+///
+/// @exception std::bad_alloc Allocating the scratch buffer failed
+///
+template <typename T>
+void radixSort(T* first, T* last)
+{
+	static_assert(std::is_arithmetic_v<T> && ! std::is_same_v<T, bool> && sizeof(T) <= 8,
+		"radixSort() sorts integers of up to 64 bits, float and double (not bool or long double)");
+
+	constexpr size_t Digits = sizeof(T);
+	constexpr size_t Buckets = 256;
+
+	size_t size = static_cast<size_t>(last - first);
+
+	// For short ranges the passes over the counts cost more than a comparison sort
+	if (size < 256) {
+		introSort(first, last);
+		return;
+	}
+
+	size_t counts[Digits][Buckets] = {};
+
+	for (size_t i = 0; i < size; ++i) {
+		auto key = sorting_detail::toRadixKey(first[i]);
+
+		for (size_t digit = 0; digit < Digits; ++digit)
+			++counts[digit][(key >> (8 * digit)) & 0xFF];
+	}
+
+	FixedSizeArray<T> buffer(size);
+	T* source = first;
+	T* target = buffer.data();
+
+	for (size_t digit = 0; digit < Digits; ++digit) {
+		size_t* offsets = counts[digit];
+
+		// All elements have the same byte, so this pass would not move them
+		if (offsets[(sorting_detail::toRadixKey(source[0]) >> (8 * digit)) & 0xFF] == size)
+			continue;
+
+		size_t offset = 0;
+
+		for (size_t bucket = 0; bucket < Buckets; ++bucket) {
+			size_t count = offsets[bucket];
+			offsets[bucket] = offset;
+			offset += count;
+		}
+
+		for (size_t i = 0; i < size; ++i) {
+			auto key = sorting_detail::toRadixKey(source[i]);
+			target[offsets[(key >> (8 * digit)) & 0xFF]++] = source[i];
+		}
+
+		std::swap(source, target);
+	}
+
+	if (source != first)
+		std::copy(source, source + size, first);
+}
+
+///
+/// Sorts [first, last) stably with a merge sort, which runs on a ThreadPool.
+///
+/// The range is halved recursively and the halves are sorted as separate
+/// tasks. The sorted halves are then merged, also in parallel, by splitting
+/// the larger one at its middle and the other at the matching position.
+/// Idle workers steal the largest pending pieces, so the work stays balanced.
+/// Ranges shorter than 16K elements are sorted on the calling thread.
+///
+/// T must be default-constructible, because the merges need a scratch buffer.
+///
+/// @exception std::bad_alloc Allocating the scratch buffer failed
+/// @exception Rethrows the first exception thrown by comp
+///
+template <typename T, typename Compare = std::less<>>
+void parallelMergeSort(T* first, T* last, Compare comp = Compare(), ThreadPool& pool = ThreadPool::shared())
+{
+	ptrdiff_t size = last - first;
+
+	if (size < sorting_detail::ParallelThreshold) {
+		std::stable_sort(first, last, comp);
+		return;
+	}
+
+	FixedSizeArray<T> buffer(static_cast<size_t>(size));
+	sorting_detail::mergeSort(first, last, buffer.data(), false, comp, pool);
+}
+
+template <typename T, typename Allocation, typename Compare = std::less<>>
+void introSort(FixedSizeArray<T, Allocation>& arr, Compare comp = Compare())
+{
+	introSort(arr.data(), arr.data() + arr.size(), comp);
+}
+
+template <typename T, typename Allocation, typename Compare = std::less<>>
+void introSort(DynamicArray<T, Allocation>& arr, Compare comp = Compare())
+{
+	introSort(arr.data(), arr.data() + arr.size(), comp);
+}
+
+template <typename T, typename Allocation>
+void radixSort(FixedSizeArray<T, Allocation>& arr)
+{
+	radixSort(arr.data(), arr.data() + arr.size());
+}
+
+template <typename T, typename Allocation>
+void radixSort(DynamicArray<T, Allocation>& arr)
+{
+	radixSort(arr.data(), arr.data() + arr.size());
+}
+
+template <typename T, typename Allocation, typename Compare = std::less<>>
+void parallelMergeSort(FixedSizeArray<T, Allocation>& arr, Compare comp = Compare(), ThreadPool& pool = ThreadPool::shared())
+{
+	parallelMergeSort(arr.data(), arr.data() + arr.size(), comp, pool);
+}
+
+template <typename T, typename Allocation, typename Compare = std::less<>>
+void parallelMergeSort(DynamicArray<T, Allocation>& arr, Compare comp = Compare(), ThreadPool& pool = ThreadPool::shared())
+{
+	parallelMergeSort(arr.data(), arr.data() + arr.size(), comp, pool);
+}
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+///
+/// @brief An array, which stores only the runs of elements that differ from the default value T().
+///
+/// Each run is a contiguous range of non-default elements, kept in its own
+/// DynamicArray together with the index of its first element. The runs are
+/// sorted by that index, so reading an element is a binary search over the
+/// runs, and iterating over the non-default elements walks contiguous memory.
+///
+/// Setting an element next to a run extends the run, and runs that touch are
+/// merged. Setting an element to T() removes it from its run, which may split
+/// the run in two. Filling the array in increasing index order is amortized
+/// O(1) per element. T must be comparable with ==.
+///
+template <typename T>
+class SparseArray {
+	struct Run {
+		size_t first = 0;
+		DynamicArray<T> values;
+
+		size_t end() const noexcept
+		{
+			return first + values.size();
+		}
+	};
+
+	DynamicArray<Run> m_runs;
+	size_t m_size = 0;
+	T m_default = T();
+
+public:
+	/// Thrown when an operation, that requires the array to have at least one element,
+	/// was performed on an empty array.
+	class EmptyArrayException : public std::logic_error {
+	public:
+		EmptyArrayException()
+			: std::logic_error("Operation was performed on an empty array")
+		{}
+	};
+
+public:
+	/// Constructs an array of size default elements, without allocating memory
+	explicit SparseArray(size_t size = 0) noexcept
+		: m_size(size)
+	{}
+
+	SparseArray(const SparseArray&) = default;
+	SparseArray& operator=(const SparseArray&) = default;
+
+	/// Takes over the runs of other, which is left with zero elements
+	SparseArray(SparseArray&& other) noexcept
+		: m_runs(std::move(other.m_runs)), m_size(std::exchange(other.m_size, 0))
+	{}
+
+	SparseArray& operator=(SparseArray&& other) noexcept
+	{
+		if (this != &other) {
+			m_runs = std::move(other.m_runs);
+			m_size = std::exchange(other.m_size, 0);
+		}
+
+		return *this;
+	}
+
+	/// Number of elements in the array, including the default ones
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/// Number of runs of non-default elements
+	size_t runCount() const noexcept
+	{
+		return m_runs.size();
+	}
+
+	/// Number of elements, which are actually stored
+	size_t storedCount() const noexcept
+	{
+		size_t count = 0;
+
+		for (size_t i = 0; i < m_runs.size(); ++i)
+			count += m_runs[i].values.size();
+
+		return count;
+	}
+
+	/// Retrieve the element at index
+	const T& operator[](size_t index) const noexcept
+	{
+		size_t run = runAtOrBefore(index);
+
+		if (run != NoRun && index < m_runs[run].end())
+			return m_runs[run].values[index - m_runs[run].first];
+
+		return m_default;
+	}
+
+	/// Retrieve the element at index
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	const T& at(size_t index) const
+	{
+		checkIndex(index);
+		return (*this)[index];
+	}
+
+	/// Replace the element at index. Setting it to T() removes it from the storage.
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	void set(size_t index, const T& value)
+	{
+		checkIndex(index);
+
+		if (value == m_default) {
+			reset(index);
+			return;
+		}
+
+		size_t run = runAtOrBefore(index);
+
+		if (run != NoRun && index < m_runs[run].end()) {
+			m_runs[run].values[index - m_runs[run].first] = value;
+			return;
+		}
+
+		if (run != NoRun && index == m_runs[run].end()) {
+			m_runs[run].values.push_back(value);
+			mergeWithNext(run);
+			return;
+		}
+
+		// The element starts a new run, unless it is right in front of the next one
+		size_t next = run == NoRun ? 0 : run + 1;
+
+		if (next < m_runs.size() && m_runs[next].first == index + 1) {
+			prepend(m_runs[next], value);
+			return;
+		}
+
+		Run created;
+		created.first = index;
+		created.values.push_back(value);
+		insertRun(next, std::move(created));
+	}
+
+	/// Set the element at index back to T(), releasing its storage
+	/// @exception std::out_of_range If the index is out of the bounds of the array
+	void reset(size_t index)
+	{
+		checkIndex(index);
+
+		size_t run = runAtOrBefore(index);
+
+		if (run == NoRun || index >= m_runs[run].end())
+			return;
+
+		Run& current = m_runs[run];
+		size_t offset = index - current.first;
+		size_t count = current.values.size();
+
+		if (count == 1) {
+			eraseRun(run);
+		}
+		else if (offset == count - 1) {
+			current.values.pop_back();
+		}
+		else if (offset == 0) {
+			std::move(current.values.data() + 1, current.values.data() + count, current.values.data());
+			current.values.pop_back();
+			++current.first;
+		}
+		else {
+			// Split the run: the elements after index move to a new run
+			Run tail;
+			tail.first = index + 1;
+			tail.values.reserve(count - offset - 1);
+
+			for (size_t i = offset + 1; i < count; ++i)
+				tail.values.push_back(std::move(current.values[i]));
+
+			current.values.resize(offset);
+			insertRun(run + 1, std::move(tail));
+		}
+	}
+
+	/// Append value to the array
+	void push_back(const T& value)
+	{
+		++m_size;
+		set(m_size - 1, value);
+	}
+
+	/// Remove the last element from the array
+	/// @exception EmptyArrayException The array is empty
+	void pop_back()
+	{
+		if (m_size == 0)
+			throw EmptyArrayException();
+
+		reset(m_size - 1);
+		--m_size;
+	}
+
+	/// Set the number of elements. New elements have the default value.
+	void resize(size_t desiredSize)
+	{
+		while (m_runs.size() && m_runs[m_runs.size() - 1].first >= desiredSize)
+			m_runs.pop_back();
+
+		if (m_runs.size() && m_runs[m_runs.size() - 1].end() > desiredSize) {
+			Run& last = m_runs[m_runs.size() - 1];
+			last.values.resize(desiredSize - last.first);
+		}
+
+		m_size = desiredSize;
+	}
+
+	/// Calls function(index, value) for each non-default element in index order
+	template <typename Function>
+	void forEachNonDefault(Function function) const
+	{
+		for (size_t run = 0; run < m_runs.size(); ++run) {
+			const Run& current = m_runs[run];
+
+			for (size_t i = 0; i < current.values.size(); ++i)
+				function(current.first + i, current.values[i]);
+		}
+	}
+
+	/// Calls function(first, values, count) for each run of non-default elements in index order
+	template <typename Function>
+	void forEachRun(Function function) const
+	{
+		for (size_t run = 0; run < m_runs.size(); ++run)
+			function(m_runs[run].first, m_runs[run].values.data(), m_runs[run].values.size());
+	}
+
+	/// Quickly swaps the contents of this object with that of another
+	void swap(SparseArray& other) noexcept
+	{
+		m_runs.swap(other.m_runs);
+		std::swap(m_size, other.m_size);
+	}
+
+private:
+	static constexpr size_t NoRun = size_t(-1);
+
+	void checkIndex(size_t index) const
+	{
+		if (index >= m_size)
+			throw std::out_of_range("index is out of the bounds of the array");
+	}
+
+	/// The last run, which starts at or before index, or NoRun
+	size_t runAtOrBefore(size_t index) const noexcept
+	{
+		// Appending is the common case, so check the last run before searching
+		size_t count = m_runs.size();
+
+		if (count == 0)
+			return NoRun;
+
+		if (m_runs[count - 1].first <= index)
+			return count - 1;
+
+		const Run* begin = m_runs.data();
+		const Run* found = std::upper_bound(begin, begin + count, index, [](size_t value, const Run& run) {
+			return value < run.first;
+		});
+
+		return found == begin ? NoRun : size_t(found - begin) - 1;
+	}
+
+	static void prepend(Run& run, const T& value)
+	{
+		size_t count = run.values.size();
+		run.values.push_back(value);
+		std::move_backward(run.values.data(), run.values.data() + count, run.values.data() + count + 1);
+		run.values[0] = value;
+		--run.first;
+	}
+
+	void mergeWithNext(size_t run)
+	{
+		if (run + 1 >= m_runs.size() || m_runs[run].end() != m_runs[run + 1].first)
+			return;
+
+		Run& next = m_runs[run + 1];
+
+		for (size_t i = 0; i < next.values.size(); ++i)
+			m_runs[run].values.push_back(std::move(next.values[i]));
+
+		eraseRun(run + 1);
+	}
+
+	void insertRun(size_t position, Run&& run)
+	{
+		m_runs.push_back(std::move(run));
+		std::rotate(m_runs.data() + position, m_runs.data() + m_runs.size() - 1, m_runs.data() + m_runs.size());
+	}
+
+	void eraseRun(size_t position)
+	{
+		std::move(m_runs.data() + position + 1, m_runs.data() + m_runs.size(), m_runs.data() + position);
+
+		// The last run was moved from, but it still holds the capacity of its buffer
+		m_runs[m_runs.size() - 1] = Run();
+		m_runs.pop_back();
+	}
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CacheLine.h"
+#include "FixedSizeArray.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+
+///
+/// @brief A bounded lock-free queue for exactly one producer and one consumer thread.
+///
+/// The slots are stored in a FixedSizeArray, whose size is a power of two.
+/// The producer owns the tail index and the consumer owns the head index.
+/// They are kept on separate cache lines. Each side also keeps a cached copy
+/// of the other side's index and reloads it only when the queue looks full
+/// (or empty). So most operations touch no cache line written by the other
+/// thread, apart from the slot itself.
+///
+template <typename T>
+class SpscQueue {
+	FixedSizeArray<T> m_slots;
+	size_t m_mask;
+
+	// Written by the consumer
+	alignas(CacheLineSize) std::atomic<size_t> m_head{0};
+	size_t m_cachedTail = 0;
+
+	// Written by the producer
+	alignas(CacheLineSize) std::atomic<size_t> m_tail{0};
+	size_t m_cachedHead = 0;
+
+public:
+	/// Constructs a queue, which can hold at least capacity elements.
+	/// The capacity is rounded up to a power of two.
+	/// @exception std::bad_alloc Memory allocation failed
+	explicit SpscQueue(size_t capacity)
+		: m_slots(roundCapacity(capacity)), m_mask(m_slots.size() - 1)
+	{}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	/// Maximum number of elements in the queue
+	size_t capacity() const noexcept
+	{
+		return m_slots.size();
+	}
+
+	/// Appends a copy of value, unless the queue is full.
+	/// May only be called by the producer thread.
+	/// @return false if the queue is full
+	bool tryPush(const T& value)
+	{
+		return emplace(value);
+	}
+
+	/// Appends value, unless the queue is full.
+	/// May only be called by the producer thread.
+	/// @return false if the queue is full
+	bool tryPush(T&& value)
+	{
+		return emplace(std::move(value));
+	}
+
+	/// Moves the first element into result, unless the queue is empty.
+	/// May only be called by the consumer thread.
+	/// @return false if the queue is empty
+	bool tryPop(T& result)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+
+		if (head == m_cachedTail) {
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+			if (head == m_cachedTail)
+				return false;
+		}
+
+		result = std::move(m_slots[head & m_mask]);
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Appends value, waiting while the queue is full
+	void push(T value)
+	{
+		while ( ! tryPush(std::move(value)))
+			std::this_thread::yield();
+	}
+
+	/// Removes and returns the first element, waiting while the queue is empty
+	T pop()
+	{
+		T result;
+
+		while ( ! tryPop(result))
+			std::this_thread::yield();
+
+		return result;
+	}
+
+private:
+	template <typename U>
+	bool emplace(U&& value)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+
+		if (tail - m_cachedHead == capacity()) {
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+
+			if (tail - m_cachedHead == capacity())
+				return false;
+		}
+
+		m_slots[tail & m_mask] = std::forward<U>(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	static size_t roundCapacity(size_t capacity) noexcept
+	{
+		size_t rounded = 1;
+
+		while (rounded < capacity)
+			rounded *= 2;
+
+		return rounded;
+	}
+};
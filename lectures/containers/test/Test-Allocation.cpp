@@ -0,0 +1,266 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/DynamicArray.h"
+#include "containers/FixedSizeArray.h"
+#include "utils/Arena.h"
+#include "utils/ObjectPool.h"
+
+#include <cstdint>
+#include <string>
+
+template <typename T>
+bool isAligned(const T* p, size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+/// Counts the bytes that are currently allocated through it
+struct CountingAllocation : DefaultAllocation {
+  static inline size_t allocatedBytes = 0;
+
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    void* p = DefaultAllocation::allocate(bytes, alignment);
+    allocatedBytes += bytes;
+    return p;
+  }
+
+  void deallocate(void* p, size_t bytes, size_t alignment) noexcept
+  {
+    allocatedBytes -= bytes;
+    DefaultAllocation::deallocate(p, bytes, alignment);
+  }
+};
+
+/// Throws from its constructor after a number of objects have been created
+struct ThrowingConstructor {
+  static inline int remaining = 0;
+  static inline int alive = 0;
+
+  ThrowingConstructor()
+  {
+    if (remaining-- == 0)
+      throw std::runtime_error("constructor failed");
+
+    ++alive;
+  }
+
+  ~ThrowingConstructor()
+  {
+    --alive;
+  }
+};
+
+TEST_CASE("FixedSizeArray with CacheLineAllocation starts at a cache line", "[Allocation]")
+{
+  for (size_t size : { 1, 3, 1000 }) {
+    FixedSizeArray<char, CacheLineAllocation> arr(size);
+    CHECK(isAligned(arr.data(), CacheLineSize));
+  }
+}
+
+TEST_CASE("FixedSizeArray with SimdAllocation is aligned to 64 bytes", "[Allocation]")
+{
+  for (size_t size : { 1, 3, 1000 }) {
+    FixedSizeArray<float, SimdAllocation> arr(size);
+    CHECK(isAligned(arr.data(), 64));
+  }
+}
+
+TEST_CASE("FixedSizeArray with HugePageAllocation is aligned to a huge page", "[Allocation]")
+{
+  // Both smaller and larger than a single huge page
+  for (size_t size : { size_t(100), HugePageAllocation::HugePageSize + 1, 3 * HugePageAllocation::HugePageSize }) {
+    FixedSizeArray<char, HugePageAllocation> arr(size);
+    REQUIRE(isAligned(arr.data(), HugePageAllocation::HugePageSize));
+
+    for (size_t i = 0; i < arr.size(); ++i)
+      arr[i] = static_cast<char>(i);
+
+    CHECK(arr[size - 1] == static_cast<char>(size - 1));
+  }
+}
+
+TEST_CASE("FixedSizeArray with HugePageAllocation throws when memory allocation fails", "[Allocation]")
+{
+  const size_t sizeTooLargeForTheHeap = 100'000'000'000'000;
+  REQUIRE_THROWS_AS((FixedSizeArray<int, HugePageAllocation>(sizeTooLargeForTheHeap)), std::bad_alloc);
+}
+
+TEST_CASE("FixedSizeArray copies keep the allocation policy", "[Allocation]")
+{
+  FixedSizeArray<int, CacheLineAllocation> arr(10);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    arr[i] = static_cast<int>(i);
+
+  FixedSizeArray<int, CacheLineAllocation> copy(arr);
+  CHECK(isAligned(copy.data(), CacheLineSize));
+  CHECK(copy == arr);
+
+  FixedSizeArray<int> plain(10);
+  plain.fillFrom(arr);
+  CHECK(plain[9] == 9);
+}
+
+TEST_CASE("FixedSizeArray returns all memory to its allocation policy", "[Allocation]")
+{
+  {
+    FixedSizeArray<std::string, CountingAllocation> arr(100);
+    arr[99] = std::string(100, 'a');
+
+    CHECK(CountingAllocation::allocatedBytes == 100 * sizeof(std::string));
+
+    FixedSizeArray<std::string, CountingAllocation> copy(arr);
+    CHECK(CountingAllocation::allocatedBytes == 200 * sizeof(std::string));
+    CHECK(copy[99] == arr[99]);
+  }
+
+  CHECK(CountingAllocation::allocatedBytes == 0);
+}
+
+TEST_CASE("FixedSizeArray releases the memory when an element's constructor throws", "[Allocation]")
+{
+  ThrowingConstructor::remaining = 5;
+  ThrowingConstructor::alive = 0;
+
+  REQUIRE_THROWS_AS((FixedSizeArray<ThrowingConstructor, CountingAllocation>(10)), std::runtime_error);
+  CHECK(ThrowingConstructor::alive == 0);
+  CHECK(CountingAllocation::allocatedBytes == 0);
+}
+
+TEST_CASE("DynamicArray uses its allocation policy when growing", "[Allocation]")
+{
+  DynamicArray<double, SimdAllocation> arr;
+
+  for (int i = 0; i < 1000; ++i) {
+    arr.push_back(i);
+    REQUIRE(isAligned(arr.data(), 64));
+  }
+
+  arr.shrink_to_fit();
+  CHECK(isAligned(arr.data(), 64));
+  CHECK(arr[999] == 999);
+}
+
+TEST_CASE("DynamicArray with MemoryResourceAllocation obtains its memory from the resource", "[Allocation]")
+{
+  Arena arena;
+  DynamicArray<int, MemoryResourceAllocation> arr(&arena);
+
+  for (int i = 0; i < 1000; ++i)
+    arr.push_back(i);
+
+  CHECK(arr.allocation().resource() == &arena);
+  CHECK(arena.bytesUsed() >= 1000 * sizeof(int));
+
+  DynamicArray<int, MemoryResourceAllocation> copy(arr);
+  CHECK(copy.allocation().resource() == &arena);
+  CHECK(copy[999] == 999);
+}
+
+TEST_CASE("DynamicArray with MemoryResourceAllocation returns its blocks to an ObjectPool", "[Allocation]")
+{
+  ObjectPool pool(256);
+
+  {
+    DynamicArray<int, MemoryResourceAllocation> arr(&pool);
+
+    for (int i = 0; i < 64; ++i)
+      arr.push_back(i);
+
+    CHECK(pool.blocksInUse() == 1);
+  }
+
+  CHECK(pool.blocksInUse() == 0);
+}
+
+TEST_CASE("MemoryResourceAllocation uses the default resource by default", "[Allocation]")
+{
+  DynamicArray<int, MemoryResourceAllocation> arr;
+  arr.push_back(1);
+
+  CHECK(arr.allocation().resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("CanReallocate detects policies, which provide reallocate()", "[Allocation]")
+{
+  STATIC_REQUIRE(CanReallocate<RemappableAllocation>::value);
+  STATIC_REQUIRE( ! CanReallocate<DefaultAllocation>::value);
+  STATIC_REQUIRE( ! CanReallocate<MemoryResourceAllocation>::value);
+}
+
+TEST_CASE("RemappableAllocation preserves the contents of a buffer when resizing it", "[Allocation]")
+{
+  RemappableAllocation allocation;
+  const size_t small = 4096;
+  const size_t large = 4 * RemappableAllocation::MinMappedSize;
+
+  unsigned char* p = static_cast<unsigned char*>(allocation.allocate(small, alignof(int)));
+
+  for (size_t i = 0; i < small; ++i)
+    p[i] = static_cast<unsigned char>(i);
+
+  // From operator new to a mapping, from a mapping to a larger one and back
+  p = static_cast<unsigned char*>(allocation.reallocate(p, small, large, alignof(int)));
+  p[large - 1] = 42;
+  p = static_cast<unsigned char*>(allocation.reallocate(p, large, 2 * large, alignof(int)));
+  p = static_cast<unsigned char*>(allocation.reallocate(p, 2 * large, small, alignof(int)));
+
+  for (size_t i = 0; i < small; ++i)
+    REQUIRE(p[i] == static_cast<unsigned char>(i));
+
+  allocation.deallocate(p, small, alignof(int));
+}
+
+TEST_CASE("FixedSizeArray::reallocate() keeps the values of the elements", "[Allocation]")
+{
+  FixedSizeArray<int, RemappableAllocation> arr(10);
+
+  for (int i = 0; i < 10; ++i)
+    arr[i] = i;
+
+  SECTION("Growing") {
+    const size_t size = RemappableAllocation::MinMappedSize;
+    arr.reallocate(size);
+    arr[size - 1] = -1;
+
+    REQUIRE(arr.size() == size);
+    CHECK(arr[9] == 9);
+    CHECK(arr[size - 1] == -1);
+  }
+
+  SECTION("Shrinking") {
+    arr.reallocate(5);
+
+    REQUIRE(arr.size() == 5);
+    CHECK(arr[4] == 4);
+  }
+
+  SECTION("Shrinking to zero") {
+    arr.reallocate(0);
+
+    CHECK(arr.empty());
+    CHECK(arr.data() == nullptr);
+  }
+}
+
+TEST_CASE("DynamicArray with RemappableAllocation grows past the mapping threshold", "[Allocation]")
+{
+  DynamicArray<int, RemappableAllocation> arr;
+  const int count = static_cast<int>(4 * RemappableAllocation::MinMappedSize / sizeof(int));
+
+  for (int i = 0; i < count; ++i)
+    arr.push_back(i);
+
+  REQUIRE(arr.size() == static_cast<size_t>(count));
+  CHECK(arr[0] == 0);
+  CHECK(arr[count / 2] == count / 2);
+  CHECK(arr[count - 1] == count - 1);
+
+  arr.resize(10);
+  arr.shrink_to_fit();
+
+  CHECK(arr.capacity() == 10);
+  CHECK(arr[9] == 9);
+}
@@ -0,0 +1,165 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/ArrayQueue.h"
+
+#include <queue>
+#include <string>
+
+TEST_CASE("ArrayQueue::ArrayQueue() constructs an empty queue", "[ArrayQueue]")
+{
+  ArrayQueue<int> queue;
+  CHECK(queue.size() == 0);
+  CHECK(queue.empty());
+  CHECK(queue.capacity() == 0);
+}
+
+TEST_CASE("ArrayQueue::front(), back() and pop() throw when the queue is empty", "[ArrayQueue]")
+{
+  ArrayQueue<int> queue;
+  const ArrayQueue<int>& cref = queue;
+
+  REQUIRE_THROWS_AS(queue.front(), ArrayQueue<int>::EmptyQueueException);
+  REQUIRE_THROWS_AS(cref.front(), ArrayQueue<int>::EmptyQueueException);
+  REQUIRE_THROWS_AS(queue.back(), ArrayQueue<int>::EmptyQueueException);
+  REQUIRE_THROWS_AS(cref.back(), ArrayQueue<int>::EmptyQueueException);
+  REQUIRE_THROWS_AS(queue.pop(), ArrayQueue<int>::EmptyQueueException);
+}
+
+TEST_CASE("ArrayQueue returns the elements in the order they were added", "[ArrayQueue]")
+{
+  ArrayQueue<size_t> queue;
+  const size_t count = 1000;
+
+  for (size_t i = 0; i < count; ++i) {
+    queue.push(i);
+    REQUIRE(queue.front() == 0);
+    REQUIRE(queue.back() == i);
+  }
+
+  REQUIRE(queue.size() == count);
+
+  for (size_t i = 0; i < count; ++i) {
+    REQUIRE(queue.front() == i);
+    queue.pop();
+  }
+
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("ArrayQueue::capacity() is always a power of two", "[ArrayQueue]")
+{
+  ArrayQueue<int> queue;
+  queue.reserve(100);
+
+  CHECK(queue.capacity() == 128);
+
+  for (int i = 0; i < 129; ++i)
+    queue.push(i);
+
+  CHECK(queue.capacity() == 256);
+}
+
+TEST_CASE("ArrayQueue keeps the order of the elements when growing a wrapped-around buffer", "[ArrayQueue]")
+{
+  ArrayQueue<int> queue;
+  std::queue<int> expected;
+
+  // Interleave pushes and pops, so that the ring wraps around before each growth
+  int next = 0;
+
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 3 * (round + 1); ++i) {
+      queue.push(next);
+      expected.push(next);
+      ++next;
+    }
+
+    for (int i = 0; i < round + 1; ++i) {
+      REQUIRE(queue.front() == expected.front());
+      queue.pop();
+      expected.pop();
+    }
+
+    REQUIRE(queue.size() == expected.size());
+    REQUIRE(queue.back() == expected.back());
+  }
+
+  while ( ! expected.empty()) {
+    REQUIRE(queue.front() == expected.front());
+    queue.pop();
+    expected.pop();
+  }
+
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("ArrayQueue does not reallocate while its size stays below the capacity", "[ArrayQueue]")
+{
+  ArrayQueue<int> queue;
+  queue.reserve(ArrayQueue<int>::MinCapacity);
+
+  size_t capacity = queue.capacity();
+
+  for (int i = 0; i < 10'000; ++i) {
+    queue.push(i);
+    queue.push(i);
+    queue.pop();
+    queue.pop();
+  }
+
+  CHECK(queue.capacity() == capacity);
+}
+
+TEST_CASE("ArrayQueue::pop() releases the resources held by the removed element", "[ArrayQueue]")
+{
+  ArrayQueue<std::string> queue;
+  queue.push(std::string(100, 'a'));
+  queue.push("b");
+
+  const std::string* removed = &queue.front();
+  queue.pop();
+
+  CHECK(removed->empty());
+  CHECK(queue.front() == "b");
+}
+
+TEST_CASE("ArrayQueue::swap() correctly swaps the contents of two queues", "[ArrayQueue]")
+{
+  ArrayQueue<int> a, b;
+  a.push(1);
+  a.push(2);
+  b.push(3);
+
+  a.swap(b);
+
+  CHECK(a.size() == 1);
+  CHECK(a.front() == 3);
+  CHECK(b.size() == 2);
+  CHECK(b.front() == 1);
+  CHECK(b.back() == 2);
+}
+
+TEST_CASE("ArrayQueue can be used after it has been moved from", "[ArrayQueue]")
+{
+  ArrayQueue<int> source;
+
+  for (int i = 0; i < 10; ++i)
+    source.push(i);
+
+  ArrayQueue<int> target(std::move(source));
+  CHECK(target.size() == 10);
+  CHECK(target.front() == 0);
+  CHECK(source.size() == 0);
+  CHECK(source.capacity() == 0);
+
+  source.push(42);
+  CHECK(source.front() == 42);
+
+  target = std::move(source);
+  CHECK(target.size() == 1);
+  CHECK(target.front() == 42);
+  CHECK(source.empty());
+
+  source.push(7);
+  CHECK(source.back() == 7);
+}
@@ -0,0 +1,186 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/ArraySerialization.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/// A file in the temporary directory, which is removed at the end of the test
+class ArrayFileFixture {
+protected:
+  const std::string path = (std::filesystem::temp_directory_path() / "Test-ArraySerialization.bin").string();
+
+public:
+  ArrayFileFixture()
+  {
+    std::filesystem::remove(path);
+  }
+
+  ~ArrayFileFixture()
+  {
+    std::filesystem::remove(path);
+  }
+
+  /// Overwrites a single byte of the file
+  void corruptByte(size_t offset)
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(offset);
+    char byte = static_cast<char>(file.get());
+    file.seekp(offset);
+    file.put(static_cast<char>(byte ^ 0xFF));
+  }
+
+  /// Reverses the order of count bytes of the file, as if they were written on a machine with the opposite byte order
+  void reverseBytes(size_t offset, size_t count)
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    std::string bytes(count, '\0');
+    file.seekg(offset);
+    file.read(&bytes[0], count);
+    std::reverse(bytes.begin(), bytes.end());
+    file.seekp(offset);
+    file.write(bytes.data(), count);
+  }
+};
+
+TEST_CASE("arrayElementTypeOf() identifies the fundamental types", "[ArraySerialization]")
+{
+  CHECK(arrayElementTypeOf<std::int8_t>() == ArrayElementType::Int8);
+  CHECK(arrayElementTypeOf<std::uint16_t>() == ArrayElementType::UInt16);
+  CHECK(arrayElementTypeOf<int>() == ArrayElementType::Int32);
+  CHECK(arrayElementTypeOf<std::uint64_t>() == ArrayElementType::UInt64);
+  CHECK(arrayElementTypeOf<float>() == ArrayElementType::Float);
+  CHECK(arrayElementTypeOf<double>() == ArrayElementType::Double);
+  CHECK(arrayElementTypeOf<char>() == ArrayElementType::Char);
+  CHECK(arrayElementTypeOf<bool>() == ArrayElementType::Bool);
+
+  struct Point { int x, y; };
+  CHECK(arrayElementTypeOf<Point>() == ArrayElementType::Other);
+}
+
+TEST_CASE_METHOD(ArrayFileFixture, "loadArray() returns the elements saved from a FixedSizeArray", "[ArraySerialization]")
+{
+  FixedSizeArray<double> arr(10'000);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    arr[i] = i * 0.5;
+
+  saveArray(path, arr);
+  CHECK(std::filesystem::file_size(path) == sizeof(ArrayFileHeader) + arr.size() * sizeof(double));
+
+  ArrayFileView<double> view = loadArray<double>(path);
+
+  REQUIRE(view.size() == arr.size());
+  REQUIRE(reinterpret_cast<std::uintptr_t>(view.data()) % alignof(double) == 0);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    REQUIRE(view[i] == arr[i]);
+}
+
+TEST_CASE_METHOD(ArrayFileFixture, "loadArray() returns the elements saved from a DynamicArray", "[ArraySerialization]")
+{
+  struct Point { int x, y; };
+
+  DynamicArray<Point> arr;
+
+  for (int i = 0; i < 100; ++i)
+    arr.push_back({ i, -i });
+
+  saveArray(path, arr);
+  ArrayFileView<Point> view = loadArray<Point>(path, ChecksumVerification::Skip);
+
+  REQUIRE(view.size() == arr.size());
+  CHECK(view.at(99).x == 99);
+  CHECK(view.at(99).y == -99);
+  REQUIRE_THROWS_AS(view.at(100), std::out_of_range);
+}
+
+TEST_CASE_METHOD(ArrayFileFixture, "loadArray() can load an empty array", "[ArraySerialization]")
+{
+  saveArray(path, DynamicArray<int>());
+
+  ArrayFileView<int> view = loadArray<int>(path);
+  CHECK(view.empty());
+}
+
+TEST_CASE_METHOD(ArrayFileFixture, "loadArray() throws when the element type does not match", "[ArraySerialization]")
+{
+  saveArray(path, FixedSizeArray<int>(10));
+
+  REQUIRE_THROWS_AS(loadArray<unsigned int>(path), ArrayFormatError);
+  REQUIRE_THROWS_AS(loadArray<float>(path), ArrayFormatError);
+  REQUIRE_THROWS_AS(loadArray<std::int64_t>(path), ArrayFormatError);
+}
+
+TEST_CASE_METHOD(ArrayFileFixture, "loadArray() throws when the file is not an array file", "[ArraySerialization]")
+{
+  SECTION("The file is too small") {
+    std::ofstream(path, std::ios::binary) << "ARRY";
+    REQUIRE_THROWS_AS(loadArray<int>(path), ArrayFormatError);
+  }
+
+  SECTION("The signature is wrong") {
+    saveArray(path, FixedSizeArray<int>(10));
+    corruptByte(0);
+    REQUIRE_THROWS_AS(loadArray<int>(path), ArrayFormatError);
+  }
+
+  SECTION("The byte order is different") {
+    saveArray(path, FixedSizeArray<int>(10));
+    corruptByte(offsetof(ArrayFileHeader, byteOrder));
+    REQUIRE_THROWS_AS(loadArray<int>(path), ArrayFormatError);
+  }
+
+  SECTION("The file was written on a machine with the opposite byte order") {
+    saveArray(path, FixedSizeArray<int>(10));
+    reverseBytes(offsetof(ArrayFileHeader, version), sizeof(ArrayFileHeader::version));
+    reverseBytes(offsetof(ArrayFileHeader, byteOrder), sizeof(ArrayFileHeader::byteOrder));
+
+    try {
+      loadArray<int>(path);
+      FAIL("loadArray() did not throw");
+    }
+    catch (const ArrayFormatError& e) {
+      CHECK(std::strstr(e.what(), "byte order") != nullptr);
+    }
+  }
+}
+
+TEST_CASE_METHOD(ArrayFileFixture, "loadArray() throws when the file is truncated", "[ArraySerialization]")
+{
+  saveArray(path, FixedSizeArray<int>(10));
+  std::filesystem::resize_file(path, sizeof(ArrayFileHeader) + 9 * sizeof(int));
+
+  REQUIRE_THROWS_AS(loadArray<int>(path, ChecksumVerification::Skip), ArrayFormatError);
+}
+
+TEST_CASE_METHOD(ArrayFileFixture, "loadArray() detects corrupted data only when verifying the checksum", "[ArraySerialization]")
+{
+  FixedSizeArray<int> arr(1000);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    arr[i] = static_cast<int>(i);
+
+  saveArray(path, arr);
+  corruptByte(sizeof(ArrayFileHeader) + 500 * sizeof(int));
+
+  REQUIRE_THROWS_AS(loadArray<int>(path), ArrayFormatError);
+  REQUIRE(loadArray<int>(path, ChecksumVerification::Skip)[500] != 500);
+}
+
+TEST_CASE("arrayChecksum() depends on every byte", "[ArraySerialization]")
+{
+  unsigned char bytes[13] = {};
+  std::uint64_t original = arrayChecksum(bytes, sizeof(bytes));
+
+  for (size_t i = 0; i < sizeof(bytes); ++i) {
+    bytes[i] = 1;
+    REQUIRE(arrayChecksum(bytes, sizeof(bytes)) != original);
+    bytes[i] = 0;
+  }
+}
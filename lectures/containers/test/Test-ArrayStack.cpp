@@ -0,0 +1,88 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/ArrayStack.h"
+
+#include <string>
+
+TEST_CASE("ArrayStack::ArrayStack() constructs an empty stack", "[ArrayStack]")
+{
+  ArrayStack<int> stack;
+  CHECK(stack.size() == 0);
+  CHECK(stack.empty());
+  CHECK(stack.capacity() == 0);
+}
+
+TEST_CASE("ArrayStack::top() and pop() throw when the stack is empty", "[ArrayStack]")
+{
+  ArrayStack<int> stack;
+  const ArrayStack<int>& cref = stack;
+
+  REQUIRE_THROWS_AS(stack.top(), ArrayStack<int>::EmptyStackException);
+  REQUIRE_THROWS_AS(cref.top(), ArrayStack<int>::EmptyStackException);
+  REQUIRE_THROWS_AS(stack.pop(), ArrayStack<int>::EmptyStackException);
+}
+
+TEST_CASE("ArrayStack returns the elements in reverse order", "[ArrayStack]")
+{
+  ArrayStack<size_t> stack;
+  const size_t count = 1000;
+
+  for (size_t i = 0; i < count; ++i) {
+    stack.push(i);
+    REQUIRE(stack.top() == i);
+  }
+
+  REQUIRE(stack.size() == count);
+
+  for (size_t i = count; i > 0; --i) {
+    REQUIRE(stack.top() == i - 1);
+    stack.pop();
+  }
+
+  REQUIRE(stack.empty());
+}
+
+TEST_CASE("ArrayStack::pop() does not release the buffer", "[ArrayStack]")
+{
+  ArrayStack<int> stack;
+  stack.reserve(100);
+
+  size_t capacity = stack.capacity();
+  REQUIRE(capacity >= 100);
+
+  for (int i = 0; i < 100; ++i)
+    stack.push(i);
+
+  while ( ! stack.empty())
+    stack.pop();
+
+  CHECK(stack.capacity() == capacity);
+}
+
+TEST_CASE("ArrayStack::push() can move elements", "[ArrayStack]")
+{
+  ArrayStack<std::string> stack;
+  std::string value(100, 'a');
+
+  stack.push(std::move(value));
+  stack.push("b");
+
+  CHECK(stack.top() == "b");
+  stack.pop();
+  CHECK(stack.top() == std::string(100, 'a'));
+}
+
+TEST_CASE("ArrayStack::swap() correctly swaps the contents of two stacks", "[ArrayStack]")
+{
+  ArrayStack<int> a, b;
+  a.push(1);
+  a.push(2);
+  b.push(3);
+
+  a.swap(b);
+
+  CHECK(a.size() == 1);
+  CHECK(a.top() == 3);
+  CHECK(b.size() == 2);
+  CHECK(b.top() == 2);
+}
@@ -0,0 +1,216 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/BitArray.h"
+
+#include <vector>
+
+/// A reference implementation, which the tests compare against
+std::vector<bool> randomBits(size_t size, unsigned seed)
+{
+  std::vector<bool> result(size);
+  unsigned state = seed;
+
+  for (size_t i = 0; i < size; ++i) {
+    state = state * 1103515245 + 12345;
+    result[i] = (state >> 16) % 3 == 0;
+  }
+
+  return result;
+}
+
+BitArray toBitArray(const std::vector<bool>& bits)
+{
+  BitArray result(bits.size());
+
+  for (size_t i = 0; i < bits.size(); ++i)
+    result[i] = bits[i];
+
+  return result;
+}
+
+TEST_CASE("BitArray::BitArray() constructs an empty array", "[BitArray]")
+{
+  BitArray arr;
+  CHECK(arr.size() == 0);
+  CHECK(arr.empty());
+  CHECK(arr.wordCount() == 0);
+  CHECK(arr.count() == 0);
+}
+
+TEST_CASE("BitArray::BitArray(size, value) packs the bits into words", "[BitArray]")
+{
+  BitArray zeros(130);
+  CHECK(zeros.size() == 130);
+  CHECK(zeros.wordCount() == 3);
+  CHECK(zeros.count() == 0);
+
+  BitArray ones(130, true);
+  CHECK(ones.count() == 130);
+  CHECK(ones[129]);
+
+  // The unused bits of the last word stay clear
+  CHECK(ones.data()[2] == 0x3);
+}
+
+TEST_CASE("BitArray::operator[] sets and clears single bits", "[BitArray]")
+{
+  BitArray arr(100);
+
+  arr[0] = true;
+  arr[63] = true;
+  arr[64] = true;
+  arr[99] = true;
+
+  CHECK(arr[0]);
+  CHECK_FALSE(arr[1]);
+  CHECK(arr[63]);
+  CHECK(arr[64]);
+  CHECK(arr[99]);
+  CHECK(arr.count() == 4);
+
+  arr[63] = false;
+  CHECK_FALSE(arr[63]);
+  CHECK(arr.count() == 3);
+
+  // Assigning one reference to another copies the bit
+  arr[10] = arr[0];
+  CHECK(arr[10]);
+}
+
+TEST_CASE("BitArray::at() checks the bounds", "[BitArray]")
+{
+  BitArray arr(10);
+  arr.at(9) = true;
+
+  const BitArray& constArr = arr;
+  CHECK(constArr.at(9));
+  CHECK_THROWS_AS(arr.at(10), std::out_of_range);
+  CHECK_THROWS_AS(constArr.at(10), std::out_of_range);
+}
+
+TEST_CASE("BitArray::fill() and flip() keep the unused bits clear", "[BitArray]")
+{
+  BitArray arr(70);
+
+  arr.fill(true);
+  CHECK(arr.count() == 70);
+
+  arr.flip();
+  CHECK(arr.count() == 0);
+
+  arr[5] = true;
+  arr.flip();
+  CHECK(arr.count() == 69);
+  CHECK_FALSE(arr[5]);
+}
+
+TEST_CASE("BitArray::rank() and select() agree with a reference implementation", "[BitArray]")
+{
+  std::vector<bool> expected = randomBits(1000, 7);
+  BitArray arr = toBitArray(expected);
+
+  size_t ones = 0;
+
+  for (size_t i = 0; i <= expected.size(); ++i) {
+    REQUIRE(arr.rank(i) == ones);
+
+    if (i < expected.size() && expected[i]) {
+      REQUIRE(arr.select(ones) == i);
+      ++ones;
+    }
+  }
+
+  CHECK(arr.count() == ones);
+  CHECK_THROWS_AS(arr.rank(1001), std::out_of_range);
+  CHECK_THROWS_AS(arr.select(ones), std::out_of_range);
+}
+
+TEST_CASE("BitArray bitwise operators combine whole arrays", "[BitArray]")
+{
+  std::vector<bool> a = randomBits(300, 1);
+  std::vector<bool> b = randomBits(300, 2);
+
+  BitArray andBits = toBitArray(a) & toBitArray(b);
+  BitArray orBits = toBitArray(a) | toBitArray(b);
+  BitArray xorBits = toBitArray(a) ^ toBitArray(b);
+
+  for (size_t i = 0; i < a.size(); ++i) {
+    REQUIRE(andBits[i] == (a[i] && b[i]));
+    REQUIRE(orBits[i] == (a[i] || b[i]));
+    REQUIRE(xorBits[i] == (a[i] != b[i]));
+  }
+
+  BitArray other(301);
+  BitArray arr(300);
+  CHECK_THROWS_AS(arr &= other, std::invalid_argument);
+  CHECK_THROWS_AS(arr |= other, std::invalid_argument);
+  CHECK_THROWS_AS(arr ^= other, std::invalid_argument);
+}
+
+TEST_CASE("BitArray::operator== compares sizes and bits", "[BitArray]")
+{
+  BitArray a(100);
+  BitArray b(100);
+  BitArray c(101);
+
+  CHECK(a == b);
+  CHECK(a != c);
+
+  b[50] = true;
+  CHECK(a != b);
+
+  a.swap(b);
+  CHECK(a[50]);
+  CHECK_FALSE(b[50]);
+}
+
+TEST_CASE("BitArray is empty after it has been moved from", "[BitArray]")
+{
+  BitArray source(100, true);
+
+  BitArray target(std::move(source));
+  CHECK(target.size() == 100);
+  CHECK(target.count() == 100);
+  CHECK(source.size() == 0);
+  CHECK(source.wordCount() == 0);
+  CHECK_THROWS_AS(source.at(0), std::out_of_range);
+
+  source = std::move(target);
+  CHECK(source.count() == 100);
+  CHECK(target.empty());
+  target.fill(true);
+  CHECK(target.count() == 0);
+}
+
+TEST_CASE("RankSelectIndex answers the same queries as BitArray", "[BitArray]")
+{
+  // Large enough to span several blocks, with an empty block in the middle
+  std::vector<bool> expected = randomBits(5000, 3);
+
+  for (size_t i = 1024; i < 2048; ++i)
+    expected[i] = false;
+
+  BitArray arr = toBitArray(expected);
+  RankSelectIndex index(arr);
+
+  for (size_t i = 0; i <= arr.size(); ++i)
+    REQUIRE(index.rank(i) == arr.rank(i));
+
+  size_t ones = arr.count();
+
+  for (size_t r = 0; r < ones; ++r)
+    REQUIRE(index.select(r) == arr.select(r));
+
+  CHECK_THROWS_AS(index.rank(5001), std::out_of_range);
+  CHECK_THROWS_AS(index.select(ones), std::out_of_range);
+}
+
+TEST_CASE("RankSelectIndex works on arrays whose size is a multiple of the block size", "[BitArray]")
+{
+  BitArray arr(1024, true);
+  RankSelectIndex index(arr);
+
+  CHECK(index.rank(1024) == 1024);
+  CHECK(index.select(1023) == 1023);
+  CHECK_THROWS_AS(index.select(1024), std::out_of_range);
+}
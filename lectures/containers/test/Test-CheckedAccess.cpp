@@ -0,0 +1,115 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/ArraySerialization.h"
+#include "containers/DynamicArray.h"
+#include "containers/FixedSizeArray.h"
+#include "containers/MappedArray.h"
+
+#if CONTAINERS_CHECKED_ACCESS && defined(__unix__)
+
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/// Runs action in a child process and checks whether it aborted the child
+template <typename Action>
+bool aborts(Action action)
+{
+  std::fflush(nullptr);
+  pid_t child = fork();
+
+  if (child == 0) {
+    // The message, which is printed before aborting, is expected,
+    // and the test framework must not report the abort as a crash
+    std::freopen("/dev/null", "w", stdout);
+    std::freopen("/dev/null", "w", stderr);
+    std::signal(SIGABRT, SIG_DFL);
+    action();
+    _exit(0);
+  }
+
+  int status = 0;
+  waitpid(child, &status, 0);
+  return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+
+TEST_CASE("FixedSizeArray::operator[] aborts for an index out of bounds, when CONTAINERS_CHECKED_ACCESS is enabled", "[FixedSizeArray][CheckedAccess]")
+{
+  FixedSizeArray<int> arr(10);
+  const FixedSizeArray<int>& cref = arr;
+
+  SECTION("Indices within the bounds are accepted") {
+    CHECK_FALSE(aborts([&arr]() { arr[0] = 1; arr[9] = 1; }));
+  }
+  SECTION("The index one past the end aborts") {
+    CHECK(aborts([&arr]() { arr[10] = 1; }));
+    CHECK(aborts([&cref]() { static_cast<void>(cref[10]); }));
+  }
+  SECTION("Indexing an empty array aborts") {
+    FixedSizeArray<int> empty;
+    CHECK(aborts([&empty]() { static_cast<void>(empty[0]); }));
+  }
+}
+
+TEST_CASE("DynamicArray::operator[] aborts for an index beyond its size, when CONTAINERS_CHECKED_ACCESS is enabled", "[DynamicArray][CheckedAccess]")
+{
+  DynamicArray<int> arr;
+  arr.reserve(16);
+  arr.push_back(1);
+  const DynamicArray<int>& cref = arr;
+
+  SECTION("Indices within the size are accepted") {
+    CHECK_FALSE(aborts([&arr]() { arr[0] = 2; }));
+  }
+  SECTION("Indices within the capacity, but beyond the size, abort") {
+    CHECK(aborts([&arr]() { arr[1] = 2; }));
+    CHECK(aborts([&cref]() { static_cast<void>(cref[15]); }));
+  }
+}
+
+TEST_CASE("MappedArray and ArrayFileView::operator[] abort for an index out of bounds, when CONTAINERS_CHECKED_ACCESS is enabled", "[MappedArray][CheckedAccess]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "Test-CheckedAccess.bin").string();
+
+  SECTION("MappedArray") {
+    MappedArray<int> arr(path, 4);
+
+    CHECK_FALSE(aborts([&arr]() { arr[3] = 1; }));
+    CHECK(aborts([&arr]() { arr[4] = 1; }));
+  }
+  SECTION("ArrayFileView") {
+    saveArray(path, FixedSizeArray<int>(4));
+    ArrayFileView<int> view = loadArray<int>(path);
+
+    CHECK_FALSE(aborts([&view]() { static_cast<void>(view[3]); }));
+    CHECK(aborts([&view]() { static_cast<void>(view[4]); }));
+  }
+
+  std::filesystem::remove(path);
+}
+
+#endif
+
+TEST_CASE("at() checks the index, regardless of CONTAINERS_CHECKED_ACCESS", "[FixedSizeArray][CheckedAccess]")
+{
+  FixedSizeArray<int> arr(10);
+
+  CHECK_NOTHROW(arr.at(9));
+  CHECK_THROWS_AS(arr.at(10), std::out_of_range);
+}
+
+TEST_CASE("DynamicArray::at() checks the index against the size, not the capacity", "[DynamicArray][CheckedAccess]")
+{
+  DynamicArray<int> arr;
+  arr.reserve(16);
+  arr.push_back(1);
+  const DynamicArray<int>& cref = arr;
+
+  CHECK(arr.at(0) == 1);
+  CHECK_THROWS_AS(arr.at(1), std::out_of_range);
+  CHECK_THROWS_AS(cref.at(15), std::out_of_range);
+}
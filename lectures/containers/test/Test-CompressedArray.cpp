@@ -0,0 +1,153 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/CompressedArray.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+template <typename T>
+void checkEqual(const CompressedArray<T>& arr, const std::vector<T>& expected)
+{
+  REQUIRE(arr.size() == expected.size());
+
+  for (size_t i = 0; i < expected.size(); ++i)
+    REQUIRE(arr[i] == expected[i]);
+
+  size_t index = 0;
+  arr.forEach([&](T value) { REQUIRE(value == expected[index++]); });
+  REQUIRE(index == expected.size());
+}
+
+template <typename T>
+CompressedArray<T> compress(const std::vector<T>& values)
+{
+  return CompressedArray<T>(values.data(), values.size());
+}
+
+TEST_CASE("CompressedArray::CompressedArray() constructs an empty array", "[CompressedArray]")
+{
+  CompressedArray<int> arr;
+
+  CHECK(arr.empty());
+  CHECK(arr.blockCount() == 0);
+  CHECK(arr.compressedBytes() == 0);
+  REQUIRE_THROWS_AS(arr.at(0), std::out_of_range);
+}
+
+TEST_CASE("CompressedArray keeps the incomplete last block uncompressed", "[CompressedArray]")
+{
+  std::vector<int> values;
+  CompressedArray<int> arr;
+
+  for (int i = 0; i < 300; ++i) {
+    arr.push_back(i * 3);
+    values.push_back(i * 3);
+  }
+
+  CHECK(arr.blockCount() == 2);
+  checkEqual(arr, values);
+  CHECK(arr.at(299) == 897);
+  REQUIRE_THROWS_AS(arr.at(300), std::out_of_range);
+}
+
+TEST_CASE("CompressedArray is empty after it has been moved from", "[CompressedArray]")
+{
+  std::vector<int> values;
+  CompressedArray<int> source;
+
+  for (int i = 0; i < 300; ++i) {
+    source.push_back(i);
+    values.push_back(i);
+  }
+
+  CompressedArray<int> target(std::move(source));
+  checkEqual(target, values);
+  CHECK(source.size() == 0);
+  CHECK(source.blockCount() == 0);
+  REQUIRE_THROWS_AS(source.at(0), std::out_of_range);
+
+  source = std::move(target);
+  checkEqual(source, values);
+  CHECK(target.empty());
+
+  target.push_back(7);
+  checkEqual(target, { 7 });
+}
+
+TEST_CASE("CompressedArray stores constant blocks in their headers only", "[CompressedArray]")
+{
+  std::vector<std::uint32_t> values(CompressedArray<std::uint32_t>::BlockSize * 10, 42);
+  CompressedArray<std::uint32_t> arr = compress(values);
+
+  checkEqual(arr, values);
+  CHECK(arr.compressedBytes() < values.size() * sizeof(std::uint32_t) / 10);
+}
+
+TEST_CASE("CompressedArray compresses sorted data with the delta scheme", "[CompressedArray]")
+{
+  std::mt19937 random(1);
+  std::vector<int> values;
+  int value = -1'000'000;
+
+  for (int i = 0; i < 100'000; ++i) {
+    value += int(random() % 16);
+    values.push_back(value);
+  }
+
+  CompressedArray<int> arr = compress(values);
+  checkEqual(arr, values);
+
+  // The differences of four consecutive steps fit into 6 bits
+  CHECK(arr.compressedBytes() * 4 < values.size() * sizeof(int));
+}
+
+TEST_CASE("CompressedArray round-trips every bit width", "[CompressedArray]")
+{
+  std::mt19937 random(2);
+
+  for (unsigned bits = 0; bits <= 32; ++bits) {
+    std::uint32_t mask = bits == 32 ? ~0u : (1u << bits) - 1;
+    std::vector<std::uint32_t> values(CompressedArray<std::uint32_t>::BlockSize * 3);
+
+    for (std::uint32_t& v : values)
+      v = random() & mask;
+
+    CompressedArray<std::uint32_t> arr = compress(values);
+    checkEqual(arr, values);
+
+    std::vector<std::uint32_t> decoded(CompressedArray<std::uint32_t>::BlockSize);
+    arr.decodeBlock(1, decoded.data());
+    REQUIRE(std::equal(decoded.begin(), decoded.end(), values.begin() + CompressedArray<std::uint32_t>::BlockSize));
+  }
+}
+
+TEST_CASE("CompressedArray handles the extremes of signed and unsigned values", "[CompressedArray]")
+{
+  std::vector<int> signedValues;
+  std::vector<std::uint32_t> unsignedValues;
+
+  for (int i = 0; i < 1000; ++i) {
+    signedValues.push_back(i % 2 ? std::numeric_limits<int>::max() - i : std::numeric_limits<int>::min() + i);
+    unsignedValues.push_back(i % 3 ? std::numeric_limits<std::uint32_t>::max() - i : std::uint32_t(i));
+  }
+
+  checkEqual(compress(signedValues), signedValues);
+  checkEqual(compress(unsignedValues), unsignedValues);
+}
+
+TEST_CASE("CompressedArray can be built from a DynamicArray", "[CompressedArray]")
+{
+  DynamicArray<int> source(500);
+
+  for (size_t i = 0; i < source.size(); ++i)
+    source[i] = int(i * i % 1000) - 500;
+
+  CompressedArray<int> arr(source);
+
+  REQUIRE(arr.size() == source.size());
+
+  for (size_t i = 0; i < source.size(); ++i)
+    REQUIRE(arr[i] == source[i]);
+}
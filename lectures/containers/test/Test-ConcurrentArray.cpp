@@ -0,0 +1,155 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/ConcurrentArray.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ConcurrentArray::ConcurrentArray() constructs an empty array", "[ConcurrentArray]")
+{
+  ConcurrentArray<int> arr;
+  CHECK(arr.size() == 0);
+  CHECK(arr.empty());
+  CHECK_FALSE(arr.isPublished(0));
+}
+
+TEST_CASE("ConcurrentArray::push_back() appends elements and returns their indices", "[ConcurrentArray]")
+{
+  ConcurrentArray<size_t> arr;
+
+  // Enough elements to span several segments
+  const size_t count = ConcurrentArray<size_t>::FirstSegmentSize * 20;
+
+  for (size_t i = 0; i < count; ++i)
+    REQUIRE(arr.push_back(i) == i);
+
+  REQUIRE(arr.size() == count);
+
+  for (size_t i = 0; i < count; ++i) {
+    REQUIRE(arr.isPublished(i));
+    REQUIRE(arr[i] == i);
+    REQUIRE(arr.at(i) == i);
+  }
+}
+
+TEST_CASE("ConcurrentArray::at() throws if the element has not been published", "[ConcurrentArray]")
+{
+  ConcurrentArray<int> arr;
+  arr.push_back(1);
+
+  const ConcurrentArray<int>& cref = arr;
+
+  REQUIRE_THROWS_AS(arr.at(1), std::out_of_range);
+  REQUIRE_THROWS_AS(cref.at(1), std::out_of_range);
+  REQUIRE_THROWS_AS(arr.at(1'000'000), std::out_of_range);
+}
+
+TEST_CASE("ConcurrentArray: growing does not move existing elements", "[ConcurrentArray]")
+{
+  ConcurrentArray<int> arr;
+  arr.push_back(42);
+  const int* first = &arr[0];
+
+  for (int i = 0; i < 10'000; ++i)
+    arr.push_back(i);
+
+  REQUIRE(&arr[0] == first);
+  REQUIRE(*first == 42);
+}
+
+TEST_CASE("ConcurrentArray::reserve() allocates the segments in advance", "[ConcurrentArray]")
+{
+  ConcurrentArray<int> arr;
+  arr.reserve(1000);
+
+  CHECK(arr.size() == 0);
+
+  for (int i = 0; i < 1000; ++i)
+    arr.push_back(i);
+
+  CHECK(arr.size() == 1000);
+  CHECK(arr[999] == 999);
+}
+
+TEST_CASE("ConcurrentArray destroys the elements it stores", "[ConcurrentArray]")
+{
+  ConcurrentArray<std::string> arr;
+
+  for (int i = 0; i < 500; ++i)
+    arr.push_back(std::string(100, 'a' + i % 26)); // long enough to allocate
+
+  CHECK(arr[25] == std::string(100, 'z'));
+}
+
+TEST_CASE("ConcurrentArray: concurrent push_back() stores every element exactly once", "[ConcurrentArray]")
+{
+  ConcurrentArray<size_t> arr;
+
+  const size_t threadsCount = 8;
+  const size_t perThread = 20'000;
+
+  std::vector<std::thread> producers;
+
+  for (size_t t = 0; t < threadsCount; ++t) {
+    producers.emplace_back([&arr, t]() {
+      for (size_t i = 0; i < perThread; ++i)
+        arr.push_back(t * perThread + i);
+    });
+  }
+
+  for (std::thread& producer : producers)
+    producer.join();
+
+  REQUIRE(arr.size() == threadsCount * perThread);
+
+  std::vector<bool> seen(threadsCount * perThread, false);
+
+  for (size_t i = 0; i < arr.size(); ++i) {
+    REQUIRE(arr.isPublished(i));
+    REQUIRE_FALSE(seen[arr[i]]);
+    seen[arr[i]] = true;
+  }
+}
+
+TEST_CASE("ConcurrentArray: readers can access published elements while producers append", "[ConcurrentArray]")
+{
+  ConcurrentArray<size_t> arr;
+
+  const size_t producersCount = 4;
+  const size_t perThread = 20'000;
+
+  std::atomic<bool> done{false};
+  std::atomic<size_t> errors{0};
+
+  // Each producer stores its own (non-zero) tag, so readers can validate what they see
+  std::vector<std::thread> producers;
+
+  for (size_t t = 0; t < producersCount; ++t) {
+    producers.emplace_back([&arr, t]() {
+      for (size_t i = 0; i < perThread; ++i)
+        arr.push_back(t + 1);
+    });
+  }
+
+  std::thread reader([&]() {
+    while ( ! done.load()) {
+      size_t size = arr.size();
+
+      for (size_t i = 0; i < size; ++i) {
+        if (arr.isPublished(i) && (arr.at(i) == 0 || arr.at(i) > producersCount))
+          ++errors;
+      }
+    }
+  });
+
+  for (std::thread& producer : producers)
+    producer.join();
+
+  done = true;
+  reader.join();
+
+  REQUIRE(errors == 0);
+  REQUIRE(arr.size() == producersCount * perThread);
+}
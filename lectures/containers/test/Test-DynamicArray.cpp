@@ -3,6 +3,8 @@
 #include "containers/DynamicArray.h"
 
 #include <cassert>
+#include <stdexcept>
+#include <type_traits>
 
 template <typename T>
 void checkEmpty(DynamicArray<T>& arr)
@@ -48,7 +50,7 @@ TEST_CASE_METHOD(NonEmptyArrayFixture, "DynamicArray::DynamicArray(N>0) construc
   checkNotEmpty(arr, initialSize);
 }
 
-TEST_CASE("DynamicArray::DynamicArray(N>0) throws when memory allocation fails", "[DynamicArray]")
+TEST_CASE("DynamicArray::DynamicArray(N>0) throws when memory allocation fails", "[DynamicArray][huge-allocation]")
 {
   const size_t sizeTooLargeForTheHeap = 100'000'000'000;
   REQUIRE_THROWS_AS(DynamicArray<int>(sizeTooLargeForTheHeap), std::bad_alloc);
@@ -246,7 +248,7 @@ TEST_CASE_METHOD(ConsecutiveNumbersFixture, "DynamicArray::reserve(N > 2*capacit
   REQUIRE(contentsRemainTheSame());
 }
 
-TEST_CASE_METHOD(ConsecutiveNumbersFixture, "DynamicArray::reserve() throws when the requested capacity is too large and the array remain unchanged (strong exception safety)")
+TEST_CASE_METHOD(ConsecutiveNumbersFixture, "DynamicArray::reserve() throws when the requested capacity is too large and the array remain unchanged (strong exception safety)", "[DynamicArray][huge-allocation]")
 {
   const size_t sizeTooLargeForTheHeap = 100'000'000'000;
   DynamicArray<int> arr;
@@ -257,6 +259,79 @@ TEST_CASE_METHOD(ConsecutiveNumbersFixture, "DynamicArray::reserve() throws when
   REQUIRE(contentsRemainTheSame());
 }
 
+/// An element, whose move constructor is not noexcept and whose copies can be made to fail
+struct FragileElement {
+  static inline int copiesLeft = -1;
+  int value = 0;
+
+  FragileElement() = default;
+
+  FragileElement(const FragileElement& other)
+    : value(other.value)
+  {
+    countCopy();
+  }
+
+  FragileElement(FragileElement&& other)
+    : value(other.value)
+  {
+    other.value = -1;
+  }
+
+  FragileElement& operator=(const FragileElement& other)
+  {
+    countCopy();
+    value = other.value;
+    return *this;
+  }
+
+  FragileElement& operator=(FragileElement&& other)
+  {
+    value = other.value;
+    other.value = -1;
+    return *this;
+  }
+
+  static void countCopy()
+  {
+    if (copiesLeft == 0)
+      throw std::runtime_error("copy failed");
+
+    if (copiesLeft > 0)
+      --copiesLeft;
+  }
+};
+
+TEST_CASE("DynamicArray::reserve() copies elements, whose move might throw, and stays unchanged when a copy fails", "[DynamicArray]")
+{
+  DynamicArray<FragileElement> arr;
+
+  for (int i = 0; i < 8; ++i) {
+    FragileElement element;
+    element.value = i;
+    arr.push_back(element);
+  }
+
+  const FragileElement* data = arr.data();
+  size_t capacity = arr.capacity();
+
+  FragileElement::copiesLeft = 3;
+  REQUIRE_THROWS_AS(arr.reserve(2 * capacity), std::runtime_error);
+  FragileElement::copiesLeft = -1;
+
+  CHECK(arr.data() == data);
+  CHECK(arr.capacity() == capacity);
+
+  for (int i = 0; i < 8; ++i)
+    REQUIRE(arr[i].value == i);
+}
+
+TEST_CASE("DynamicArray can be moved without throwing", "[DynamicArray]")
+{
+  STATIC_REQUIRE(std::is_nothrow_move_constructible_v<DynamicArray<int>>);
+  STATIC_REQUIRE(std::is_nothrow_move_assignable_v<DynamicArray<int>>);
+}
+
 TEST_CASE("DynamicArray::DynamicArray(const DynamicArray&) correctly copies an empty array", "[DynamicArray]")
 {
   DynamicArray<size_t> empty;
@@ -403,4 +478,31 @@ TEST_CASE_METHOD(ConsecutiveNumbersFixture, "DynamicArray::swap() correctly swap
     CHECK(arr.capacity() == capacityAnother);
     CHECK(another.capacity() == initialCapacity);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("DynamicArray::operator== compares the sizes and the elements, but not the capacities", "[DynamicArray]")
+{
+  DynamicArray<int> arr;
+  DynamicArray<int> other;
+
+  for (int i = 0; i < 10; ++i) {
+    arr.push_back(i);
+    other.push_back(i);
+  }
+
+  other.reserve(100);
+
+  SECTION("Arrays with the same elements are equal") {
+    CHECK(arr == other);
+    CHECK(DynamicArray<int>() == DynamicArray<int>());
+  }
+  SECTION("Arrays with different elements are not equal") {
+    other[5] = -1;
+    CHECK_FALSE(arr == other);
+  }
+  SECTION("A prefix of an array is not equal to it") {
+    other.pop_back();
+    CHECK_FALSE(arr == other);
+    CHECK_FALSE(other == arr);
+  }
+}
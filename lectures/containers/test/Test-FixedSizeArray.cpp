@@ -65,7 +65,7 @@ SCENARIO("FixedArraySize(size_t N > 0) correctly constructs an object with the s
   }
 }
 
-SCENARIO("FixedSizeArray(size_t N > 0) throws when passed a size that does not fit in memory", "[FixedSizeArray]")
+SCENARIO("FixedSizeArray(size_t N > 0) throws when passed a size that does not fit in memory", "[FixedSizeArray][huge-allocation]")
 {
   GIVEN("A size, which does not fit in the heap")
   {
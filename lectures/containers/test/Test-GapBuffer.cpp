@@ -0,0 +1,151 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/GapBuffer.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename T>
+void checkEqual(const GapBuffer<T>& buffer, const std::vector<T>& expected)
+{
+  REQUIRE(buffer.size() == expected.size());
+
+  for (size_t i = 0; i < expected.size(); ++i)
+    REQUIRE(buffer[i] == expected[i]);
+
+  size_t index = 0;
+  buffer.forEach([&](const T& value) { REQUIRE(value == expected[index++]); });
+}
+
+TEST_CASE("GapBuffer::GapBuffer() constructs an empty array", "[GapBuffer]")
+{
+  GapBuffer<int> buffer;
+
+  CHECK(buffer.empty());
+  CHECK(buffer.capacity() == 0);
+  CHECK(buffer.cursor() == 0);
+  REQUIRE_THROWS_AS(buffer.at(0), std::out_of_range);
+  REQUIRE_THROWS_AS(buffer.pop_back(), GapBuffer<int>::EmptyArrayException);
+  REQUIRE_THROWS_AS(buffer.eraseBefore(), GapBuffer<int>::EmptyArrayException);
+  REQUIRE_THROWS_AS(buffer.eraseAfter(), GapBuffer<int>::EmptyArrayException);
+  REQUIRE_THROWS_AS(buffer.moveCursor(1), std::out_of_range);
+}
+
+TEST_CASE("GapBuffer::insert() places the elements at the cursor", "[GapBuffer]")
+{
+  GapBuffer<char> buffer;
+
+  for (char c : std::string("helloworld"))
+    buffer.insert(c);
+
+  CHECK(buffer.cursor() == 10);
+
+  buffer.moveCursor(5);
+  buffer.insert(',');
+  buffer.insert(' ');
+
+  CHECK(buffer.cursor() == 7);
+  checkEqual(buffer, { 'h', 'e', 'l', 'l', 'o', ',', ' ', 'w', 'o', 'r', 'l', 'd' });
+
+  buffer.insert(0, '>');
+  CHECK(buffer.at(0) == '>');
+  CHECK(buffer.at(1) == 'h');
+  CHECK(buffer.cursor() == 1);
+}
+
+TEST_CASE("GapBuffer::eraseBefore() and eraseAfter() remove the elements next to the cursor", "[GapBuffer]")
+{
+  GapBuffer<std::string> buffer;
+
+  for (const char* word : { "a", "b", "c", "d" })
+    buffer.push_back(word);
+
+  buffer.moveCursor(2);
+  buffer.eraseBefore();
+  buffer.eraseAfter();
+
+  CHECK(buffer.cursor() == 1);
+  checkEqual(buffer, { "a", "d" });
+
+  buffer.erase(0);
+  checkEqual(buffer, { "d" });
+  REQUIRE_THROWS_AS(buffer.erase(1), std::out_of_range);
+
+  buffer.pop_back();
+  CHECK(buffer.empty());
+}
+
+TEST_CASE("GapBuffer keeps the elements in order when it grows", "[GapBuffer]")
+{
+  GapBuffer<int> buffer;
+  std::vector<int> expected;
+
+  for (int i = 0; i < 100; ++i) {
+    buffer.insert(buffer.size() / 2, i);
+    expected.insert(expected.begin() + expected.size() / 2, i);
+  }
+
+  checkEqual(buffer, expected);
+  CHECK(buffer.capacity() >= 100);
+
+  buffer.reserve(1000);
+  CHECK(buffer.capacity() == 1000);
+  checkEqual(buffer, expected);
+}
+
+TEST_CASE("GapBuffer can be used after it has been moved from", "[GapBuffer]")
+{
+  GapBuffer<char> source;
+
+  for (char c : std::string("abcdef"))
+    source.insert(c);
+
+  source.moveCursor(2);
+
+  GapBuffer<char> target(std::move(source));
+  checkEqual(target, { 'a', 'b', 'c', 'd', 'e', 'f' });
+  CHECK(target.cursor() == 2);
+  CHECK(source.size() == 0);
+  CHECK(source.capacity() == 0);
+  CHECK(source.cursor() == 0);
+
+  source.insert('x');
+  checkEqual(source, { 'x' });
+
+  target = std::move(source);
+  checkEqual(target, { 'x' });
+  CHECK(source.empty());
+
+  source.push_back('y');
+  checkEqual(source, { 'y' });
+}
+
+TEST_CASE("GapBuffer matches std::vector under random edits", "[GapBuffer]")
+{
+  std::mt19937 random(11);
+  GapBuffer<int> buffer;
+  std::vector<int> expected;
+
+  for (int step = 0; step < 20'000; ++step) {
+    unsigned operation = random() % 8;
+
+    if (operation < 4 || expected.empty()) {
+      size_t index = random() % (expected.size() + 1);
+      buffer.insert(index, step);
+      expected.insert(expected.begin() + index, step);
+    }
+    else if (operation < 6) {
+      size_t index = random() % expected.size();
+      buffer.erase(index);
+      expected.erase(expected.begin() + index);
+    }
+    else {
+      size_t index = random() % expected.size();
+      buffer.at(index) = -step;
+      expected[index] = -step;
+    }
+  }
+
+  checkEqual(buffer, expected);
+}
@@ -0,0 +1,338 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/HashMap.h"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using StringMap = HashMap<std::string, int, TransparentStringHash, std::equal_to<>>;
+
+/// Maps every key to the same hash, so all keys probe the same groups
+struct ConstantHash {
+  size_t operator()(int) const noexcept
+  {
+    return 42;
+  }
+};
+
+/// Its copy assignment throws while throwOnCopy is set
+struct ThrowingValue {
+  static inline bool throwOnCopy = false;
+  int value = 0;
+
+  ThrowingValue() = default;
+  ThrowingValue(int value) : value(value) {}
+  ThrowingValue(const ThrowingValue&) = default;
+  ThrowingValue(ThrowingValue&&) noexcept = default;
+  ThrowingValue& operator=(ThrowingValue&&) noexcept = default;
+
+  ThrowingValue& operator=(const ThrowingValue& other)
+  {
+    if (throwOnCopy)
+      throw std::runtime_error("copy failed");
+
+    value = other.value;
+    return *this;
+  }
+};
+
+TEST_CASE("HashMap::HashMap() constructs an empty map", "[HashMap]")
+{
+  HashMap<int, int> map;
+  CHECK(map.size() == 0);
+  CHECK(map.empty());
+  CHECK(map.capacity() == 0);
+  CHECK(map.find(1) == nullptr);
+  CHECK_FALSE(map.contains(1));
+  CHECK_FALSE(map.erase(1));
+}
+
+TEST_CASE("HashMap::insert() adds new keys and keeps existing values", "[HashMap]")
+{
+  HashMap<int, int> map;
+
+  CHECK(map.insert(1, 10));
+  CHECK(map.insert(2, 20));
+  CHECK_FALSE(map.insert(1, 100));
+
+  CHECK(map.size() == 2);
+  CHECK(map.at(1) == 10);
+  CHECK(map.at(2) == 20);
+}
+
+TEST_CASE("HashMap::insertOrAssign() replaces existing values", "[HashMap]")
+{
+  HashMap<int, int> map;
+
+  CHECK(map.insertOrAssign(1, 10));
+  CHECK_FALSE(map.insertOrAssign(1, 100));
+
+  CHECK(map.size() == 1);
+  CHECK(map.at(1) == 100);
+}
+
+TEST_CASE("HashMap::operator[] inserts default values", "[HashMap]")
+{
+  HashMap<std::string, int> map;
+
+  ++map["a"];
+  ++map["a"];
+  ++map["b"];
+
+  CHECK(map.size() == 2);
+  CHECK(map.at("a") == 2);
+  CHECK(map.at("b") == 1);
+}
+
+TEST_CASE("HashMap::at() throws for missing keys", "[HashMap]")
+{
+  HashMap<int, int> map;
+  map.insert(1, 10);
+
+  CHECK_THROWS_AS(map.at(2), std::out_of_range);
+
+  const HashMap<int, int>& constMap = map;
+  CHECK(constMap.at(1) == 10);
+  CHECK_THROWS_AS(constMap.at(2), std::out_of_range);
+}
+
+TEST_CASE("HashMap grows and keeps all entries", "[HashMap]")
+{
+  HashMap<int, int> map;
+  const int count = 100'000;
+
+  for (int i = 0; i < count; ++i)
+    REQUIRE(map.insert(i, i * 2));
+
+  REQUIRE(map.size() == count);
+  REQUIRE(map.size() <= map.maxEntries());
+  CHECK((map.capacity() & (map.capacity() - 1)) == 0);
+
+  for (int i = 0; i < count; ++i) {
+    const int* value = map.find(i);
+    REQUIRE(value);
+    REQUIRE(*value == i * 2);
+  }
+
+  for (int i = count; i < 2 * count; ++i)
+    REQUIRE_FALSE(map.contains(i));
+}
+
+TEST_CASE("HashMap::reserve() prevents rehashing", "[HashMap]")
+{
+  HashMap<int, int> map;
+  map.reserve(1000);
+
+  size_t capacity = map.capacity();
+  CHECK(map.maxEntries() >= 1000);
+
+  map.insert(0, 0);
+  const int* first = map.find(0);
+
+  for (int i = 1; i < 1000; ++i)
+    map.insert(i, i);
+
+  CHECK(map.capacity() == capacity);
+  // No rehash means the entries did not move
+  CHECK(map.find(0) == first);
+
+  // Reserving less than the current capacity does nothing
+  map.reserve(10);
+  CHECK(map.capacity() == capacity);
+}
+
+TEST_CASE("HashMap::erase() removes entries", "[HashMap]")
+{
+  HashMap<int, std::string> map;
+
+  for (int i = 0; i < 1000; ++i)
+    map.insert(i, std::to_string(i));
+
+  for (int i = 0; i < 1000; i += 2)
+    REQUIRE(map.erase(i));
+
+  CHECK_FALSE(map.erase(0));
+  CHECK(map.size() == 500);
+
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 2 == 0) {
+      REQUIRE_FALSE(map.contains(i));
+    }
+    else {
+      REQUIRE(map.contains(i));
+      REQUIRE(map.at(i) == std::to_string(i));
+    }
+  }
+
+  // The erased keys can be inserted again
+  for (int i = 0; i < 1000; i += 2)
+    REQUIRE(map.insert(i, "again"));
+
+  CHECK(map.size() == 1000);
+  CHECK(map.at(0) == "again");
+}
+
+TEST_CASE("HashMap reuses deleted slots instead of growing", "[HashMap]")
+{
+  HashMap<int, int> map;
+  map.reserve(100);
+  size_t capacity = map.capacity();
+
+  // A long series of inserts and erases, which keeps the map small
+  for (int i = 0; i < 100'000; ++i) {
+    map.insert(i, i);
+
+    if (i >= 50)
+      REQUIRE(map.erase(i - 50));
+  }
+
+  CHECK(map.size() == 50);
+  CHECK(map.capacity() == capacity);
+
+  for (int i = 100'000 - 50; i < 100'000; ++i)
+    REQUIRE(map.at(i) == i);
+}
+
+TEST_CASE("HashMap is unchanged if copying a new value throws", "[HashMap]")
+{
+  HashMap<int, ThrowingValue> map;
+
+  for (int i = 0; i < 10; ++i)
+    map.insert(i, ThrowingValue(i));
+
+  // Leave a deleted slot, which the failed inserts could reuse
+  REQUIRE(map.erase(5));
+
+  ThrowingValue::throwOnCopy = true;
+  CHECK_THROWS_AS(map.insert(100, ThrowingValue(100)), std::runtime_error);
+  CHECK_THROWS_AS(map.insertOrAssign(200, ThrowingValue(200)), std::runtime_error);
+  ThrowingValue::throwOnCopy = false;
+
+  CHECK(map.size() == 9);
+  CHECK_FALSE(map.contains(100));
+  CHECK_FALSE(map.contains(200));
+
+  for (int i = 0; i < 10; ++i) {
+    if (i != 5)
+      REQUIRE(map.at(i).value == i);
+  }
+
+  CHECK(map.insert(100, ThrowingValue(100)));
+  CHECK(map.size() == 10);
+  CHECK(map.at(100).value == 100);
+}
+
+TEST_CASE("HashMap handles keys with colliding hashes", "[HashMap]")
+{
+  HashMap<int, int, ConstantHash> map;
+
+  for (int i = 0; i < 100; ++i)
+    REQUIRE(map.insert(i, -i));
+
+  for (int i = 0; i < 100; i += 3)
+    REQUIRE(map.erase(i));
+
+  for (int i = 0; i < 100; ++i)
+    REQUIRE(map.contains(i) == (i % 3 != 0));
+
+  CHECK_FALSE(map.contains(100));
+}
+
+TEST_CASE("HashMap supports heterogeneous lookup", "[HashMap]")
+{
+  StringMap map;
+  map.insert("plus", 1);
+  map.insert("minus", 2);
+
+  std::string_view key = "minus";
+  CHECK(map.contains(key));
+  CHECK(map.at(key) == 2);
+  CHECK(*map.find("plus") == 1);
+  CHECK(map.find(std::string_view("times")) == nullptr);
+
+  CHECK(map.erase(std::string_view("plus")));
+  CHECK(map.size() == 1);
+}
+
+TEST_CASE("HashMap::forEach() visits every entry once", "[HashMap]")
+{
+  HashMap<int, int> map;
+  std::unordered_map<int, int> expected;
+
+  for (int i = 0; i < 500; ++i) {
+    map.insert(i * 7, i);
+    expected[i * 7] = i;
+  }
+
+  std::unordered_map<int, int> visited;
+  map.forEach([&](int key, int value) {
+    CHECK(visited.count(key) == 0);
+    visited[key] = value;
+  });
+
+  CHECK(visited == expected);
+}
+
+TEST_CASE("HashMap::clear() removes all entries", "[HashMap]")
+{
+  HashMap<int, int> map;
+
+  for (int i = 0; i < 100; ++i)
+    map.insert(i, i);
+
+  size_t capacity = map.capacity();
+  map.clear();
+
+  CHECK(map.empty());
+  CHECK(map.capacity() == capacity);
+  CHECK_FALSE(map.contains(1));
+
+  map.insert(1, 1);
+  CHECK(map.at(1) == 1);
+}
+
+TEST_CASE("HashMap::swap() exchanges the contents", "[HashMap]")
+{
+  HashMap<int, int> a;
+  HashMap<int, int> b;
+  a.insert(1, 10);
+  b.insert(2, 20);
+  b.insert(3, 30);
+
+  a.swap(b);
+
+  CHECK(a.size() == 2);
+  CHECK(a.at(2) == 20);
+  CHECK(b.size() == 1);
+  CHECK(b.at(1) == 10);
+}
+
+TEST_CASE("HashMap can be used after it has been moved from", "[HashMap]")
+{
+  HashMap<int, int> source;
+
+  for (int i = 0; i < 10; ++i)
+    source.insert(i, i * 10);
+
+  source.erase(0);
+
+  HashMap<int, int> target(std::move(source));
+  CHECK(target.size() == 9);
+  CHECK(target.at(9) == 90);
+  CHECK(source.size() == 0);
+  CHECK(source.capacity() == 0);
+  CHECK_FALSE(source.contains(9));
+
+  CHECK(source.insert(42, 420));
+  CHECK(source.at(42) == 420);
+
+  target = std::move(source);
+  CHECK(target.size() == 1);
+  CHECK(target.at(42) == 420);
+  CHECK(source.empty());
+
+  CHECK(source.insert(7, 70));
+  CHECK(source.size() == 1);
+}
@@ -0,0 +1,151 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/MappedArray.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/// A file in the temporary directory, which is removed at the end of the test
+class TemporaryFileFixture {
+protected:
+  const std::string path = (std::filesystem::temp_directory_path() / "Test-MappedArray.bin").string();
+
+public:
+  TemporaryFileFixture()
+  {
+    std::filesystem::remove(path);
+  }
+
+  ~TemporaryFileFixture()
+  {
+    std::filesystem::remove(path);
+  }
+};
+
+TEST_CASE("MappedArray::MappedArray() constructs an empty array", "[MappedArray]")
+{
+  MappedArray<int> arr;
+  CHECK(arr.size() == 0);
+  CHECK(arr.empty());
+  CHECK(arr.data() == nullptr);
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray::MappedArray(path, N) creates a zero-filled file with N elements", "[MappedArray]")
+{
+  MappedArray<std::uint32_t> arr(path, 1000);
+
+  REQUIRE(arr.size() == 1000);
+  REQUIRE(arr.mode() == MappingMode::ReadWrite);
+  CHECK(std::filesystem::file_size(path) == 1000 * sizeof(std::uint32_t));
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    REQUIRE(arr[i] == 0);
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray persists its contents in the file", "[MappedArray]")
+{
+  {
+    MappedArray<std::uint64_t> arr(path, 10'000);
+
+    for (size_t i = 0; i < arr.size(); ++i)
+      arr[i] = i * i;
+
+    arr.flush();
+  }
+
+  MappedArray<std::uint64_t> arr(path, MappingMode::ReadOnly);
+  const MappedArray<std::uint64_t>& cref = arr;
+
+  REQUIRE(arr.size() == 10'000);
+  REQUIRE(arr.mode() == MappingMode::ReadOnly);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    REQUIRE(cref.at(i) == i * i);
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray::MappedArray(path, N) keeps the existing elements when resizing a file", "[MappedArray]")
+{
+  {
+    MappedArray<int> arr(path, 4);
+
+    for (int i = 0; i < 4; ++i)
+      arr[i] = i + 1;
+  }
+
+  MappedArray<int> arr(path, 6);
+
+  REQUIRE(arr.size() == 6);
+  CHECK(arr[0] == 1);
+  CHECK(arr[3] == 4);
+  CHECK(arr[4] == 0);
+  CHECK(arr[5] == 0);
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray ignores trailing bytes that do not form a whole element", "[MappedArray]")
+{
+  std::ofstream(path, std::ios::binary) << "abcdefghij"; // 10 bytes
+
+  MappedArray<std::uint32_t> arr(path);
+  CHECK(arr.size() == 2);
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray can map an empty file", "[MappedArray]")
+{
+  std::ofstream(path, std::ios::binary).close();
+
+  MappedArray<int> arr(path);
+  CHECK(arr.empty());
+  CHECK(arr.data() == nullptr);
+
+  arr.advise(AccessPattern::Sequential);
+  arr.flush();
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray::at() throws if the index is not valid", "[MappedArray]")
+{
+  MappedArray<int> arr(path, 10);
+  const MappedArray<int>& cref = arr;
+
+  REQUIRE_THROWS_AS(arr.at(10), std::out_of_range);
+  REQUIRE_THROWS_AS(cref.at(10), std::out_of_range);
+}
+
+TEST_CASE("MappedArray::MappedArray(path) throws when the file does not exist", "[MappedArray]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "Test-MappedArray-missing.bin").string();
+  std::filesystem::remove(path);
+
+  REQUIRE_THROWS_AS(MappedArray<int>(path), std::system_error);
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray::MappedArray(MappedArray&&) transfers the mapping", "[MappedArray]")
+{
+  MappedArray<int> source(path, 10);
+  source[9] = 42;
+  const int* data = source.data();
+
+  MappedArray<int> target(std::move(source));
+
+  CHECK(source.empty());
+  CHECK(source.data() == nullptr);
+  CHECK(target.size() == 10);
+  CHECK(target.data() == data);
+  CHECK(target[9] == 42);
+
+  source = std::move(target);
+  CHECK(source[9] == 42);
+  CHECK(target.empty());
+}
+
+TEST_CASE_METHOD(TemporaryFileFixture, "MappedArray::advise() accepts all access patterns", "[MappedArray]")
+{
+  MappedArray<int> arr(path, 100'000);
+
+  for (AccessPattern pattern : { AccessPattern::Normal, AccessPattern::Sequential, AccessPattern::Random, AccessPattern::WillNeed }) {
+    arr.advise(pattern);
+    arr[99'999] = 1;
+    CHECK(arr[99'999] == 1);
+  }
+}
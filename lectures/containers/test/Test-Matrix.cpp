@@ -0,0 +1,184 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/Matrix.h"
+
+#include <vector>
+
+TEMPLATE_TEST_CASE("Matrix::Matrix() constructs an empty matrix", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  Matrix<int, TestType> m;
+  CHECK(m.rows() == 0);
+  CHECK(m.cols() == 0);
+  CHECK(m.empty());
+  CHECK(m.data() == nullptr);
+}
+
+TEMPLATE_TEST_CASE("Matrix stores every element at a distinct position", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  // Dimensions, which are not multiples of the tile size
+  const size_t rows = 13;
+  const size_t cols = 7;
+
+  Matrix<int, TestType> m(rows, cols);
+  REQUIRE(m.rows() == rows);
+  REQUIRE(m.cols() == cols);
+
+  for (size_t row = 0; row < rows; ++row)
+    for (size_t col = 0; col < cols; ++col)
+      m(row, col) = static_cast<int>(row * 100 + col);
+
+  for (size_t row = 0; row < rows; ++row)
+    for (size_t col = 0; col < cols; ++col)
+      REQUIRE(m.at(row, col) == static_cast<int>(row * 100 + col));
+}
+
+TEST_CASE("Matrix layouts place the elements in the expected order", "[Matrix]")
+{
+  Matrix<int, RowMajorLayout> rowMajor(2, 3);
+  Matrix<int, ColumnMajorLayout> columnMajor(2, 3);
+
+  rowMajor(1, 0) = 42;
+  columnMajor(1, 0) = 42;
+
+  CHECK(rowMajor.data()[3] == 42);
+  CHECK(columnMajor.data()[1] == 42);
+
+  // The element (1, 0) is the first one of the second row of the first tile
+  Matrix<int, TiledLayout<4>> tiled(8, 8);
+  tiled(1, 0) = 42;
+  tiled(0, 4) = 43;
+
+  CHECK(tiled.data()[4] == 42);
+  CHECK(tiled.data()[16] == 43);
+}
+
+TEMPLATE_TEST_CASE("Matrix::forEach() visits the elements in the order in which they are stored", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  Matrix<int, TestType> m(10, 6);
+  int next = 0;
+
+  m.forEach([&next](size_t, size_t, int& value) { value = next++; });
+
+  REQUIRE(next == 60);
+
+  // Unless the storage is padded, the elements are numbered in memory order
+  std::vector<bool> seen(60, false);
+
+  m.forEach([&seen](size_t, size_t, const int& value) {
+    REQUIRE_FALSE(seen[value]);
+    seen[value] = true;
+  });
+
+  if (TestType::storageSize(10, 6) == 60) {
+    for (int i = 0; i < 60; ++i)
+      REQUIRE(m.data()[i] == i);
+  }
+}
+
+TEMPLATE_TEST_CASE("Matrix::fill() sets all elements", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  Matrix<int, TestType> m(5, 9);
+  m.fill(7);
+
+  for (size_t row = 0; row < 5; ++row)
+    for (size_t col = 0; col < 9; ++col)
+      REQUIRE(m(row, col) == 7);
+}
+
+TEMPLATE_TEST_CASE("Matrix::at() throws if the coordinates are not valid", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  Matrix<int, TestType> m(3, 4);
+  const Matrix<int, TestType>& cref = m;
+
+  REQUIRE_THROWS_AS(m.at(3, 0), std::out_of_range);
+  REQUIRE_THROWS_AS(m.at(0, 4), std::out_of_range);
+  REQUIRE_THROWS_AS(cref.at(3, 0), std::out_of_range);
+  REQUIRE_THROWS_AS(m.row(3), std::out_of_range);
+  REQUIRE_THROWS_AS(cref.column(4), std::out_of_range);
+}
+
+TEMPLATE_TEST_CASE("Matrix::row() and column() give access to a single line", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  Matrix<int, TestType> m(3, 4);
+  m.fill(0);
+
+  auto row = m.row(1);
+  REQUIRE(row.size() == 4);
+
+  for (size_t i = 0; i < row.size(); ++i)
+    row[i] = 1;
+
+  auto column = m.column(2);
+  REQUIRE(column.size() == 3);
+  column[0] = 2;
+
+  const Matrix<int, TestType>& cref = m;
+  CHECK(cref.row(1)[3] == 1);
+  CHECK(cref.column(2)[1] == 1);
+  CHECK(cref.row(0)[2] == 2);
+  CHECK(cref.row(0)[0] == 0);
+  REQUIRE_THROWS_AS(cref.row(0).at(4), std::out_of_range);
+}
+
+TEMPLATE_TEST_CASE("Matrix::transposed() swaps the rows and columns", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  // Large enough to be split into blocks several times
+  const size_t rows = 67;
+  const size_t cols = 129;
+
+  Matrix<int, TestType> m(rows, cols);
+  m.forEach([](size_t row, size_t col, int& value) { value = static_cast<int>(row * 1000 + col); });
+
+  Matrix<int, TestType> t = m.transposed();
+
+  REQUIRE(t.rows() == cols);
+  REQUIRE(t.cols() == rows);
+
+  for (size_t row = 0; row < rows; ++row)
+    for (size_t col = 0; col < cols; ++col)
+      REQUIRE(t(col, row) == m(row, col));
+
+  CHECK(t.transposed() == m);
+}
+
+TEST_CASE("Matrix::operator== compares the dimensions and the elements", "[Matrix]")
+{
+  Matrix<int> a(2, 3), b(2, 3), c(3, 2);
+  a.fill(1);
+  b.fill(1);
+  c.fill(1);
+
+  CHECK(a == b);
+  CHECK_FALSE(a == c);
+
+  b(1, 2) = 2;
+  CHECK_FALSE(a == b);
+}
+
+TEMPLATE_TEST_CASE("Matrix layouts pass the index of each element to the traversal", "[Matrix]", RowMajorLayout, ColumnMajorLayout, TiledLayout<4>)
+{
+  const size_t rows = 11;
+  const size_t cols = 6;
+
+  TestType::traverse(rows, cols, [](size_t row, size_t col, size_t index) {
+    REQUIRE(index == TestType::index(row, col, rows, cols));
+  });
+}
+
+TEST_CASE("Matrix is empty after it has been moved from", "[Matrix]")
+{
+  Matrix<int> source(10, 10);
+  source(9, 9) = 99;
+
+  Matrix<int> target(std::move(source));
+  CHECK(target.rows() == 10);
+  CHECK(target(9, 9) == 99);
+  CHECK(source.rows() == 0);
+  CHECK(source.cols() == 0);
+  REQUIRE_THROWS_AS(source.at(0, 0), std::out_of_range);
+
+  source = std::move(target);
+  CHECK(source(9, 9) == 99);
+  CHECK(target.rows() == 0);
+  CHECK(target.cols() == 0);
+}
@@ -0,0 +1,128 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/MpmcQueue.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("MpmcQueue::MpmcQueue() rounds the capacity up to a power of two", "[MpmcQueue]")
+{
+  CHECK(MpmcQueue<int>(1).capacity() == 2);
+  CHECK(MpmcQueue<int>(5).capacity() == 8);
+  CHECK(MpmcQueue<int>(64).capacity() == 64);
+}
+
+TEST_CASE("MpmcQueue::tryPop() fails when the queue is empty", "[MpmcQueue]")
+{
+  MpmcQueue<int> queue(4);
+  int value = -1;
+
+  REQUIRE_FALSE(queue.tryPop(value));
+  CHECK(value == -1);
+}
+
+TEST_CASE("MpmcQueue::tryPush() fails when the queue is full", "[MpmcQueue]")
+{
+  MpmcQueue<int> queue(4);
+
+  for (int i = 0; i < 4; ++i)
+    REQUIRE(queue.tryPush(i));
+
+  REQUIRE_FALSE(queue.tryPush(4));
+
+  int value;
+  REQUIRE(queue.tryPop(value));
+  CHECK(value == 0);
+  REQUIRE(queue.tryPush(4));
+}
+
+TEST_CASE("MpmcQueue returns the elements in the order they were added", "[MpmcQueue]")
+{
+  MpmcQueue<std::string> queue(8);
+
+  // Several rounds, so that the positions wrap around the ring
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 5; ++i)
+      REQUIRE(queue.tryPush(std::to_string(round * 5 + i)));
+
+    for (int i = 0; i < 5; ++i) {
+      std::string value;
+      REQUIRE(queue.tryPop(value));
+      REQUIRE(value == std::to_string(round * 5 + i));
+    }
+  }
+}
+
+TEST_CASE("MpmcQueue delivers every element exactly once to many consumers", "[MpmcQueue]")
+{
+  MpmcQueue<size_t> queue(64);
+
+  const size_t producersCount = 4;
+  const size_t consumersCount = 4;
+  const size_t perProducer = 50'000;
+  const size_t total = producersCount * perProducer;
+
+  std::vector<std::atomic<int>> received(total);
+  std::atomic<size_t> consumed{0};
+
+  std::vector<std::thread> threads;
+
+  for (size_t p = 0; p < producersCount; ++p) {
+    threads.emplace_back([&queue, p]() {
+      for (size_t i = 0; i < perProducer; ++i)
+        queue.push(p * perProducer + i);
+    });
+  }
+
+  for (size_t c = 0; c < consumersCount; ++c) {
+    threads.emplace_back([&]() {
+      size_t value;
+
+      while (consumed.load() < total) {
+        if (queue.tryPop(value)) {
+          ++received[value];
+          ++consumed;
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  size_t wrong = 0;
+
+  for (std::atomic<int>& count : received) {
+    if (count != 1)
+      ++wrong;
+  }
+
+  REQUIRE(wrong == 0);
+}
+
+TEST_CASE("MpmcQueue keeps the order of the elements from a single producer", "[MpmcQueue]")
+{
+  MpmcQueue<size_t> queue(16);
+  const size_t count = 100'000;
+
+  std::thread producer([&queue]() {
+    for (size_t i = 0; i < count; ++i)
+      queue.push(i);
+  });
+
+  size_t outOfOrder = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (queue.pop() != i)
+      ++outOfOrder;
+  }
+
+  producer.join();
+
+  REQUIRE(outOfOrder == 0);
+}
@@ -0,0 +1,139 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/PackedIntArray.h"
+
+TEST_CASE("PackedIntArray::PackedIntArray() constructs an empty array", "[PackedIntArray]")
+{
+  PackedIntArray<4> arr;
+  CHECK(arr.size() == 0);
+  CHECK(arr.empty());
+  CHECK(arr.wordCount() == 0);
+}
+
+TEST_CASE("PackedIntArray uses the smallest fitting value type", "[PackedIntArray]")
+{
+  STATIC_REQUIRE(std::is_same_v<PackedIntArray<1>::Value, std::uint8_t>);
+  STATIC_REQUIRE(std::is_same_v<PackedIntArray<12>::Value, std::uint16_t>);
+  STATIC_REQUIRE(std::is_same_v<PackedIntArray<20>::Value, std::uint32_t>);
+  STATIC_REQUIRE(PackedIntArray<5>::MaxValue == 31);
+  STATIC_REQUIRE(PackedIntArray<32>::MaxValue == 0xFFFFFFFFu);
+}
+
+TEST_CASE("PackedIntArray::PackedIntArray(size) packs the values tightly", "[PackedIntArray]")
+{
+  PackedIntArray<4> arr(1000);
+  CHECK(arr.size() == 1000);
+
+  // 4000 bits fit in 63 words, plus one word of padding
+  CHECK(arr.wordCount() == 64);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    REQUIRE(arr[i] == 0);
+}
+
+TEMPLATE_TEST_CASE_SIG("PackedIntArray stores values, which cross word boundaries", "[PackedIntArray]",
+  ((unsigned Bits), Bits), 1, 3, 7, 13, 31, 32)
+{
+  using Array = PackedIntArray<Bits>;
+  using Value = typename Array::Value;
+
+  const size_t size = 1000;
+  Array arr(size);
+
+  for (size_t i = 0; i < size; ++i)
+    arr[i] = static_cast<Value>((i * 2654435761u) & Array::MaxValue);
+
+  for (size_t i = 0; i < size; ++i)
+    REQUIRE(arr[i] == static_cast<Value>((i * 2654435761u) & Array::MaxValue));
+
+  // Overwriting a value does not disturb its neighbours
+  for (size_t i = 0; i < size; i += 2)
+    arr.set(i, Array::MaxValue);
+
+  for (size_t i = 0; i < size; ++i) {
+    Value expected = i % 2 ? static_cast<Value>((i * 2654435761u) & Array::MaxValue) : Array::MaxValue;
+    REQUIRE(arr.get(i) == expected);
+  }
+}
+
+TEST_CASE("PackedIntArray truncates values to Bits bits", "[PackedIntArray]")
+{
+  PackedIntArray<3> arr(3);
+  arr[1] = 0xFF;
+
+  CHECK(arr[0] == 0);
+  CHECK(arr[1] == 7);
+  CHECK(arr[2] == 0);
+}
+
+TEST_CASE("PackedIntArray::at() checks the bounds", "[PackedIntArray]")
+{
+  PackedIntArray<6> arr(10);
+  arr.at(9) = 42;
+
+  const PackedIntArray<6>& constArr = arr;
+  CHECK(constArr.at(9) == 42);
+  CHECK_THROWS_AS(arr.at(10), std::out_of_range);
+  CHECK_THROWS_AS(constArr.at(10), std::out_of_range);
+}
+
+TEST_CASE("PackedIntArray::fill(), swap() and operator==", "[PackedIntArray]")
+{
+  PackedIntArray<5> a(100);
+  PackedIntArray<5> b(100);
+  CHECK(a == b);
+
+  a.fill(17);
+
+  for (size_t i = 0; i < a.size(); ++i)
+    REQUIRE(a[i] == 17);
+
+  CHECK(a != b);
+
+  a.swap(b);
+  CHECK(b[99] == 17);
+  CHECK(a[99] == 0);
+
+  // Assigning one reference to another copies the value
+  a[0] = b[0];
+  CHECK(a[0] == 17);
+}
+
+TEST_CASE("PackedIntArray is empty after it has been moved from", "[PackedIntArray]")
+{
+  PackedIntArray<5> source(100);
+  source[99] = 17;
+
+  PackedIntArray<5> target(std::move(source));
+  CHECK(target.size() == 100);
+  CHECK(target[99] == 17);
+  CHECK(source.size() == 0);
+  CHECK(source.wordCount() == 0);
+  CHECK_THROWS_AS(source.at(0), std::out_of_range);
+
+  source = std::move(target);
+  CHECK(source[99] == 17);
+  CHECK(target.empty());
+  target.fill(3);
+}
+
+TEMPLATE_TEST_CASE_SIG("PackedIntArray::forEach() visits the values in order", "[PackedIntArray]",
+  ((unsigned Bits), Bits), 4, 7, 16)
+{
+  using Array = PackedIntArray<Bits>;
+  using Value = typename Array::Value;
+
+  // Not a multiple of the number of values per word
+  Array arr(1001);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    arr[i] = static_cast<Value>((i * 37) & Array::MaxValue);
+
+  size_t index = 0;
+  arr.forEach([&](Value value) {
+    REQUIRE(value == static_cast<Value>((index * 37) & Array::MaxValue));
+    ++index;
+  });
+
+  CHECK(index == arr.size());
+}
@@ -0,0 +1,244 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/PersistentVector.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename T>
+void checkEqual(const PersistentVector<T>& vector, const std::vector<T>& expected)
+{
+  REQUIRE(vector.size() == expected.size());
+
+  for (size_t i = 0; i < expected.size(); ++i)
+    REQUIRE(vector[i] == expected[i]);
+
+  size_t index = 0;
+  vector.forEach([&](const T& value) { REQUIRE(value == expected[index++]); });
+  REQUIRE(index == expected.size());
+}
+
+TEST_CASE("PersistentVector::PersistentVector() constructs an empty vector", "[PersistentVector]")
+{
+  PersistentVector<int> vector;
+
+  CHECK(vector.empty());
+  CHECK(vector.size() == 0);
+  REQUIRE_THROWS_AS(vector.at(0), std::out_of_range);
+  REQUIRE_THROWS_AS(vector.pop_back(), PersistentVector<int>::EmptyVectorException);
+  REQUIRE_THROWS_AS(vector.set(0, 1), std::out_of_range);
+}
+
+TEST_CASE("PersistentVector::push_back() returns a new version and leaves the original unchanged", "[PersistentVector]")
+{
+  PersistentVector<int> empty;
+  PersistentVector<int> one = empty.push_back(1);
+  PersistentVector<int> two = one.push_back(2);
+
+  CHECK(empty.size() == 0);
+  checkEqual(one, { 1 });
+  checkEqual(two, { 1, 2 });
+}
+
+TEST_CASE("PersistentVector grows and shrinks across the levels of the tree", "[PersistentVector]")
+{
+  // 32 fit into the tail, 32 * 32 + 32 into two levels, 32^3 + 32 into three
+  const int Size = 32 * 32 * 32 + 100;
+
+  PersistentVector<int> vector;
+  std::vector<int> expected;
+
+  for (int i = 0; i < Size; ++i) {
+    vector = vector.push_back(i);
+    expected.push_back(i);
+  }
+
+  checkEqual(vector, expected);
+  CHECK(vector.at(Size - 1) == Size - 1);
+  REQUIRE_THROWS_AS(vector.at(Size), std::out_of_range);
+
+  while ( ! expected.empty()) {
+    vector = vector.pop_back();
+    expected.pop_back();
+
+    REQUIRE(vector.size() == expected.size());
+
+    if ( ! expected.empty()) {
+      REQUIRE(vector[expected.size() - 1] == expected.back());
+      REQUIRE(vector[expected.size() / 2] == expected[expected.size() / 2]);
+    }
+  }
+
+  CHECK(vector.empty());
+}
+
+TEST_CASE("PersistentVector::set() changes only the new version", "[PersistentVector]")
+{
+  const int Size = 2000;
+
+  PersistentVector<int>::Transient builder;
+
+  for (int i = 0; i < Size; ++i)
+    builder.push_back(i);
+
+  PersistentVector<int> original = builder.persistent();
+  std::vector<int> expected(Size);
+
+  for (int i = 0; i < Size; ++i)
+    expected[i] = i;
+
+  // Set an element in the tree and one in the tail
+  PersistentVector<int> inTree = original.set(5, -5);
+  PersistentVector<int> inTail = inTree.set(Size - 1, -1);
+
+  checkEqual(original, expected);
+
+  expected[5] = -5;
+  checkEqual(inTree, expected);
+
+  expected[Size - 1] = -1;
+  checkEqual(inTail, expected);
+
+  REQUIRE_THROWS_AS(original.set(Size, 0), std::out_of_range);
+}
+
+TEST_CASE("PersistentVector keeps all versions intact under random operations", "[PersistentVector]")
+{
+  std::mt19937 random(42);
+  std::vector<PersistentVector<int>> versions(1);
+  std::vector<std::vector<int>> models(1);
+
+  for (int step = 0; step < 5000; ++step) {
+    size_t base = random() % versions.size();
+    PersistentVector<int> version = versions[base];
+    std::vector<int> model = models[base];
+    unsigned operation = random() % 10;
+
+    if (operation < 6 || model.empty()) {
+      version = version.push_back(step);
+      model.push_back(step);
+    }
+    else if (operation < 9) {
+      size_t index = random() % model.size();
+      version = version.set(index, -step);
+      model[index] = -step;
+    }
+    else {
+      version = version.pop_back();
+      model.pop_back();
+    }
+
+    // Prefer extending the newest versions, so that some of them grow large
+    if (random() % 4 != 0) {
+      versions.back() = version;
+      models.back() = model;
+    }
+    else {
+      versions.push_back(version);
+      models.push_back(model);
+    }
+  }
+
+  for (size_t i = 0; i < versions.size(); ++i)
+    checkEqual(versions[i], models[i]);
+}
+
+TEST_CASE("PersistentVector::Transient modifies the vector in place", "[PersistentVector]")
+{
+  PersistentVector<int> original;
+
+  for (int i = 0; i < 100; ++i)
+    original = original.push_back(i);
+
+  PersistentVector<int>::Transient transient = original.transient();
+
+  for (int i = 100; i < 5000; ++i)
+    transient.push_back(i);
+
+  transient.set(0, -1);
+  transient.set(4000, -4000);
+  transient.pop_back();
+
+  CHECK(transient.size() == 4999);
+  CHECK(transient[0] == -1);
+  CHECK(transient.at(4000) == -4000);
+
+  PersistentVector<int> built = transient.persistent();
+
+  // Modifying the transient after persistent() does not affect the returned version
+  transient.set(1, -2);
+  transient.push_back(5000);
+
+  CHECK(original.size() == 100);
+  CHECK(original[0] == 0);
+  CHECK(built.size() == 4999);
+  CHECK(built[1] == 1);
+  CHECK(built[0] == -1);
+  CHECK(transient[1] == -2);
+  CHECK(transient.size() == 5000);
+}
+
+TEST_CASE("PersistentVector copies share all nodes", "[PersistentVector]")
+{
+  PersistentVector<std::string> vector;
+  vector = vector.push_back("a");
+
+  PersistentVector<std::string> copy(vector);
+  CHECK(copy.sharesStorageWith(vector));
+  CHECK_FALSE(copy.push_back("b").sharesStorageWith(vector));
+}
+
+TEST_CASE("PersistentVector releases the elements with the last version", "[PersistentVector]")
+{
+  auto element = std::make_shared<int>(0);
+
+  {
+    PersistentVector<std::shared_ptr<int>>::Transient transient;
+
+    for (int i = 0; i < 3000; ++i)
+      transient.push_back(element);
+
+    PersistentVector<std::shared_ptr<int>> a = transient.persistent();
+    PersistentVector<std::shared_ptr<int>> b = a.set(10, nullptr).pop_back();
+
+    for (int i = 0; i < 1500; ++i)
+      b = b.pop_back();
+
+    CHECK(element.use_count() > 3000);
+  }
+
+  CHECK(element.use_count() == 1);
+}
+
+TEST_CASE("PersistentVector versions can be used from different threads", "[PersistentVector]")
+{
+  PersistentVector<int>::Transient builder;
+
+  for (int i = 0; i < 10'000; ++i)
+    builder.push_back(i);
+
+  const PersistentVector<int> shared = builder.persistent();
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4);
+
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t]() {
+      PersistentVector<int> local = shared;
+
+      for (int i = 0; i < 1000; ++i)
+        local = local.set((i * 37) % 10'000, -t).push_back(i);
+
+      for (int i = 0; i < 10'000; ++i)
+        mismatches[t] += shared[i] != i;
+    });
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (int count : mismatches)
+    CHECK(count == 0);
+}
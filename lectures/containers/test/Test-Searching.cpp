@@ -0,0 +1,69 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/Searching.h"
+
+#include <algorithm>
+
+TEST_CASE("branchlessLowerBound() agrees with std::lower_bound", "[Searching]")
+{
+  for (size_t size : { 0, 1, 2, 3, 7, 8, 100, 1000 }) {
+    FixedSizeArray<int> arr(size);
+
+    // Even numbers with duplicates
+    for (size_t i = 0; i < size; ++i)
+      arr[i] = static_cast<int>(i / 2 * 2);
+
+    for (int value = -1; value <= static_cast<int>(size) + 1; ++value) {
+      size_t expected = std::lower_bound(arr.data(), arr.data() + size, value) - arr.data();
+      REQUIRE(branchlessLowerBound(arr, value) == expected);
+    }
+  }
+}
+
+TEST_CASE("branchlessLowerBound() accepts a custom comparison", "[Searching]")
+{
+  DynamicArray<int> arr;
+
+  for (int value : { 9, 7, 5, 3, 1 })
+    arr.push_back(value);
+
+  CHECK(branchlessLowerBound(arr, 5, std::greater<>()) == 2);
+  CHECK(branchlessLowerBound(arr, 4, std::greater<>()) == 3);
+  CHECK(branchlessLowerBound(arr, 0, std::greater<>()) == 5);
+}
+
+TEST_CASE("EytzingerArray::lowerBound() agrees with std::lower_bound", "[Searching]")
+{
+  for (size_t size : { 0, 1, 2, 3, 7, 8, 15, 16, 100, 1000 }) {
+    DynamicArray<int> sorted;
+
+    for (size_t i = 0; i < size; ++i)
+      sorted.push_back(static_cast<int>(i * 3));
+
+    EytzingerArray<int> table(sorted);
+    REQUIRE(table.size() == size);
+
+    for (int value = -1; value <= static_cast<int>(size * 3) + 1; ++value) {
+      const int* expected = std::lower_bound(sorted.data(), sorted.data() + size, value);
+      const int* found = table.lowerBound(value);
+
+      if (expected == sorted.data() + size) {
+        REQUIRE(found == nullptr);
+      }
+      else {
+        REQUIRE(found);
+        REQUIRE(*found == *expected);
+      }
+
+      REQUIRE(table.contains(value) == (value >= 0 && value % 3 == 0 && value < static_cast<int>(size * 3)));
+    }
+  }
+}
+
+TEST_CASE("EytzingerArray::EytzingerArray() constructs an empty table", "[Searching]")
+{
+  EytzingerArray<int> table;
+  CHECK(table.empty());
+  CHECK(table.lowerBound(0) == nullptr);
+  CHECK_FALSE(table.contains(0));
+}
@@ -0,0 +1,202 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/SharedArray.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+SharedArray<int> makeSequence(int count)
+{
+  SharedArray<int> arr;
+
+  for (int i = 0; i < count; ++i)
+    arr.push_back(i);
+
+  return arr;
+}
+
+TEST_CASE("SharedArray::SharedArray() constructs an empty array without storage", "[SharedArray]")
+{
+  SharedArray<int> arr;
+  const SharedArray<int>& cref = arr;
+
+  CHECK(arr.empty());
+  CHECK(arr.capacity() == 0);
+  CHECK(arr.useCount() == 0);
+  CHECK(cref.data() == nullptr);
+  CHECK(arr.data() == nullptr);
+  REQUIRE_THROWS_AS(cref.at(0), std::out_of_range);
+  REQUIRE_THROWS_AS(arr.pop_back(), SharedArray<int>::EmptyArrayException);
+}
+
+TEST_CASE("SharedArray::SharedArray(N) constructs an array with N elements", "[SharedArray]")
+{
+  SharedArray<int> arr(5);
+
+  CHECK(arr.size() == 5);
+  CHECK(arr.useCount() == 1);
+
+  for (int i = 0; i < 5; ++i)
+    arr[i] = i * i;
+
+  CHECK(arr.at(4) == 16);
+  REQUIRE_THROWS_AS(arr.at(5), std::out_of_range);
+}
+
+TEST_CASE("SharedArray takes over the elements of a DynamicArray", "[SharedArray]")
+{
+  DynamicArray<int> source(3);
+  source[2] = 42;
+  const int* elements = source.data();
+
+  SharedArray<int> arr(std::move(source));
+
+  CHECK(arr.size() == 3);
+  CHECK(std::as_const(arr).data() == elements);
+  CHECK(arr.get(2) == 42);
+}
+
+TEST_CASE("SharedArray copies share the storage", "[SharedArray]")
+{
+  SharedArray<int> arr = makeSequence(100);
+  SharedArray<int> copy(arr);
+  SharedArray<int> assigned;
+  assigned = copy;
+
+  CHECK(arr.useCount() == 3);
+  CHECK(arr.isShared());
+  CHECK(copy.sharesStorageWith(arr));
+  CHECK(assigned.sharesStorageWith(arr));
+  CHECK(std::as_const(copy).data() == std::as_const(arr).data());
+
+  // Reading does not copy
+  const SharedArray<int>& cref = copy;
+  CHECK(cref[50] == 50);
+  CHECK(cref.at(99) == 99);
+  CHECK(copy.get(10) == 10);
+  CHECK(copy.sharesStorageWith(arr));
+}
+
+TEST_CASE("SharedArray copies the storage on the first mutation", "[SharedArray]")
+{
+  SharedArray<int> arr = makeSequence(100);
+  SharedArray<int> snapshot(arr);
+
+  SECTION("operator[]") {
+    arr[0] = -1;
+  }
+  SECTION("at()") {
+    arr.at(0) = -1;
+  }
+  SECTION("data()") {
+    arr.data()[0] = -1;
+  }
+  SECTION("push_back()") {
+    arr.push_back(100);
+    arr[0] = -1;
+  }
+  SECTION("pop_back()") {
+    arr.pop_back();
+    arr[0] = -1;
+  }
+
+  CHECK_FALSE(arr.sharesStorageWith(snapshot));
+  CHECK(arr.useCount() == 1);
+  CHECK(snapshot.useCount() == 1);
+  CHECK(arr.get(0) == -1);
+  CHECK(snapshot.get(0) == 0);
+  CHECK(snapshot.size() == 100);
+
+  for (int i = 1; i < 100; ++i)
+    REQUIRE(snapshot.get(i) == i);
+}
+
+TEST_CASE("SharedArray does not copy storage it does not share", "[SharedArray]")
+{
+  SharedArray<int> arr = makeSequence(10);
+  const int* elements = std::as_const(arr).data();
+
+  {
+    SharedArray<int> copy(arr);
+  }
+
+  arr[0] = 7;
+  CHECK(std::as_const(arr).data() == elements);
+}
+
+TEST_CASE("SharedArray destroys the elements with the last reference", "[SharedArray]")
+{
+  auto counter = std::make_shared<int>(0);
+
+  {
+    SharedArray<std::shared_ptr<int>> arr;
+    arr.push_back(counter);
+
+    SharedArray<std::shared_ptr<int>> copy(arr);
+    SharedArray<std::shared_ptr<int>> moved(std::move(arr));
+
+    CHECK(arr.useCount() == 0);
+    CHECK(moved.useCount() == 2);
+    CHECK(counter.use_count() == 2);
+  }
+
+  CHECK(counter.use_count() == 1);
+}
+
+TEST_CASE("SharedArray snapshots can be read and modified in different threads", "[SharedArray]")
+{
+  const int Size = 1000;
+  const int Threads = 4;
+
+  SharedArray<int> original = makeSequence(Size);
+  std::vector<std::thread> threads;
+  std::vector<long long> sums(Threads);
+  std::vector<int> mismatches(Threads);
+
+  for (int t = 0; t < Threads; ++t) {
+    threads.emplace_back([&, t, snapshot = original]() mutable {
+      for (int round = 0; round < 100; ++round) {
+        SharedArray<int> local(snapshot);
+
+        // Half of the threads modify their copies, which must not affect anyone else
+        if (t % 2 == 0)
+          local[round % Size] = -1;
+
+        for (int i = 0; i < Size; ++i)
+          mismatches[t] += snapshot.get(i) != i;
+      }
+
+      for (int i = 0; i < Size; ++i)
+        sums[t] += snapshot.get(i);
+    });
+  }
+
+  // The owner keeps mutating its own array meanwhile
+  for (int i = 0; i < Size; ++i)
+    original[i] = 0;
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (int t = 0; t < Threads; ++t) {
+    CHECK(mismatches[t] == 0);
+    CHECK(sums[t] == (long long)Size * (Size - 1) / 2);
+  }
+
+  CHECK(original.get(Size - 1) == 0);
+}
+
+TEST_CASE("SharedArray::swap() exchanges the storage", "[SharedArray]")
+{
+  SharedArray<std::string> a;
+  a.push_back("a");
+  SharedArray<std::string> b;
+
+  a.swap(b);
+
+  CHECK(a.empty());
+  CHECK(b.size() == 1);
+  CHECK(b.get(0) == "a");
+}
@@ -0,0 +1,155 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/SoAArray.h"
+
+#include <numeric>
+#include <string>
+
+using Particles = SoAArray<int, double, std::string>;
+
+TEST_CASE("SoAArray::SoAArray() constructs an empty array", "[SoAArray]")
+{
+  Particles arr;
+  CHECK(arr.size() == 0);
+  CHECK(arr.empty());
+  CHECK(arr.capacity() == 0);
+  CHECK(arr.column<0>().empty());
+}
+
+TEST_CASE("SoAArray::push_back() stores each field in its own column", "[SoAArray]")
+{
+  Particles arr;
+
+  for (int i = 0; i < 100; ++i)
+    arr.push_back({ i, i * 0.5, std::to_string(i) });
+
+  REQUIRE(arr.size() == 100);
+  REQUIRE(arr.capacity() >= 100);
+
+  ArraySpan<int> ids = arr.column<0>();
+  ArraySpan<double> weights = arr.column<1>();
+  ArraySpan<std::string> names = arr.column<2>();
+
+  REQUIRE(ids.size() == 100);
+  REQUIRE(weights.size() == 100);
+  REQUIRE(names.size() == 100);
+
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(ids[i] == i);
+    REQUIRE(weights[i] == i * 0.5);
+    REQUIRE(names[i] == std::to_string(i));
+  }
+
+  // The columns are contiguous
+  CHECK(&ids[99] == ids.data() + 99);
+  CHECK(std::accumulate(ids.begin(), ids.end(), 0) == 4950);
+}
+
+TEST_CASE("SoAArray::operator[] and at() give access to all fields of a record", "[SoAArray]")
+{
+  Particles arr;
+  arr.push_back({ 1, 1.5, "one" });
+  arr.push_back({ 2, 2.5, "two" });
+
+  auto [id, weight, name] = arr[1];
+  id = 20;
+  weight = 20.5;
+  name = "twenty";
+
+  CHECK(arr.get<0>(1) == 20);
+  CHECK(arr.get<1>(1) == 20.5);
+  CHECK(arr.get<2>(1) == "twenty");
+
+  const Particles& cref = arr;
+  CHECK(std::get<2>(cref.at(0)) == "one");
+  CHECK(cref.at(1) == Particles::Record(20, 20.5, "twenty"));
+
+  REQUIRE_THROWS_AS(arr.at(2), std::out_of_range);
+  REQUIRE_THROWS_AS(cref.at(2), std::out_of_range);
+}
+
+TEST_CASE("SoAArray::reserve() grows all columns together and keeps the records", "[SoAArray]")
+{
+  Particles arr;
+  arr.push_back({ 7, 7.5, "seven" });
+
+  arr.reserve(1000);
+
+  CHECK(arr.capacity() >= 1000);
+  CHECK(arr.size() == 1);
+  CHECK(arr[0] == Particles::Record(7, 7.5, "seven"));
+
+  const int* ids = arr.column<0>().data();
+
+  for (int i = 1; i < 1000; ++i)
+    arr.push_back({ i, 0, "" });
+
+  // No reallocation happened
+  CHECK(arr.column<0>().data() == ids);
+}
+
+TEST_CASE("SoAArray::pop_back() removes the last record", "[SoAArray]")
+{
+  Particles arr;
+  arr.push_back({ 1, 1, "a" });
+  arr.push_back({ 2, 2, "b" });
+
+  arr.pop_back();
+  CHECK(arr.size() == 1);
+  CHECK(arr.column<2>().size() == 1);
+
+  arr.pop_back();
+  CHECK(arr.empty());
+  REQUIRE_THROWS_AS(arr.pop_back(), Particles::EmptyArrayException);
+}
+
+TEST_CASE("SoAArray::resize() sets the number of records", "[SoAArray]")
+{
+  SoAArray<int, float> arr;
+  arr.resize(50);
+
+  CHECK(arr.size() == 50);
+  CHECK(arr.column<1>().size() == 50);
+}
+
+TEST_CASE("SoAArray::swap() correctly swaps the contents of two arrays", "[SoAArray]")
+{
+  SoAArray<int, char> a, b;
+  a.push_back({ 1, 'a' });
+  a.push_back({ 2, 'b' });
+  b.push_back({ 3, 'c' });
+
+  a.swap(b);
+
+  CHECK(a.size() == 1);
+  CHECK(a.get<1>(0) == 'c');
+  CHECK(b.size() == 2);
+  CHECK(b.get<1>(1) == 'b');
+}
+
+TEST_CASE("SoAArray can be used after it has been moved from", "[SoAArray]")
+{
+  SoAArray<int, char> source;
+
+  for (int i = 0; i < 10; ++i)
+    source.push_back({ i, 'x' });
+
+  SoAArray<int, char> target(std::move(source));
+  CHECK(target.size() == 10);
+  CHECK(target.get<0>(9) == 9);
+  CHECK(source.size() == 0);
+  CHECK(source.capacity() == 0);
+
+  source.push_back({ 42, 'y' });
+  REQUIRE(source.size() == 1);
+  CHECK(source.get<0>(0) == 42);
+
+  target = std::move(source);
+  CHECK(target.size() == 1);
+  CHECK(target.get<1>(0) == 'y');
+  CHECK(source.empty());
+  CHECK(source.capacity() == 0);
+
+  source.push_back({ 7, 'z' });
+  CHECK(source.get<0>(0) == 7);
+}
@@ -0,0 +1,211 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/Sorting.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/// Deterministic pseudo-random values for the tests
+template <typename T>
+DynamicArray<T> randomArray(size_t size, unsigned seed, std::uint64_t range)
+{
+  DynamicArray<T> result;
+  std::uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1;
+
+  for (size_t i = 0; i < size; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    result.push_back(static_cast<T>(state % range));
+  }
+
+  return result;
+}
+
+template <typename T>
+std::vector<T> sortedCopy(const DynamicArray<T>& arr)
+{
+  std::vector<T> result(arr.data(), arr.data() + arr.size());
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+template <typename T>
+bool equals(const DynamicArray<T>& arr, const std::vector<T>& expected)
+{
+  return arr.size() == expected.size() && std::equal(expected.begin(), expected.end(), arr.data());
+}
+
+TEST_CASE("introSort() sorts arrays of various sizes and distributions", "[Sorting]")
+{
+  for (size_t size : { 0, 1, 2, 15, 16, 17, 100, 10'000 }) {
+    for (std::uint64_t range : { 1, 10, 1'000'000 }) {
+      DynamicArray<int> arr = randomArray<int>(size, 1, range);
+      std::vector<int> expected = sortedCopy(arr);
+
+      introSort(arr);
+      REQUIRE(equals(arr, expected));
+    }
+  }
+}
+
+TEST_CASE("introSort() handles sorted, reversed and organ-pipe input", "[Sorting]")
+{
+  const int size = 10'000;
+  FixedSizeArray<int> ascending(size);
+  FixedSizeArray<int> descending(size);
+  FixedSizeArray<int> organPipe(size);
+
+  for (int i = 0; i < size; ++i) {
+    ascending[i] = i;
+    descending[i] = size - i;
+    organPipe[i] = i < size / 2 ? i : size - i;
+  }
+
+  introSort(ascending);
+  introSort(descending);
+  introSort(organPipe);
+
+  CHECK(std::is_sorted(ascending.data(), ascending.data() + size));
+  CHECK(std::is_sorted(descending.data(), descending.data() + size));
+  CHECK(std::is_sorted(organPipe.data(), organPipe.data() + size));
+}
+
+TEST_CASE("introSort() accepts a custom comparison", "[Sorting]")
+{
+  DynamicArray<std::string> arr;
+
+  for (const char* word : { "pear", "fig", "apple", "kiwi", "banana" })
+    arr.push_back(word);
+
+  introSort(arr, std::greater<>());
+
+  CHECK(arr[0] == "pear");
+  CHECK(arr[4] == "apple");
+}
+
+TEMPLATE_TEST_CASE("radixSort() sorts integers", "[Sorting]", std::uint8_t, std::int16_t, std::uint32_t, std::int64_t)
+{
+  for (size_t size : { 0, 1, 255, 256, 10'000 }) {
+    DynamicArray<TestType> arr = randomArray<TestType>(size, 2, std::numeric_limits<std::uint64_t>::max());
+    std::vector<TestType> expected = sortedCopy(arr);
+
+    radixSort(arr);
+    REQUIRE(equals(arr, expected));
+  }
+}
+
+TEST_CASE("radixSort() orders negative and positive numbers", "[Sorting]")
+{
+  DynamicArray<int> arr = randomArray<int>(1000, 3, 2000);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    arr[i] -= 1000;
+
+  std::vector<int> expected = sortedCopy(arr);
+  radixSort(arr);
+
+  CHECK(equals(arr, expected));
+}
+
+TEMPLATE_TEST_CASE("radixSort() sorts floating-point numbers", "[Sorting]", float, double)
+{
+  DynamicArray<TestType> arr;
+
+  for (int i = 0; i < 1000; ++i)
+    arr.push_back(static_cast<TestType>((i * 7919 % 1000 - 500) * 0.25));
+
+  arr.push_back(std::numeric_limits<TestType>::infinity());
+  arr.push_back(-std::numeric_limits<TestType>::infinity());
+  arr.push_back(std::numeric_limits<TestType>::lowest());
+  arr.push_back(std::numeric_limits<TestType>::denorm_min());
+
+  std::vector<TestType> expected = sortedCopy(arr);
+  radixSort(arr);
+
+  CHECK(equals(arr, expected));
+}
+
+TEST_CASE("radixSort() skips bytes that are the same in all elements", "[Sorting]")
+{
+  // Only the lowest byte differs, the result must still be sorted
+  DynamicArray<std::uint64_t> arr = randomArray<std::uint64_t>(1000, 4, 256);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    arr[i] += 0x1234567800000000ull;
+
+  std::vector<std::uint64_t> expected = sortedCopy(arr);
+  radixSort(arr);
+
+  CHECK(equals(arr, expected));
+}
+
+TEST_CASE("parallelMergeSort() sorts with any number of threads", "[Sorting]")
+{
+  for (unsigned threads : { 1, 2, 3, 8 }) {
+    ThreadPool pool(threads);
+
+    for (size_t size : { 0, 1, 1000, 100'000, 100'001 }) {
+      DynamicArray<int> arr = randomArray<int>(size, threads, 1'000'000);
+      std::vector<int> expected = sortedCopy(arr);
+
+      parallelMergeSort(arr, std::less<>(), pool);
+      REQUIRE(equals(arr, expected));
+    }
+  }
+}
+
+TEST_CASE("parallelMergeSort() uses the shared pool by default", "[Sorting]")
+{
+  FixedSizeArray<int> arr(50'000);
+
+  for (size_t i = 0; i < arr.size(); ++i)
+    arr[i] = static_cast<int>(arr.size() - i);
+
+  parallelMergeSort(arr);
+  CHECK(std::is_sorted(arr.data(), arr.data() + arr.size()));
+}
+
+TEST_CASE("parallelMergeSort() is stable", "[Sorting]")
+{
+  struct Record {
+    int key = 0;
+    int order = 0;
+  };
+
+  DynamicArray<Record> arr;
+  DynamicArray<int> keys = randomArray<int>(100'000, 5, 100);
+
+  for (size_t i = 0; i < keys.size(); ++i)
+    arr.push_back(Record{ keys[i], static_cast<int>(i) });
+
+  ThreadPool pool(4);
+  parallelMergeSort(arr, [](const Record& a, const Record& b) { return a.key < b.key; }, pool);
+
+  for (size_t i = 1; i < arr.size(); ++i) {
+    REQUIRE(arr[i - 1].key <= arr[i].key);
+
+    if (arr[i - 1].key == arr[i].key)
+      REQUIRE(arr[i - 1].order < arr[i].order);
+  }
+}
+
+TEST_CASE("parallelMergeSort() propagates exceptions from the comparison", "[Sorting]")
+{
+  DynamicArray<int> arr = randomArray<int>(100'000, 6, 1000);
+  std::atomic<int> calls{0};
+
+  auto throwing = [&calls](int a, int b) {
+    if (calls.fetch_add(1) == 500'000)
+      throw std::runtime_error("comparison failed");
+
+    return a < b;
+  };
+
+  ThreadPool pool(2);
+  CHECK_THROWS_AS(parallelMergeSort(arr, throwing, pool), std::runtime_error);
+}
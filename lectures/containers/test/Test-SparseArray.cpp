@@ -0,0 +1,184 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/SparseArray.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename T>
+void checkEqual(const SparseArray<T>& arr, const std::vector<T>& expected)
+{
+  REQUIRE(arr.size() == expected.size());
+
+  size_t nonDefault = 0;
+
+  for (size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(arr[i] == expected[i]);
+    nonDefault += expected[i] != T();
+  }
+
+  CHECK(arr.storedCount() == nonDefault);
+
+  size_t visited = 0;
+  size_t previous = 0;
+
+  arr.forEachNonDefault([&](size_t index, const T& value) {
+    REQUIRE((visited == 0 || index > previous));
+    REQUIRE(value == expected[index]);
+    previous = index;
+    ++visited;
+  });
+
+  CHECK(visited == nonDefault);
+}
+
+TEST_CASE("SparseArray::SparseArray(N) constructs N default elements without storing them", "[SparseArray]")
+{
+  SparseArray<int> arr(1'000'000'000);
+
+  CHECK(arr.size() == 1'000'000'000);
+  CHECK(arr[123'456'789] == 0);
+  CHECK(arr.storedCount() == 0);
+  CHECK(arr.runCount() == 0);
+  REQUIRE_THROWS_AS(arr.at(1'000'000'000), std::out_of_range);
+  REQUIRE_THROWS_AS(arr.set(1'000'000'000, 1), std::out_of_range);
+}
+
+TEST_CASE("SparseArray::set() merges adjacent elements into runs", "[SparseArray]")
+{
+  SparseArray<int> arr(100);
+
+  arr.set(10, 1);
+  arr.set(12, 3);
+  CHECK(arr.runCount() == 2);
+
+  arr.set(11, 2);
+  CHECK(arr.runCount() == 1);
+
+  arr.set(9, 0);
+  arr.set(9, 9);
+  arr.set(13, 4);
+  CHECK(arr.runCount() == 1);
+
+  std::vector<size_t> firsts;
+  std::vector<size_t> counts;
+  arr.forEachRun([&](size_t first, const int* values, size_t count) {
+    firsts.push_back(first);
+    counts.push_back(count);
+    CHECK(values[0] == arr[first]);
+  });
+
+  CHECK(firsts == std::vector<size_t>{ 9 });
+  CHECK(counts == std::vector<size_t>{ 5 });
+}
+
+TEST_CASE("SparseArray::reset() splits a run", "[SparseArray]")
+{
+  SparseArray<int> arr(10);
+
+  for (size_t i = 0; i < 10; ++i)
+    arr.set(i, int(i) + 1);
+
+  arr.reset(5);
+  CHECK(arr.runCount() == 2);
+  CHECK(arr[5] == 0);
+  CHECK(arr[4] == 5);
+  CHECK(arr[6] == 7);
+
+  arr.set(5, 0);
+  CHECK(arr.runCount() == 2);
+
+  arr.reset(0);
+  arr.reset(9);
+  CHECK(arr.storedCount() == 7);
+  CHECK(arr[1] == 2);
+  CHECK(arr[8] == 9);
+}
+
+TEST_CASE("SparseArray::push_back() and pop_back() change the size", "[SparseArray]")
+{
+  SparseArray<std::string> arr;
+
+  arr.push_back("a");
+  arr.push_back("");
+  arr.push_back("c");
+
+  CHECK(arr.size() == 3);
+  CHECK(arr.storedCount() == 2);
+  CHECK(arr.at(2) == "c");
+
+  arr.pop_back();
+  CHECK(arr.size() == 2);
+  CHECK(arr.storedCount() == 1);
+
+  arr.pop_back();
+  arr.pop_back();
+  CHECK(arr.empty());
+  REQUIRE_THROWS_AS(arr.pop_back(), SparseArray<std::string>::EmptyArrayException);
+}
+
+TEST_CASE("SparseArray::resize() drops the elements past the new size", "[SparseArray]")
+{
+  SparseArray<int> arr(100);
+
+  for (size_t i = 40; i < 60; ++i)
+    arr.set(i, 1);
+
+  arr.set(80, 1);
+  arr.resize(50);
+
+  CHECK(arr.size() == 50);
+  CHECK(arr.storedCount() == 10);
+
+  arr.resize(100);
+  CHECK(arr[55] == 0);
+  CHECK(arr[80] == 0);
+}
+
+TEST_CASE("SparseArray is empty after it has been moved from", "[SparseArray]")
+{
+  SparseArray<int> source(100);
+  source.set(50, 5);
+
+  SparseArray<int> target(std::move(source));
+  CHECK(target.size() == 100);
+  CHECK(target[50] == 5);
+  CHECK(source.size() == 0);
+  CHECK(source.storedCount() == 0);
+
+  source = std::move(target);
+  CHECK(source[50] == 5);
+  CHECK(target.empty());
+
+  target.push_back(1);
+  checkEqual(target, { 1 });
+}
+
+TEST_CASE("SparseArray matches a dense array under random updates", "[SparseArray]")
+{
+  const size_t Size = 500;
+
+  std::mt19937 random(7);
+  SparseArray<int> arr(Size);
+  std::vector<int> expected(Size);
+
+  for (int step = 0; step < 20'000; ++step) {
+    size_t index = random() % Size;
+
+    // Half of the updates set the default value, so the runs keep splitting and merging
+    int value = random() % 2 ? 0 : int(random() % 100);
+
+    if (random() % 4 == 0) {
+      arr.reset(index);
+      value = 0;
+    }
+    else {
+      arr.set(index, value);
+    }
+
+    expected[index] = value;
+  }
+
+  checkEqual(arr, expected);
+}
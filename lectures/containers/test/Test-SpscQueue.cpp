@@ -0,0 +1,79 @@
+#include "catch2/catch_all.hpp"
+
+#include "containers/SpscQueue.h"
+
+#include <string>
+#include <thread>
+
+TEST_CASE("SpscQueue::SpscQueue() rounds the capacity up to a power of two", "[SpscQueue]")
+{
+  CHECK(SpscQueue<int>(1).capacity() == 1);
+  CHECK(SpscQueue<int>(5).capacity() == 8);
+  CHECK(SpscQueue<int>(64).capacity() == 64);
+}
+
+TEST_CASE("SpscQueue::tryPop() fails when the queue is empty", "[SpscQueue]")
+{
+  SpscQueue<int> queue(4);
+  int value = -1;
+
+  REQUIRE_FALSE(queue.tryPop(value));
+  CHECK(value == -1);
+}
+
+TEST_CASE("SpscQueue::tryPush() fails when the queue is full", "[SpscQueue]")
+{
+  SpscQueue<int> queue(4);
+
+  for (int i = 0; i < 4; ++i)
+    REQUIRE(queue.tryPush(i));
+
+  REQUIRE_FALSE(queue.tryPush(4));
+
+  int value;
+  REQUIRE(queue.tryPop(value));
+  CHECK(value == 0);
+  REQUIRE(queue.tryPush(4));
+}
+
+TEST_CASE("SpscQueue returns the elements in the order they were added", "[SpscQueue]")
+{
+  SpscQueue<std::string> queue(8);
+
+  // Several rounds, so that the indices wrap around the ring
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 5; ++i)
+      REQUIRE(queue.tryPush(std::to_string(round * 5 + i)));
+
+    for (int i = 0; i < 5; ++i) {
+      std::string value;
+      REQUIRE(queue.tryPop(value));
+      REQUIRE(value == std::to_string(round * 5 + i));
+    }
+  }
+}
+
+TEST_CASE("SpscQueue transfers all elements in order between two threads", "[SpscQueue]")
+{
+  SpscQueue<size_t> queue(64);
+  const size_t count = 200'000;
+
+  std::thread producer([&queue]() {
+    for (size_t i = 0; i < count; ++i)
+      queue.push(i);
+  });
+
+  size_t outOfOrder = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (queue.pop() != i)
+      ++outOfOrder;
+  }
+
+  producer.join();
+
+  REQUIRE(outOfOrder == 0);
+
+  size_t value;
+  REQUIRE_FALSE(queue.tryPop(value));
+}
@@ -0,0 +1,138 @@
+#include "utils/Stopwatch.h"
+#include "utils/ThreadPool.h"
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/// Simulates a piece of work, whose cost grows with units
+double work(size_t units)
+{
+	double value = 0;
+
+	for (size_t i = 0; i < units * 20'000; ++i)
+		value += std::sqrt(static_cast<double>(i));
+
+	return value;
+}
+
+/// Cost of item i out of count: most items are cheap, the last tenth are 20 times more expensive
+size_t skewedCost(size_t i, size_t count)
+{
+	return i < count - count / 10 ? 1 : 20;
+}
+
+int main()
+{
+	const size_t SpawnedTasks = 1'000'000;
+	const size_t Items = 2'000;
+	unsigned threads = ThreadPool::defaultThreadCount();
+
+	ThreadPool pool(threads);
+	Stopwatch sw;
+
+	std::cout << "ThreadPool with " << pool.threadCount() << " worker threads\n\n";
+
+	//
+	// Spawn overhead
+	//
+	{
+		std::atomic<size_t> counter{0};
+
+		std::cout << "Spawning " << SpawnedTasks << " empty tasks with a TaskGroup...";
+		sw.start();
+
+		TaskGroup group(pool);
+
+		for (size_t i = 0; i < SpawnedTasks; ++i)
+			group.run([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+
+		group.wait();
+
+		sw.stop();
+		std::cout << " (ran " << counter.load() << ")\n    execution took " << sw << "\n";
+
+		counter = 0;
+		std::cout << "Running " << SpawnedTasks << " single-element chunks with parallelFor()...";
+		sw.start();
+
+		pool.parallelFor(0, SpawnedTasks, 1, [&counter](size_t first, size_t last) {
+			counter.fetch_add(last - first, std::memory_order_relaxed);
+		});
+
+		sw.stop();
+		std::cout << " (ran " << counter.load() << ")\n    execution took " << sw << "\n";
+
+		const size_t ThreadsStarted = 10'000;
+		counter = 0;
+		std::cout << "Starting and joining " << ThreadsStarted << " std::threads for comparison...";
+		sw.start();
+
+		for (size_t i = 0; i < ThreadsStarted; ++i)
+			std::thread([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); }).join();
+
+		sw.stop();
+		std::cout << " (ran " << counter.load() << ")\n    execution took " << sw << "\n\n";
+	}
+
+	//
+	// Load balancing under skewed work
+	//
+	{
+		double total = 0;
+
+		std::cout << "Skewed work on a single thread...";
+		sw.start();
+
+		for (size_t i = 0; i < Items; ++i)
+			total += work(skewedCost(i, Items));
+
+		sw.stop();
+		std::cout << " (total " << total << ")\n    execution took " << sw << "\n";
+
+		std::cout << "Skewed work split statically into " << threads << " equal ranges...";
+		std::vector<double> partial(threads);
+		sw.start();
+
+		std::vector<std::thread> workers;
+
+		for (unsigned t = 0; t < threads; ++t) {
+			workers.emplace_back([t, threads, Items, &partial]() {
+				for (size_t i = Items * t / threads; i < Items * (t + 1) / threads; ++i)
+					partial[t] += work(skewedCost(i, Items));
+			});
+		}
+
+		for (std::thread& worker : workers)
+			worker.join();
+
+		sw.stop();
+		total = 0;
+
+		for (double value : partial)
+			total += value;
+
+		std::cout << " (total " << total << ")\n    execution took " << sw << "\n";
+
+		std::cout << "Skewed work with parallelReduce()...";
+		sw.start();
+
+		total = pool.parallelReduce<double>(0, Items, 4, 0.0,
+			[Items](size_t first, size_t last) {
+				double sum = 0;
+
+				for (size_t i = first; i < last; ++i)
+					sum += work(skewedCost(i, Items));
+
+				return sum;
+			},
+			[](double left, double right) { return left + right; });
+
+		sw.stop();
+		std::cout << " (total " << total << ")\n    execution took " << sw << "\n\n";
+	}
+
+	return 0;
+}
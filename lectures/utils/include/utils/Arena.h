@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+///
+/// @brief A monotonic allocator, which hands out memory by bumping a pointer.
+///
+/// Memory is carved out of chunks obtained from an upstream resource. Each new
+/// chunk is twice as large as the previous one. Deallocating does nothing:
+/// the memory is reclaimed all at once by reset() or release(). This makes
+/// allocation a few instructions and deallocation free, which suits scratch
+/// data with a common lifetime, such as the temporary arrays of one
+/// evaluation.
+///
+/// reset() keeps the largest chunk, so a loop that resets the arena after
+/// each iteration stops allocating from the upstream resource after the first
+/// few iterations.
+///
+/// The arena is a std::pmr::memory_resource, so it can back std::pmr containers,
+/// and DynamicArray through MemoryResourceAllocation. It is not thread-safe.
+///
+class Arena final : public std::pmr::memory_resource {
+	/// Placed at the beginning of each chunk
+	struct Chunk {
+		Chunk* previous;
+		size_t size;
+	};
+
+	std::pmr::memory_resource* m_upstream;
+	Chunk* m_chunks = nullptr;
+	std::byte* m_next = nullptr;
+	std::byte* m_end = nullptr;
+	size_t m_nextChunkSize;
+	size_t m_used = 0;
+
+	/// A buffer supplied by the caller, which is used before any chunk is allocated
+	std::byte* m_initialBuffer = nullptr;
+	size_t m_initialSize = 0;
+
+public:
+	static constexpr size_t DefaultChunkSize = 4096;
+
+	/// Creates an empty arena. The first allocation obtains a chunk of initialChunkSize bytes.
+	explicit Arena(size_t initialChunkSize = DefaultChunkSize, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+		: m_upstream(upstream), m_nextChunkSize(std::max(initialChunkSize, sizeof(Chunk) * 2))
+	{}
+
+	/// Creates an arena, which first uses the given buffer (e.g. an array on the stack).
+	/// The buffer is not owned by the arena and must outlive it.
+	Arena(void* buffer, size_t size, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+		: Arena(std::max(size, DefaultChunkSize), upstream)
+	{
+		m_initialBuffer = static_cast<std::byte*>(buffer);
+		m_initialSize = size;
+		m_next = m_initialBuffer;
+		m_end = m_initialBuffer + size;
+	}
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	~Arena() noexcept override
+	{
+		release();
+	}
+
+	/// Number of bytes handed out since the last reset() or release()
+	size_t bytesUsed() const noexcept
+	{
+		return m_used;
+	}
+
+	/// Number of bytes obtained from the upstream resource, which the arena still holds
+	size_t bytesReserved() const noexcept
+	{
+		size_t total = 0;
+
+		for (Chunk* chunk = m_chunks; chunk; chunk = chunk->previous)
+			total += chunk->size;
+
+		return total;
+	}
+
+	///
+	/// Makes all memory available again, invalidating everything allocated so far.
+	/// The largest chunk is kept for the next allocations, the others are returned upstream.
+	///
+	void reset() noexcept
+	{
+		m_used = 0;
+
+		if ( ! m_chunks) {
+			m_next = m_initialBuffer;
+			m_end = m_initialBuffer + m_initialSize;
+			return;
+		}
+
+		// The chunks grow, so the most recent one is the largest
+		Chunk* largest = m_chunks;
+		freeChunks(largest->previous);
+		largest->previous = nullptr;
+
+		m_next = reinterpret_cast<std::byte*>(largest + 1);
+		m_end = reinterpret_cast<std::byte*>(largest) + largest->size;
+	}
+
+	/// Returns all chunks to the upstream resource, invalidating everything allocated so far
+	void release() noexcept
+	{
+		freeChunks(m_chunks);
+		m_chunks = nullptr;
+		m_used = 0;
+		m_next = m_initialBuffer;
+		m_end = m_initialBuffer + m_initialSize;
+	}
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		bytes = std::max<size_t>(bytes, 1);
+
+		std::uintptr_t next = reinterpret_cast<std::uintptr_t>(m_next);
+		std::uintptr_t end = reinterpret_cast<std::uintptr_t>(m_end);
+		std::uintptr_t aligned = (next + alignment - 1) & ~std::uintptr_t(alignment - 1);
+
+		// Compared as remaining space, so that a huge request cannot wrap around the address space
+		if (m_next && aligned >= next && aligned <= end && bytes <= end - aligned) {
+			m_next = reinterpret_cast<std::byte*>(aligned + bytes);
+			m_used += bytes;
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		return allocateFromNewChunk(bytes, alignment);
+	}
+
+	/// Does nothing. The memory is reclaimed by reset() or release().
+	void do_deallocate(void*, size_t, size_t) noexcept override
+	{}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	void* allocateFromNewChunk(size_t bytes, size_t alignment)
+	{
+		if (bytes > std::numeric_limits<size_t>::max() - sizeof(Chunk) - alignment)
+			throw std::bad_alloc();
+
+		size_t needed = sizeof(Chunk) + bytes + alignment;
+		size_t size = std::max(m_nextChunkSize, needed);
+
+		void* memory = m_upstream->allocate(size, alignof(std::max_align_t));
+		Chunk* chunk = new (memory) Chunk{ m_chunks, size };
+
+		m_chunks = chunk;
+		m_next = reinterpret_cast<std::byte*>(chunk + 1);
+		m_end = reinterpret_cast<std::byte*>(chunk) + size;
+		m_nextChunkSize = size * 2;
+
+		return do_allocate(bytes, alignment);
+	}
+
+	void freeChunks(Chunk* chunk) noexcept
+	{
+		while (chunk) {
+			Chunk* previous = chunk->previous;
+			m_upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+			chunk = previous;
+		}
+	}
+};
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///
+/// @brief A set of named benchmarks, whose results are written as JSON and
+/// compared to a baseline to detect regressions.
+///
+/// Each benchmark is a callable, which performs a fixed number of operations
+/// and returns a value computed from them. The value is passed to keep(), so
+/// the optimizer cannot discard the work. The callable is run once to warm up
+/// the caches and then a number of times, which are timed. The median of the
+/// timed runs is recorded, because it is not affected by the occasional
+/// interruption the way the mean is.
+///
+/// run() accepts the following command-line options:
+///
+///     --output <file>       Write the results to a JSON file
+///     --baseline <file>     Compare the results to a baseline. If the file does
+///                           not exist yet, it is created from the results.
+///     --update-baseline     Overwrite the baseline with the results
+///     --threshold <ratio>   Largest slowdown, which is not a regression (default 0.15)
+///     --samples <count>     Number of timed runs of each benchmark (default 9)
+///     --filter <text>       Only run the benchmarks, whose names contain text
+///
+/// homework/hw1/template/benchmark/benchmark-suite.h is an identical copy, so
+/// that the homework template can be built on its own. The copy in
+/// lectures/utils is the canonical one: change it and then copy it there.
+///
+class BenchmarkSuite {
+public:
+	/// Returned by run() when a benchmark is slower than its baseline by more than the threshold
+	static constexpr int RegressionExitCode = 1;
+
+	/// Returned by run() when the command line is not valid
+	static constexpr int UsageExitCode = 2;
+
+	/// Returned by run() when a comparison is requested from an unoptimized build,
+	/// whose timings say nothing about the release build. CTest reports it as skipped.
+	static constexpr int SkippedExitCode = 77;
+
+	/// The measurement of a single benchmark
+	struct Result {
+		std::string name;
+		size_t operations = 0;
+		double medianNanoseconds = 0;
+		double minNanoseconds = 0;
+
+		/// Median time per operation
+		double nanosecondsPerOperation() const noexcept
+		{
+			return operations ? medianNanoseconds / operations : medianNanoseconds;
+		}
+	};
+
+private:
+	using clock = std::chrono::steady_clock;
+
+	struct Benchmark {
+		std::string name;
+		size_t operations;
+		std::function<void()> body;
+	};
+
+	struct Options {
+		std::string output;
+		std::string baseline;
+		bool updateBaseline = false;
+		double threshold = 0.15;
+		size_t samples = 9;
+		std::string filter;
+	};
+
+	std::string m_name;
+	std::vector<Benchmark> m_benchmarks;
+
+public:
+	/// Creates an empty suite. The name is recorded in the JSON output.
+	explicit BenchmarkSuite(std::string name)
+		: m_name(std::move(name))
+	{}
+
+	const std::string& name() const noexcept
+	{
+		return m_name;
+	}
+
+	/// Adds a benchmark, each call of which performs the given number of operations.
+	/// body is called repeatedly, so it must set up its own input (or reuse captured state).
+	template <typename Body>
+	void add(std::string name, size_t operations, Body body)
+	{
+		m_benchmarks.push_back({
+			std::move(name),
+			operations,
+			[body]() mutable { keep(body()); }
+		});
+	}
+
+	/// Makes the compiler assume that value is used, so that the computation of it is not removed
+	template <typename T>
+	static void keep(const T& value) noexcept
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "r"(&value) : "memory");
+#else
+		static const void* volatile sink;
+		sink = &value;
+#endif
+	}
+
+	/// Checks whether the benchmarks were compiled with optimization enabled
+	static constexpr bool isOptimizedBuild() noexcept
+	{
+#if defined(__OPTIMIZE__) || defined(NDEBUG)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/// Parses the command line, runs the benchmarks, writes their results and compares them to the baseline.
+	/// Returns the exit code of the program.
+	int run(int argc, char* argv[])
+	{
+		Options options;
+
+		if ( ! parseOptions(argc, argv, options)) {
+			printUsage(argc > 0 ? argv[0] : "benchmarks");
+			return UsageExitCode;
+		}
+
+		if ( ! options.baseline.empty() && ! isOptimizedBuild()) {
+			std::cout << "The benchmarks were built without optimization, so they are not compared to the baseline\n";
+			return SkippedExitCode;
+		}
+
+		std::cout << "=== " << m_name << " ===\n\n";
+
+		std::vector<Result> results;
+
+		for (Benchmark& benchmark : m_benchmarks) {
+			if (benchmark.name.find(options.filter) == std::string::npos)
+				continue;
+
+			std::cout << "    " << benchmark.name << "...";
+			std::cout.flush();
+
+			results.push_back(measure(benchmark, options.samples));
+			std::cout << " " << formatNanoseconds(results.back().nanosecondsPerOperation()) << " per operation\n";
+		}
+
+		std::cout << "\n";
+
+		if ( ! options.output.empty() && ! writeResults(options.output, results))
+			return UsageExitCode;
+
+		if (options.baseline.empty())
+			return 0;
+
+		std::ifstream baselineFile(options.baseline);
+
+		if (options.updateBaseline || ! baselineFile) {
+			std::cout << "Recording the results as the baseline in " << options.baseline << "\n";
+			return writeResults(options.baseline, results) ? 0 : UsageExitCode;
+		}
+
+		return compare(results, readJson(baselineFile), options.threshold) ? 0 : RegressionExitCode;
+	}
+
+	/// Writes results as JSON
+	void writeJson(std::ostream& out, const std::vector<Result>& results) const
+	{
+		out << std::fixed << std::setprecision(1);
+		out << "{\n\t\"suite\": \"" << escape(m_name) << "\",\n\t\"benchmarks\": [\n";
+
+		for (size_t i = 0; i < results.size(); ++i) {
+			const Result& result = results[i];
+
+			out
+				<< "\t\t{ \"name\": \"" << escape(result.name) << "\""
+				<< ", \"operations\": " << result.operations
+				<< ", \"median_ns\": " << result.medianNanoseconds
+				<< ", \"min_ns\": " << result.minNanoseconds
+				<< " }" << (i + 1 < results.size() ? "," : "") << "\n";
+		}
+
+		out << "\t]\n}\n";
+	}
+
+	/// Reads the results written by writeJson().
+	/// This is not a general JSON parser: it only looks for the keys that writeJson() produces.
+	static std::vector<Result> readJson(std::istream& in)
+	{
+		std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		std::vector<Result> results;
+
+		size_t position = text.find("\"name\"");
+
+		while (position != std::string::npos) {
+			size_t next = text.find("\"name\"", position + 1);
+			std::string object = text.substr(position, next == std::string::npos ? std::string::npos : next - position);
+
+			Result result;
+			result.name = readString(object, "\"name\"");
+			result.operations = static_cast<size_t>(readNumber(object, "\"operations\""));
+			result.medianNanoseconds = readNumber(object, "\"median_ns\"");
+			result.minNanoseconds = readNumber(object, "\"min_ns\"");
+			results.push_back(std::move(result));
+
+			position = next;
+		}
+
+		return results;
+	}
+
+	/// Prints a comparison of results to baseline.
+	/// Returns false if a benchmark is slower than its baseline by more than threshold (e.g. 0.15 for 15%).
+	static bool compare(const std::vector<Result>& results, const std::vector<Result>& baseline, double threshold)
+	{
+		std::cout << "Comparison to the baseline (regression threshold +" << std::fixed << std::setprecision(0) << threshold * 100 << "%)\n";
+
+		size_t regressions = 0;
+
+		for (const Result& result : results) {
+			auto previous = std::find_if(baseline.begin(), baseline.end(), [&result](const Result& r) { return r.name == result.name; });
+
+			std::cout << "    " << result.name << ": ";
+
+			if (previous == baseline.end() || previous->medianNanoseconds <= 0) {
+				std::cout << "not in the baseline\n";
+				continue;
+			}
+
+			double change = result.medianNanoseconds / previous->medianNanoseconds - 1;
+			bool regressed = change > threshold;
+
+			std::cout
+				<< formatNanoseconds(result.nanosecondsPerOperation())
+				<< " vs " << formatNanoseconds(previous->nanosecondsPerOperation())
+				<< " (" << std::showpos << std::setprecision(1) << change * 100 << std::noshowpos << "%)"
+				<< (regressed ? "  REGRESSION" : "") << "\n";
+
+			if (regressed)
+				++regressions;
+		}
+
+		if (regressions == 0)
+			std::cout << "\nNo regressions\n";
+		else
+			std::cout << "\n" << regressions << " benchmark(s) regressed\n";
+
+		return regressions == 0;
+	}
+
+private:
+	static Result measure(Benchmark& benchmark, size_t samples)
+	{
+		benchmark.body();
+
+		std::vector<double> nanoseconds(samples);
+
+		for (double& sample : nanoseconds) {
+			clock::time_point start = clock::now();
+			benchmark.body();
+			sample = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+		}
+
+		std::sort(nanoseconds.begin(), nanoseconds.end());
+
+		Result result;
+		result.name = benchmark.name;
+		result.operations = benchmark.operations;
+		result.medianNanoseconds = nanoseconds[samples / 2];
+		result.minNanoseconds = nanoseconds[0];
+		return result;
+	}
+
+	bool writeResults(const std::string& path, const std::vector<Result>& results) const
+	{
+		std::ofstream out(path);
+
+		if (out)
+			writeJson(out, results);
+
+		if ( ! out) {
+			std::cerr << "Cannot write " << path << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	static bool parseOptions(int argc, char* argv[], Options& options)
+	{
+		for (int i = 1; i < argc; ++i) {
+			std::string option = argv[i];
+
+			if (option == "--update-baseline") {
+				options.updateBaseline = true;
+				continue;
+			}
+
+			if (i + 1 == argc)
+				return false;
+
+			std::string value = argv[++i];
+
+			if (option == "--output") {
+				options.output = value;
+			}
+			else if (option == "--baseline") {
+				options.baseline = value;
+			}
+			else if (option == "--threshold") {
+				options.threshold = std::atof(value.c_str());
+
+				if (options.threshold <= 0)
+					return false;
+			}
+			else if (option == "--samples") {
+				options.samples = static_cast<size_t>(std::atoi(value.c_str()));
+
+				if (options.samples == 0)
+					return false;
+			}
+			else if (option == "--filter") {
+				options.filter = value;
+			}
+			else {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static void printUsage(const char* program)
+	{
+		std::cerr
+			<< "Usage: " << program << " [options]\n"
+			<< "    --output <file>       Write the results to a JSON file\n"
+			<< "    --baseline <file>     Compare the results to a baseline (created if it does not exist)\n"
+			<< "    --update-baseline     Overwrite the baseline with the results\n"
+			<< "    --threshold <ratio>   Largest slowdown, which is not a regression (default 0.15)\n"
+			<< "    --samples <count>     Number of timed runs of each benchmark (default 9)\n"
+			<< "    --filter <text>       Only run the benchmarks, whose names contain text\n";
+	}
+
+	static std::string formatNanoseconds(double nanoseconds)
+	{
+		std::ostringstream out;
+		out << std::fixed << std::setprecision(nanoseconds < 10 ? 3 : 1) << nanoseconds << "ns";
+		return out.str();
+	}
+
+	static std::string escape(const std::string& text)
+	{
+		std::string result;
+
+		for (char c : text) {
+			if (c == '"' || c == '\\')
+				result += '\\';
+
+			result += c;
+		}
+
+		return result;
+	}
+
+	/// Finds key in object and returns the position after the colon, which follows it
+	static size_t findValue(const std::string& object, const char* key)
+	{
+		size_t position = object.find(key);
+
+		if (position == std::string::npos)
+			return std::string::npos;
+
+		position = object.find(':', position);
+		return position == std::string::npos ? position : position + 1;
+	}
+
+	static std::string readString(const std::string& object, const char* key)
+	{
+		size_t position = findValue(object, key);
+
+		if (position == std::string::npos || (position = object.find('"', position)) == std::string::npos)
+			return std::string();
+
+		std::string result;
+
+		for (++position; position < object.size() && object[position] != '"'; ++position) {
+			if (object[position] == '\\' && position + 1 < object.size())
+				++position;
+
+			result += object[position];
+		}
+
+		return result;
+	}
+
+	static double readNumber(const std::string& object, const char* key)
+	{
+		size_t position = findValue(object, key);
+		return position == std::string::npos ? 0 : std::strtod(object.c_str() + position, nullptr);
+	}
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+///
+/// @brief A pool of fixed-size memory blocks with a free list.
+///
+/// Blocks are carved out of chunks obtained from an upstream resource.
+/// A freed block is pushed onto an intrusive singly-linked free list and is
+/// handed out again by the next allocation, so allocating and freeing are a
+/// few instructions each and the memory of freed objects is reused while it
+/// is still in the cache.
+///
+/// Requests larger than the block size, or with a stricter alignment than
+/// BlockAlignment, are passed to the upstream resource. The chunks are
+/// returned to the upstream resource when the pool is destroyed.
+///
+/// The pool is a std::pmr::memory_resource, so it can back std::pmr containers,
+/// and DynamicArray through MemoryResourceAllocation. It is not thread-safe.
+///
+class ObjectPool final : public std::pmr::memory_resource {
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	struct Chunk {
+		Chunk* previous;
+	};
+
+public:
+	/// Alignment of every block
+	static constexpr size_t BlockAlignment = alignof(std::max_align_t);
+
+private:
+	std::pmr::memory_resource* m_upstream;
+	size_t m_blockSize;
+	size_t m_blocksPerChunk;
+	size_t m_blocksInUse = 0;
+
+	FreeBlock* m_free = nullptr;
+	Chunk* m_chunks = nullptr;
+
+	/// The part of the newest chunk, which has not been handed out yet
+	std::byte* m_next = nullptr;
+	std::byte* m_end = nullptr;
+
+public:
+	///
+	/// Creates an empty pool for blocks of at least blockSize bytes.
+	/// The block size is rounded up to a multiple of BlockAlignment.
+	///
+	explicit ObjectPool(size_t blockSize, size_t blocksPerChunk = 64, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+		: m_upstream(upstream),
+		  m_blockSize(roundUp(std::max(blockSize, sizeof(FreeBlock)))),
+		  m_blocksPerChunk(std::max<size_t>(blocksPerChunk, 1))
+	{}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	~ObjectPool() noexcept override
+	{
+		while (m_chunks) {
+			Chunk* previous = m_chunks->previous;
+			m_upstream->deallocate(m_chunks, chunkSize(), BlockAlignment);
+			m_chunks = previous;
+		}
+	}
+
+	/// Size of each block in bytes
+	size_t blockSize() const noexcept
+	{
+		return m_blockSize;
+	}
+
+	/// Number of blocks, which have been allocated and not freed
+	size_t blocksInUse() const noexcept
+	{
+		return m_blocksInUse;
+	}
+
+	/// Allocates a block and constructs a T in it
+	/// @exception std::bad_alloc Memory allocation failed
+	template <typename T, typename... Args>
+	T* create(Args&&... args)
+	{
+		void* memory = allocate(sizeof(T), alignof(T));
+
+		try {
+			return new (memory) T(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			deallocate(memory, sizeof(T), alignof(T));
+			throw;
+		}
+	}
+
+	/// Destroys an object created by create() and returns its block to the pool
+	template <typename T>
+	void destroy(T* object) noexcept
+	{
+		if (object) {
+			object->~T();
+			deallocate(object, sizeof(T), alignof(T));
+		}
+	}
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		if ( ! fits(bytes, alignment))
+			return m_upstream->allocate(bytes, alignment);
+
+		if (m_free) {
+			FreeBlock* block = m_free;
+			m_free = block->next;
+			++m_blocksInUse;
+			return block;
+		}
+
+		// Counted only once the block is obtained, so a failed addChunk() leaves the count unchanged
+		if (m_next == m_end)
+			addChunk();
+
+		void* block = m_next;
+		m_next += m_blockSize;
+		++m_blocksInUse;
+		return block;
+	}
+
+	void do_deallocate(void* p, size_t bytes, size_t alignment) noexcept override
+	{
+		if ( ! fits(bytes, alignment)) {
+			m_upstream->deallocate(p, bytes, alignment);
+			return;
+		}
+
+		--m_blocksInUse;
+		m_free = new (p) FreeBlock{ m_free };
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	static size_t roundUp(size_t bytes) noexcept
+	{
+		return (bytes + BlockAlignment - 1) & ~(BlockAlignment - 1);
+	}
+
+	bool fits(size_t bytes, size_t alignment) const noexcept
+	{
+		return bytes <= m_blockSize && alignment <= BlockAlignment;
+	}
+
+	/// The blocks start after a header, which is padded to keep them aligned
+	size_t chunkSize() const noexcept
+	{
+		return roundUp(sizeof(Chunk)) + m_blockSize * m_blocksPerChunk;
+	}
+
+	void addChunk()
+	{
+		void* memory = m_upstream->allocate(chunkSize(), BlockAlignment);
+		m_chunks = new (memory) Chunk{ m_chunks };
+
+		m_next = static_cast<std::byte*>(memory) + roundUp(sizeof(Chunk));
+		m_end = m_next + m_blockSize * m_blocksPerChunk;
+	}
+};
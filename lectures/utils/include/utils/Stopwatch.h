@@ -22,6 +22,12 @@ public:
 		m_end = clock::now();
 	}
 
+	/// Time between the last calls to start() and stop()
+	clock::duration elapsed() const
+	{
+		return m_end - m_start;
+	}
+
 	void printInfo(std::ostream& out) const
 	{
 		if(m_end < m_start)
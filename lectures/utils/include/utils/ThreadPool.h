@@ -0,0 +1,528 @@
+#pragma once
+
+#include "WorkStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#elif defined(__linux__)
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+class TaskGroup;
+
+///
+/// @brief A pool of worker threads, which balance their work by stealing tasks.
+///
+/// Each worker keeps its own WorkStealingDeque. Tasks spawned by a worker go
+/// to the bottom of its deque and the worker runs them in LIFO order, which
+/// keeps the data it has just touched in its cache. An idle worker steals the
+/// oldest task from the top of another worker's deque. In divide-and-conquer
+/// algorithms these are the largest pieces of work, so a few steals are
+/// enough to spread the work over all workers. Tasks submitted by threads
+/// outside the pool go to a shared queue.
+///
+/// A thread waiting for a TaskGroup (including parallelFor() and
+/// parallelReduce()) does not block: it runs pending tasks until the group
+/// is done. This makes nested parallelism safe, even with a single worker.
+///
+/// Idle workers sleep on a condition variable and are woken when tasks arrive.
+/// The destructor lets the workers finish all queued tasks and joins them.
+///
+class ThreadPool {
+public:
+	/// Whether the workers are bound to specific cores
+	enum class Pinning {
+		/// The operating system may move the workers between cores
+		None,
+		/// Worker i runs only on core i (modulo the number of cores).
+		/// This is a hint: it is ignored on platforms that do not support it.
+		PinToCores
+	};
+
+private:
+	class Task {
+	public:
+		virtual ~Task() = default;
+		virtual void run() noexcept = 0;
+	};
+
+	template <typename Function>
+	class FunctionTask : public Task {
+		Function m_function;
+
+	public:
+		explicit FunctionTask(Function&& function)
+			: m_function(std::move(function))
+		{}
+
+		void run() noexcept override
+		{
+			m_function();
+		}
+	};
+
+	struct Worker {
+		WorkStealingDeque<Task*> deque;
+		std::thread thread;
+	};
+
+	/// The pool and the index of the worker, which runs on the current thread
+	struct CurrentWorker {
+		const ThreadPool* pool = nullptr;
+		size_t index = 0;
+	};
+
+	/// Number of unsuccessful searches for a task before a worker goes to sleep
+	static constexpr int SpinRounds = 64;
+
+	std::vector<std::unique_ptr<Worker>> m_workers;
+
+	std::mutex m_sharedMutex;
+	std::deque<Task*> m_shared;
+	std::atomic<size_t> m_sharedCount{0};
+
+	/// Incremented whenever a task is queued, so that sleeping workers notice new tasks
+	std::atomic<std::uint64_t> m_epoch{0};
+	std::atomic<unsigned> m_sleeping{0};
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wakeUp;
+	std::atomic<bool> m_stopping{false};
+
+	friend class TaskGroup;
+
+public:
+	/// Starts the given number of worker threads (at least one)
+	/// @exception std::system_error A thread could not be started
+	explicit ThreadPool(unsigned threads = defaultThreadCount(), Pinning pinning = Pinning::None)
+	{
+		threads = std::max(1u, threads);
+
+		// All deques must exist before any worker starts stealing from them
+		for (unsigned i = 0; i < threads; ++i)
+			m_workers.push_back(std::make_unique<Worker>());
+
+		try {
+			for (unsigned i = 0; i < threads; ++i) {
+				m_workers[i]->thread = std::thread([this, i]() { workerLoop(i); });
+
+				if (pinning == Pinning::PinToCores)
+					pinToCore(m_workers[i]->thread, i % defaultThreadCount());
+			}
+		}
+		catch (...) {
+			stop();
+			throw;
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// Waits until all queued tasks have been run and stops the workers
+	~ThreadPool() noexcept
+	{
+		stop();
+	}
+
+	/// The number of hardware threads, or 1 if it is not known
+	static unsigned defaultThreadCount() noexcept
+	{
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	/// A pool with defaultThreadCount() workers, which is started on first use
+	/// and shared by the library algorithms
+	static ThreadPool& shared()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+
+	/// Number of worker threads
+	size_t threadCount() const noexcept
+	{
+		return m_workers.size();
+	}
+
+	/// Checks whether the calling thread is one of the workers of this pool
+	bool isWorkerThread() const noexcept
+	{
+		return currentWorker().pool == this;
+	}
+
+	///
+	/// Queues function to be run by a worker and returns a future for its result.
+	///
+	/// Waiting for the future blocks the calling thread. Inside a task, prefer
+	/// a TaskGroup, whose wait() runs other tasks in the meantime.
+	///
+	/// @exception std::bad_alloc Memory allocation failed
+	///
+	template <typename Function>
+	auto submit(Function&& function) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+	{
+		using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+		std::packaged_task<Result()> task(std::forward<Function>(function));
+		std::future<Result> result = task.get_future();
+		push(std::make_unique<FunctionTask<std::packaged_task<Result()>>>(std::move(task)));
+
+		return result;
+	}
+
+	///
+	/// Calls body(chunkFirst, chunkLast) for chunks, which together cover [first, last).
+	///
+	/// The range is halved recursively until the chunks have at most grain
+	/// elements. One half is spawned as a task and the other is processed
+	/// right away, so idle workers steal the largest remaining pieces. The
+	/// calls run concurrently, so body must be safe to call from several threads.
+	///
+	/// @exception Rethrows the first exception thrown by body, after all chunks have completed
+	///
+	template <typename Body>
+	void parallelFor(size_t first, size_t last, size_t grain, Body&& body);
+
+	///
+	/// Maps each chunk of [first, last) to a value with map(chunkFirst, chunkLast)
+	/// and combines the values with combine(left, right).
+	///
+	/// The chunks are formed like in parallelFor() and the values are combined
+	/// in the order of the chunks, so the result does not depend on the number
+	/// of threads (even for operations like floating-point addition, which are
+	/// not exactly associative). For an empty range the result is identity.
+	///
+	/// @exception Rethrows the first exception thrown by map or combine
+	///
+	template <typename T, typename Map, typename Combine>
+	T parallelReduce(size_t first, size_t last, size_t grain, T identity, Map&& map, Combine&& combine);
+
+	///
+	/// Runs one queued task on the calling thread, if there is one.
+	/// Workers take it from their own deque first, other threads from the shared queue;
+	/// both then try to steal from the workers.
+	///
+	/// @return true if a task was run
+	///
+	bool runPendingTask()
+	{
+		const CurrentWorker& current = currentWorker();
+		Task* task = findTask(current.pool == this ? current.index : m_workers.size());
+
+		if ( ! task)
+			return false;
+
+		execute(task);
+		return true;
+	}
+
+private:
+	static CurrentWorker& currentWorker() noexcept
+	{
+		thread_local CurrentWorker current;
+		return current;
+	}
+
+	static void pinToCore(std::thread& thread, unsigned core) noexcept
+	{
+#if defined(_WIN32)
+		SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core);
+#elif defined(__linux__)
+		cpu_set_t cores;
+		CPU_ZERO(&cores);
+		CPU_SET(core, &cores);
+		pthread_setaffinity_np(thread.native_handle(), sizeof(cores), &cores);
+#else
+		(void)thread;
+		(void)core;
+#endif
+	}
+
+	/// Queues a task on the deque of the current worker or, for other threads, on the shared queue
+	void push(std::unique_ptr<Task> task)
+	{
+		const CurrentWorker& current = currentWorker();
+
+		if (current.pool == this) {
+			m_workers[current.index]->deque.push(task.get());
+		}
+		else {
+			std::lock_guard<std::mutex> lock(m_sharedMutex);
+			m_shared.push_back(task.get());
+			m_sharedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		task.release();
+		wakeUpOne();
+	}
+
+	void wakeUpOne()
+	{
+		m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+		if (m_sleeping.load(std::memory_order_seq_cst) != 0) {
+			// Taking the lock orders the notification after a worker, that is about to sleep, has checked the epoch
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_wakeUp.notify_one();
+		}
+	}
+
+	/// Finds a task for the worker with the given index (or for an outside thread, if it is threadCount())
+	Task* findTask(size_t self)
+	{
+		if (self < m_workers.size()) {
+			if (std::optional<Task*> task = m_workers[self]->deque.pop())
+				return *task;
+		}
+
+		if (m_sharedCount.load(std::memory_order_relaxed) != 0) {
+			std::lock_guard<std::mutex> lock(m_sharedMutex);
+
+			if ( ! m_shared.empty()) {
+				Task* task = m_shared.front();
+				m_shared.pop_front();
+				m_sharedCount.fetch_sub(1, std::memory_order_relaxed);
+				return task;
+			}
+		}
+
+		// Start at a different victim each time, so the thieves do not all compete for the same deque
+		thread_local std::uint32_t random = 0x9E3779B9u ^ static_cast<std::uint32_t>(self);
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+
+		size_t count = m_workers.size();
+		size_t start = random % count;
+
+		for (size_t i = 0; i < count; ++i) {
+			size_t victim = (start + i) % count;
+
+			if (victim == self)
+				continue;
+
+			if (std::optional<Task*> task = m_workers[victim]->deque.steal())
+				return *task;
+		}
+
+		return nullptr;
+	}
+
+	static void execute(Task* task) noexcept
+	{
+		task->run();
+		delete task;
+	}
+
+	void workerLoop(size_t index)
+	{
+		currentWorker() = CurrentWorker{ this, index };
+		int idleRounds = 0;
+
+		while (true) {
+			std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+
+			if (Task* task = findTask(index)) {
+				execute(task);
+				idleRounds = 0;
+				continue;
+			}
+
+			if (m_stopping.load(std::memory_order_acquire))
+				break;
+
+			if (++idleRounds < SpinRounds) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+			{
+				std::unique_lock<std::mutex> lock(m_sleepMutex);
+				m_wakeUp.wait(lock, [&]() {
+					return m_epoch.load(std::memory_order_seq_cst) != epoch || m_stopping.load(std::memory_order_acquire);
+				});
+			}
+
+			m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+			idleRounds = 0;
+		}
+	}
+
+	void stop() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_stopping.store(true, std::memory_order_release);
+		}
+
+		m_wakeUp.notify_all();
+
+		for (std::unique_ptr<Worker>& worker : m_workers) {
+			if (worker->thread.joinable())
+				worker->thread.join();
+		}
+
+		// Only possible if the constructor failed before all workers were started
+		while (Task* task = findTask(m_workers.size()))
+			execute(task);
+	}
+};
+
+///
+/// @brief A set of tasks, which run on a ThreadPool and can be waited for together.
+///
+/// wait() runs pending tasks of the pool on the calling thread until all tasks
+/// of the group have completed, so groups can be nested inside tasks without
+/// blocking workers. The first exception thrown by a task is rethrown by wait().
+///
+class TaskGroup {
+	ThreadPool& m_pool;
+	std::atomic<size_t> m_pending{0};
+	std::mutex m_errorMutex;
+	std::exception_ptr m_error;
+
+public:
+	explicit TaskGroup(ThreadPool& pool = ThreadPool::shared()) noexcept
+		: m_pool(pool)
+	{}
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	/// Waits for the remaining tasks. Their exceptions are discarded.
+	~TaskGroup() noexcept
+	{
+		while (m_pending.load(std::memory_order_acquire) != 0) {
+			if ( ! m_pool.runPendingTask())
+				std::this_thread::yield();
+		}
+	}
+
+	/// Spawns function as a task of the group
+	/// @exception std::bad_alloc Memory allocation failed
+	template <typename Function>
+	void run(Function&& function)
+	{
+		auto task = [this, function = std::forward<Function>(function)]() mutable noexcept {
+			try {
+				function();
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(m_errorMutex);
+
+				if ( ! m_error)
+					m_error = std::current_exception();
+			}
+
+			// The group may be destroyed as soon as the counter drops, so this must come last
+			m_pending.fetch_sub(1, std::memory_order_acq_rel);
+		};
+
+		auto wrapped = std::make_unique<ThreadPool::FunctionTask<decltype(task)>>(std::move(task));
+		m_pending.fetch_add(1, std::memory_order_relaxed);
+
+		try {
+			m_pool.push(std::move(wrapped));
+		}
+		catch (...) {
+			m_pending.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+	}
+
+	/// Runs pending tasks until all tasks of the group have completed
+	/// @exception Rethrows the first exception thrown by a task of the group
+	void wait()
+	{
+		while (m_pending.load(std::memory_order_acquire) != 0) {
+			if ( ! m_pool.runPendingTask())
+				std::this_thread::yield();
+		}
+
+		std::exception_ptr error;
+
+		{
+			std::lock_guard<std::mutex> lock(m_errorMutex);
+			std::swap(error, m_error);
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+};
+
+namespace thread_pool_detail {
+
+template <typename Body>
+void splitFor(TaskGroup& group, size_t first, size_t last, size_t grain, Body& body)
+{
+	// Spawn the upper halves and keep the lower one, until the chunk is small enough
+	while (last - first > grain) {
+		size_t middle = first + (last - first) / 2;
+		group.run([&group, middle, last, grain, &body]() { splitFor(group, middle, last, grain, body); });
+		last = middle;
+	}
+
+	body(first, last);
+}
+
+template <typename T, typename Map, typename Combine>
+T splitReduce(ThreadPool& pool, size_t first, size_t last, size_t grain, const T& identity, Map& map, Combine& combine)
+{
+	if (last - first <= grain)
+		return map(first, last);
+
+	size_t middle = first + (last - first) / 2;
+	T right = identity;
+
+	TaskGroup group(pool);
+	group.run([&]() { right = splitReduce(pool, middle, last, grain, identity, map, combine); });
+
+	T left = splitReduce(pool, first, middle, grain, identity, map, combine);
+	group.wait();
+
+	return combine(std::move(left), std::move(right));
+}
+
+} // namespace thread_pool_detail
+
+template <typename Body>
+void ThreadPool::parallelFor(size_t first, size_t last, size_t grain, Body&& body)
+{
+	if (first >= last)
+		return;
+
+	TaskGroup group(*this);
+	thread_pool_detail::splitFor(group, first, last, std::max<size_t>(grain, 1), body);
+	group.wait();
+}
+
+template <typename T, typename Map, typename Combine>
+T ThreadPool::parallelReduce(size_t first, size_t last, size_t grain, T identity, Map&& map, Combine&& combine)
+{
+	if (first >= last)
+		return identity;
+
+	return thread_pool_detail::splitReduce(*this, first, last, std::max<size_t>(grain, 1), identity, map, combine);
+}
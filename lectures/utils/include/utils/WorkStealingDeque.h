@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+///
+/// @brief A Chase-Lev work-stealing deque.
+///
+/// One thread, the owner, pushes and pops values at the bottom end, like a
+/// stack. Any number of other threads can steal values from the top end.
+/// The owner operations are wait-free unless the deque has to grow and need
+/// no atomic read-modify-write, except when a pop competes with a steal for
+/// the last value. Steals use a single compare-and-swap.
+///
+/// The values are stored in a circular buffer, which doubles when it is full.
+/// Old buffers are kept until the deque is destroyed, because a thief may
+/// still be reading from one of them.
+///
+/// Based on "Correct and Efficient Work-Stealing for Weak Memory Models"
+/// by Lê, Pop, Cohen and Zappa Nardelli (PPoPP 2013), with the fences replaced
+/// by sequentially consistent accesses, which ThreadSanitizer understands.
+///
+template <typename T>
+class WorkStealingDeque {
+	static_assert(std::is_trivially_copyable_v<T>, "the values are stored in atomics, so they must be trivially copyable");
+
+	class Buffer {
+		size_t m_mask;
+		std::unique_ptr<std::atomic<T>[]> m_slots;
+
+	public:
+		explicit Buffer(size_t capacity)
+			: m_mask(capacity - 1), m_slots(new std::atomic<T>[capacity])
+		{}
+
+		size_t capacity() const noexcept
+		{
+			return m_mask + 1;
+		}
+
+		T get(std::int64_t index) const noexcept
+		{
+			return m_slots[static_cast<size_t>(index) & m_mask].load(std::memory_order_relaxed);
+		}
+
+		void put(std::int64_t index, T value) noexcept
+		{
+			m_slots[static_cast<size_t>(index) & m_mask].store(value, std::memory_order_relaxed);
+		}
+	};
+
+	// The two ends are changed by different threads, so they are kept on separate cache lines
+	alignas(64) std::atomic<std::int64_t> m_top{0};
+	alignas(64) std::atomic<std::int64_t> m_bottom{0};
+	std::atomic<Buffer*> m_buffer;
+
+	/// All buffers ever allocated, including the current one. Only the owner changes it.
+	std::vector<std::unique_ptr<Buffer>> m_buffers;
+
+public:
+	/// Creates a deque with the given initial capacity, which must be a power of two
+	/// @exception std::bad_alloc Memory allocation failed
+	explicit WorkStealingDeque(size_t capacity = 256)
+	{
+		m_buffers.push_back(std::make_unique<Buffer>(capacity));
+		m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+	}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	/// Approximate number of values in the deque
+	size_t size() const noexcept
+	{
+		std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		std::int64_t top = m_top.load(std::memory_order_relaxed);
+		return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+	}
+
+	bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	/// Adds a value at the bottom. May only be called by the owner.
+	/// @exception std::bad_alloc Growing the buffer failed
+	void push(T value)
+	{
+		std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		std::int64_t top = m_top.load(std::memory_order_acquire);
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+		if (bottom - top > static_cast<std::int64_t>(buffer->capacity()) - 1)
+			buffer = grow(buffer, top, bottom);
+
+		buffer->put(bottom, value);
+
+		// Publishes the value (and anything it points to) to the thieves
+		m_bottom.store(bottom + 1, std::memory_order_release);
+	}
+
+	/// Removes the value at the bottom. May only be called by the owner.
+	std::optional<T> pop() noexcept
+	{
+		std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+		// The reservation of the bottom slot must be visible before top is read,
+		// so that a thief and the owner never both take the same value.
+		// A sequentially consistent exchange acts as the full fence of the original algorithm.
+		m_bottom.exchange(bottom, std::memory_order_seq_cst);
+		std::int64_t top = m_top.load(std::memory_order_seq_cst);
+
+		if (top > bottom) {
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+
+		std::optional<T> value = buffer->get(bottom);
+
+		if (top == bottom) {
+			// The last value: race the thieves for it
+			if ( ! m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				value = std::nullopt;
+
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return value;
+	}
+
+	/// Removes the value at the top. May be called by any thread.
+	/// Returns nothing if the deque is empty or another thread won the race for the value.
+	std::optional<T> steal() noexcept
+	{
+		std::int64_t top = m_top.load(std::memory_order_seq_cst);
+		std::int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+
+		if (top >= bottom)
+			return std::nullopt;
+
+		T value = m_buffer.load(std::memory_order_acquire)->get(top);
+
+		if ( ! m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return std::nullopt;
+
+		return value;
+	}
+
+private:
+	Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+	{
+		m_buffers.push_back(std::make_unique<Buffer>(buffer->capacity() * 2));
+		Buffer* larger = m_buffers.back().get();
+
+		for (std::int64_t i = top; i < bottom; ++i)
+			larger->put(i, buffer->get(i));
+
+		m_buffer.store(larger, std::memory_order_release);
+		return larger;
+	}
+};
@@ -0,0 +1,160 @@
+#include "catch2/catch_all.hpp"
+
+#include "utils/Arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <vector>
+
+/// Counts the bytes that are currently allocated through it
+class CountingResource : public std::pmr::memory_resource {
+public:
+  size_t allocatedBytes = 0;
+  size_t allocations = 0;
+
+protected:
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    allocatedBytes += bytes;
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) noexcept override
+  {
+    allocatedBytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+TEST_CASE("Arena returns aligned, non-overlapping memory", "[Arena]")
+{
+  Arena arena(256);
+  std::vector<char*> blocks;
+
+  for (size_t i = 0; i < 1000; ++i) {
+    size_t alignment = size_t(1) << (i % 7);
+    char* p = static_cast<char*>(arena.allocate(i % 50 + 1, alignment));
+
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p) % alignment == 0);
+    std::memset(p, int(i), i % 50 + 1);
+    blocks.push_back(p);
+  }
+
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    for (size_t j = 0; j < i % 50 + 1; ++j)
+      REQUIRE(blocks[i][j] == char(i));
+  }
+}
+
+TEST_CASE("Arena serves allocations larger than a chunk", "[Arena]")
+{
+  Arena arena(64);
+
+  char* p = static_cast<char*>(arena.allocate(10'000, 64));
+  std::memset(p, 1, 10'000);
+
+  CHECK(reinterpret_cast<std::uintptr_t>(p) % 64 == 0);
+  CHECK(arena.bytesReserved() >= 10'000);
+  CHECK(arena.bytesUsed() == 10'000);
+}
+
+TEST_CASE("Arena throws for requests, which do not fit in the address space", "[Arena]")
+{
+  CountingResource upstream;
+  Arena arena(1024, &upstream);
+  CHECK(arena.allocate(16) != nullptr);
+
+  // Read through a volatile, so that the compiler does not warn about the size
+  volatile size_t limit = std::numeric_limits<size_t>::max();
+  const size_t huge = limit - 8;
+  REQUIRE_THROWS_AS(arena.allocate(huge, 8), std::bad_alloc);
+  REQUIRE_THROWS_AS(arena.allocate(huge, 64), std::bad_alloc);
+}
+
+TEST_CASE("Arena::reset() keeps only the largest chunk", "[Arena]")
+{
+  CountingResource upstream;
+
+  {
+    Arena arena(128, &upstream);
+
+    for (int round = 0; round < 10; ++round) {
+      for (int i = 0; i < 100; ++i)
+        static_cast<void>(arena.allocate(16, 8));
+
+      CHECK(arena.bytesUsed() == 1600);
+      arena.reset();
+      CHECK(arena.bytesUsed() == 0);
+    }
+
+    // After the first round, a single chunk is large enough for the whole round
+    CHECK(upstream.allocatedBytes == arena.bytesReserved());
+    CHECK(upstream.allocations <= 6);
+
+    arena.release();
+    CHECK(upstream.allocatedBytes == 0);
+    CHECK(arena.bytesReserved() == 0);
+  }
+
+  CHECK(upstream.allocatedBytes == 0);
+}
+
+TEST_CASE("Arena returns all chunks when it is destroyed", "[Arena]")
+{
+  CountingResource upstream;
+
+  {
+    Arena arena(128, &upstream);
+
+    for (int i = 0; i < 1000; ++i)
+      static_cast<void>(arena.allocate(24, 8));
+
+    CHECK(upstream.allocatedBytes > 0);
+  }
+
+  CHECK(upstream.allocatedBytes == 0);
+}
+
+TEST_CASE("Arena uses the initial buffer before allocating chunks", "[Arena]")
+{
+  CountingResource upstream;
+  alignas(std::max_align_t) char buffer[1024];
+
+  Arena arena(buffer, sizeof(buffer), &upstream);
+
+  char* first = static_cast<char*>(arena.allocate(100, 8));
+  CHECK(first >= buffer);
+  CHECK(first < buffer + sizeof(buffer));
+  CHECK(upstream.allocations == 0);
+
+  static_cast<void>(arena.allocate(2000, 8));
+  CHECK(upstream.allocations == 1);
+
+  arena.release();
+  CHECK(upstream.allocatedBytes == 0);
+  CHECK(arena.allocate(100, 8) == first);
+}
+
+TEST_CASE("Arena can back std::pmr containers", "[Arena]")
+{
+  Arena arena;
+  std::pmr::vector<int> values(&arena);
+
+  for (int i = 0; i < 10'000; ++i)
+    values.push_back(i);
+
+  CHECK(values[9999] == 9999);
+  CHECK(arena.bytesUsed() >= 10'000 * sizeof(int));
+  CHECK(arena.is_equal(arena));
+
+  Arena other;
+  CHECK_FALSE(arena.is_equal(other));
+}
@@ -0,0 +1,98 @@
+#include "catch2/catch_all.hpp"
+
+#include "utils/BenchmarkSuite.h"
+
+#include <sstream>
+#include <vector>
+
+namespace {
+
+BenchmarkSuite::Result makeResult(const char* name, double medianNanoseconds)
+{
+  BenchmarkSuite::Result result;
+  result.name = name;
+  result.operations = 1000;
+  result.medianNanoseconds = medianNanoseconds;
+  result.minNanoseconds = medianNanoseconds - 1;
+  return result;
+}
+
+/// Runs a suite with the given arguments
+int runSuite(BenchmarkSuite& suite, std::vector<const char*> arguments)
+{
+  arguments.insert(arguments.begin(), "benchmarks");
+  return suite.run(static_cast<int>(arguments.size()), const_cast<char**>(arguments.data()));
+}
+
+}
+
+TEST_CASE("BenchmarkSuite::readJson() reads the results written by writeJson()", "[BenchmarkSuite]")
+{
+  BenchmarkSuite suite("test \"suite\"");
+  std::vector<BenchmarkSuite::Result> results = {
+    makeResult("DynamicArray/push_back", 1234.5),
+    makeResult("name with \"quotes\" and \\", 10)
+  };
+
+  std::stringstream json;
+  suite.writeJson(json, results);
+
+  std::vector<BenchmarkSuite::Result> read = BenchmarkSuite::readJson(json);
+
+  REQUIRE(read.size() == results.size());
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    CHECK(read[i].name == results[i].name);
+    CHECK(read[i].operations == results[i].operations);
+    CHECK(read[i].medianNanoseconds == results[i].medianNanoseconds);
+    CHECK(read[i].minNanoseconds == results[i].minNanoseconds);
+  }
+}
+
+TEST_CASE("BenchmarkSuite::readJson() returns no results for an empty baseline", "[BenchmarkSuite]")
+{
+  std::stringstream json("{ \"suite\": \"empty\", \"benchmarks\": [] }");
+  CHECK(BenchmarkSuite::readJson(json).empty());
+}
+
+TEST_CASE("BenchmarkSuite::compare() detects slowdowns above the threshold", "[BenchmarkSuite]")
+{
+  std::vector<BenchmarkSuite::Result> baseline = { makeResult("a", 100), makeResult("b", 100) };
+
+  SECTION("Results within the threshold are not regressions") {
+    CHECK(BenchmarkSuite::compare({ makeResult("a", 109), makeResult("b", 50) }, baseline, 0.10));
+  }
+  SECTION("A single result above the threshold is a regression") {
+    CHECK_FALSE(BenchmarkSuite::compare({ makeResult("a", 100), makeResult("b", 111) }, baseline, 0.10));
+  }
+  SECTION("Benchmarks, which are not in the baseline, are ignored") {
+    CHECK(BenchmarkSuite::compare({ makeResult("c", 1000) }, baseline, 0.10));
+  }
+}
+
+TEST_CASE("BenchmarkSuite::run() runs the benchmarks matching the filter", "[BenchmarkSuite]")
+{
+  BenchmarkSuite suite("test");
+  size_t firstCalls = 0;
+  size_t secondCalls = 0;
+
+  suite.add("first", 1, [&firstCalls]() { return ++firstCalls; });
+  suite.add("second", 1, [&secondCalls]() { return ++secondCalls; });
+
+  SECTION("Each benchmark is warmed up once and then run samples times") {
+    CHECK(runSuite(suite, { "--samples", "3" }) == 0);
+    CHECK(firstCalls == 4);
+    CHECK(secondCalls == 4);
+  }
+  SECTION("Benchmarks, whose names do not contain the filter, are not run") {
+    CHECK(runSuite(suite, { "--samples", "3", "--filter", "sec" }) == 0);
+    CHECK(firstCalls == 0);
+    CHECK(secondCalls == 4);
+  }
+  SECTION("Invalid options are reported") {
+    CHECK(runSuite(suite, { "--unknown", "1" }) == BenchmarkSuite::UsageExitCode);
+    CHECK(runSuite(suite, { "--samples" }) == BenchmarkSuite::UsageExitCode);
+    CHECK(runSuite(suite, { "--samples", "0" }) == BenchmarkSuite::UsageExitCode);
+    CHECK(firstCalls == 0);
+  }
+}
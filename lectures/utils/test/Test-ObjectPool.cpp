@@ -0,0 +1,102 @@
+#include "catch2/catch_all.hpp"
+
+#include "utils/ObjectPool.h"
+
+#include <cstdint>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("ObjectPool rounds the block size up to the alignment", "[ObjectPool]")
+{
+  CHECK(ObjectPool(1).blockSize() == ObjectPool::BlockAlignment);
+  CHECK(ObjectPool(ObjectPool::BlockAlignment).blockSize() == ObjectPool::BlockAlignment);
+  CHECK(ObjectPool(ObjectPool::BlockAlignment + 1).blockSize() == 2 * ObjectPool::BlockAlignment);
+}
+
+TEST_CASE("ObjectPool returns distinct aligned blocks", "[ObjectPool]")
+{
+  ObjectPool pool(24, 8);
+  std::set<void*> blocks;
+
+  for (int i = 0; i < 100; ++i) {
+    void* p = pool.allocate(24, 8);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p) % ObjectPool::BlockAlignment == 0);
+    REQUIRE(blocks.insert(p).second);
+  }
+
+  CHECK(pool.blocksInUse() == 100);
+
+  for (void* p : blocks)
+    pool.deallocate(p, 24, 8);
+
+  CHECK(pool.blocksInUse() == 0);
+}
+
+TEST_CASE("ObjectPool reuses freed blocks", "[ObjectPool]")
+{
+  ObjectPool pool(32);
+
+  void* a = pool.allocate(32);
+  void* b = pool.allocate(32);
+  pool.deallocate(a, 32);
+  pool.deallocate(b, 32);
+
+  // The free list is LIFO
+  CHECK(pool.allocate(32) == b);
+  CHECK(pool.allocate(32) == a);
+}
+
+TEST_CASE("ObjectPool passes requests, which do not fit a block, upstream", "[ObjectPool]")
+{
+  ObjectPool pool(32);
+
+  void* large = pool.allocate(1000);
+  CHECK(pool.blocksInUse() == 0);
+  pool.deallocate(large, 1000);
+
+  void* overAligned = pool.allocate(16, 4 * ObjectPool::BlockAlignment);
+  CHECK(reinterpret_cast<std::uintptr_t>(overAligned) % (4 * ObjectPool::BlockAlignment) == 0);
+  CHECK(pool.blocksInUse() == 0);
+  pool.deallocate(overAligned, 16, 4 * ObjectPool::BlockAlignment);
+}
+
+TEST_CASE("ObjectPool does not count a block, which could not be allocated", "[ObjectPool]")
+{
+  ObjectPool pool(32, 64, std::pmr::null_memory_resource());
+
+  REQUIRE_THROWS_AS(pool.allocate(32), std::bad_alloc);
+  CHECK(pool.blocksInUse() == 0);
+}
+
+TEST_CASE("ObjectPool::create() and destroy() manage the lifetime of objects", "[ObjectPool]")
+{
+  ObjectPool pool(sizeof(std::string));
+  std::vector<std::string*> strings;
+
+  for (int i = 0; i < 200; ++i)
+    strings.push_back(pool.create<std::string>(100, char('a' + i % 26)));
+
+  CHECK(pool.blocksInUse() == 200);
+  CHECK(*strings[27] == std::string(100, 'b'));
+
+  for (std::string* s : strings)
+    pool.destroy(s);
+
+  CHECK(pool.blocksInUse() == 0);
+  pool.destroy<std::string>(nullptr);
+}
+
+TEST_CASE("ObjectPool::create() returns the block when the constructor throws", "[ObjectPool]")
+{
+  struct ThrowingConstructor {
+    ThrowingConstructor() { throw std::runtime_error("constructor failed"); }
+  };
+
+  ObjectPool pool(16);
+
+  REQUIRE_THROWS_AS(pool.create<ThrowingConstructor>(), std::runtime_error);
+  CHECK(pool.blocksInUse() == 0);
+}
@@ -0,0 +1,196 @@
+#include "catch2/catch_all.hpp"
+
+#include "utils/ThreadPool.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("ThreadPool::ThreadPool() starts at least one worker", "[ThreadPool]")
+{
+  ThreadPool pool(0);
+  CHECK(pool.threadCount() == 1);
+  CHECK_FALSE(pool.isWorkerThread());
+
+  ThreadPool four(4);
+  CHECK(four.threadCount() == 4);
+}
+
+TEST_CASE("ThreadPool::submit() returns the result through a future", "[ThreadPool]")
+{
+  ThreadPool pool(2);
+
+  std::future<int> answer = pool.submit([]() { return 42; });
+  std::future<bool> onWorker = pool.submit([&pool]() { return pool.isWorkerThread(); });
+
+  CHECK(answer.get() == 42);
+  CHECK(onWorker.get());
+}
+
+TEST_CASE("ThreadPool::submit() passes exceptions through the future", "[ThreadPool]")
+{
+  ThreadPool pool(2);
+  std::future<void> failed = pool.submit([]() { throw std::runtime_error("task failed"); });
+
+  CHECK_THROWS_AS(failed.get(), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool runs all queued tasks before it is destroyed", "[ThreadPool]")
+{
+  std::atomic<int> completed{0};
+
+  {
+    ThreadPool pool(3);
+
+    for (int i = 0; i < 1000; ++i)
+      pool.submit([&completed]() { completed.fetch_add(1); });
+  }
+
+  CHECK(completed.load() == 1000);
+}
+
+TEST_CASE("ThreadPool::parallelFor() covers the range exactly once", "[ThreadPool]")
+{
+  ThreadPool pool(4);
+
+  for (size_t grain : { 1, 7, 1000, 100'000 }) {
+    std::vector<std::atomic<int>> visits(10'000);
+    std::atomic<size_t> largestChunk{0};
+
+    pool.parallelFor(0, visits.size(), grain, [&](size_t first, size_t last) {
+      size_t chunk = last - first;
+      size_t largest = largestChunk.load();
+
+      while (chunk > largest && ! largestChunk.compare_exchange_weak(largest, chunk)) {}
+
+      for (size_t i = first; i < last; ++i)
+        visits[i].fetch_add(1);
+    });
+
+    for (size_t i = 0; i < visits.size(); ++i)
+      REQUIRE(visits[i].load() == 1);
+
+    CHECK(largestChunk.load() <= grain);
+  }
+
+  // An empty range does not call the body
+  pool.parallelFor(5, 5, 1, [](size_t, size_t) { FAIL("called for an empty range"); });
+}
+
+TEST_CASE("ThreadPool::parallelFor() rethrows exceptions from the body", "[ThreadPool]")
+{
+  ThreadPool pool(2);
+
+  auto body = [](size_t first, size_t last) {
+    if (first <= 500 && 500 < last)
+      throw std::runtime_error("chunk failed");
+  };
+
+  CHECK_THROWS_AS(pool.parallelFor(0, 1000, 10, body), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool::parallelReduce() combines the chunks in order", "[ThreadPool]")
+{
+  ThreadPool pool(4);
+
+  auto sum = [](size_t first, size_t last) {
+    unsigned long long total = 0;
+
+    for (size_t i = first; i < last; ++i)
+      total += i;
+
+    return total;
+  };
+
+  auto add = [](unsigned long long a, unsigned long long b) { return a + b; };
+
+  CHECK(pool.parallelReduce<unsigned long long>(0, 1'000'000, 1000, 0, sum, add) == 499'999'500'000ull);
+  CHECK(pool.parallelReduce<unsigned long long>(7, 7, 1000, 123, sum, add) == 123);
+
+  // Concatenating the chunks shows whether they are combined left to right
+  std::vector<size_t> order = pool.parallelReduce<std::vector<size_t>>(0, 100, 3, {},
+    [](size_t first, size_t last) {
+      std::vector<size_t> chunk(last - first);
+      std::iota(chunk.begin(), chunk.end(), first);
+      return chunk;
+    },
+    [](std::vector<size_t> left, const std::vector<size_t>& right) {
+      left.insert(left.end(), right.begin(), right.end());
+      return left;
+    });
+
+  std::vector<size_t> expected(100);
+  std::iota(expected.begin(), expected.end(), size_t(0));
+  CHECK(order == expected);
+}
+
+TEST_CASE("TaskGroup supports nested parallelism on a single worker", "[ThreadPool]")
+{
+  ThreadPool pool(1);
+  std::atomic<int> leaves{0};
+
+  // Each level waits for its children, which only works if waiting runs other tasks
+  std::function<void(int)> spawn = [&](int depth) {
+    if (depth == 0) {
+      leaves.fetch_add(1);
+      return;
+    }
+
+    TaskGroup group(pool);
+    group.run([&spawn, depth]() { spawn(depth - 1); });
+    group.run([&spawn, depth]() { spawn(depth - 1); });
+    group.wait();
+  };
+
+  pool.submit([&spawn]() { spawn(10); }).get();
+  CHECK(leaves.load() == 1024);
+}
+
+TEST_CASE("TaskGroup::wait() rethrows the first exception", "[ThreadPool]")
+{
+  ThreadPool pool(2);
+  TaskGroup group(pool);
+  std::atomic<int> completed{0};
+
+  for (int i = 0; i < 100; ++i) {
+    group.run([i, &completed]() {
+      if (i == 50)
+        throw std::invalid_argument("task failed");
+
+      completed.fetch_add(1);
+    });
+  }
+
+  CHECK_THROWS_AS(group.wait(), std::invalid_argument);
+  CHECK(completed.load() == 99);
+
+  // The error is reported once
+  CHECK_NOTHROW(group.wait());
+}
+
+TEST_CASE("ThreadPool spreads work over all workers", "[ThreadPool]")
+{
+  ThreadPool pool(4, ThreadPool::Pinning::PinToCores);
+  std::mutex mutex;
+  std::set<std::thread::id> workers;
+  std::atomic<int> arrived{0};
+
+  // Every chunk waits until four of them run at the same time, so each must be on a different thread
+  pool.parallelFor(0, 4, 1, [&](size_t, size_t) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      workers.insert(std::this_thread::get_id());
+    }
+
+    arrived.fetch_add(1);
+
+    while (arrived.load() < 4)
+      std::this_thread::yield();
+  });
+
+  CHECK(workers.size() == 4);
+}
@@ -0,0 +1,103 @@
+#include "catch2/catch_all.hpp"
+
+#include "utils/WorkStealingDeque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("WorkStealingDeque::pop() returns the values in LIFO order", "[WorkStealingDeque]")
+{
+  WorkStealingDeque<int> deque;
+  CHECK(deque.empty());
+  CHECK_FALSE(deque.pop());
+
+  for (int i = 0; i < 10; ++i)
+    deque.push(i);
+
+  CHECK(deque.size() == 10);
+
+  for (int i = 9; i >= 0; --i)
+    REQUIRE(deque.pop() == i);
+
+  CHECK(deque.empty());
+  CHECK_FALSE(deque.pop());
+}
+
+TEST_CASE("WorkStealingDeque::steal() returns the values in FIFO order", "[WorkStealingDeque]")
+{
+  WorkStealingDeque<int> deque;
+
+  for (int i = 0; i < 10; ++i)
+    deque.push(i);
+
+  for (int i = 0; i < 10; ++i)
+    REQUIRE(deque.steal() == i);
+
+  CHECK_FALSE(deque.steal());
+}
+
+TEST_CASE("WorkStealingDeque grows beyond its initial capacity", "[WorkStealingDeque]")
+{
+  WorkStealingDeque<int> deque(4);
+
+  // Interleave pushes and steals, so the values wrap around the buffer before it grows
+  for (int i = 0; i < 3; ++i)
+    deque.push(i);
+
+  REQUIRE(deque.steal() == 0);
+
+  for (int i = 3; i < 1000; ++i)
+    deque.push(i);
+
+  for (int i = 1; i < 500; ++i)
+    REQUIRE(deque.steal() == i);
+
+  for (int i = 999; i >= 500; --i)
+    REQUIRE(deque.pop() == i);
+
+  CHECK(deque.empty());
+}
+
+TEST_CASE("WorkStealingDeque hands every value to exactly one thread", "[WorkStealingDeque]")
+{
+  const int count = 100'000;
+  const int thieves = 3;
+
+  WorkStealingDeque<int> deque(16);
+  std::vector<std::atomic<int>> taken(count);
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < thieves; ++t) {
+    threads.emplace_back([&]() {
+      while ( ! done.load()) {
+        if (std::optional<int> value = deque.steal())
+          taken[*value].fetch_add(1);
+      }
+    });
+  }
+
+  // The owner pushes everything and pops some of it, racing the thieves
+  for (int i = 0; i < count; ++i) {
+    deque.push(i);
+
+    if (i % 3 == 0) {
+      if (std::optional<int> value = deque.pop())
+        taken[*value].fetch_add(1);
+    }
+  }
+
+  while (std::optional<int> value = deque.pop())
+    taken[*value].fetch_add(1);
+
+  // Thieves may still hold a value they have already taken
+  done.store(true);
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (int i = 0; i < count; ++i)
+    REQUIRE(taken[i].load() == 1);
+}